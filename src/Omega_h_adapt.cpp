@@ -82,6 +82,7 @@ AdaptOpts::AdaptOpts(Int dim) {
   should_swap = true;
   should_coarsen_slivers = true;
   should_prevent_coarsen_flip = false;
+  should_refine_without_ghosts = false;
 }
 
 static Reals get_fixable_qualities(Mesh* mesh, AdaptOpts const&) {
@@ -73,6 +73,9 @@ struct AdaptOpts {
   bool should_swap;
   bool should_coarsen_slivers;
   bool should_prevent_coarsen_flip;
+  /* choose refinement keys on an element-based mesh instead of ghosting
+     it, moving only the elements around keys on partition boundaries */
+  bool should_refine_without_ghosts;
   TransferOpts xfer_opts;
 };
 
@@ -125,7 +125,7 @@ Read<I8> find_canonical_jumps(
     auto const e1 = e_sorted2e[e_sorted + 1];
     if (!are_equal(deg, canon, e0, e1)) jumps[e_sorted] = 1;
   };
-  parallel_for(max2(0, ne - 1), std::move(f));
+  parallel_for(max2(LO(0), ne - 1), std::move(f));
   if (jumps.size()) jumps.set(jumps.size() - 1, 1);
   return jumps;
 }
@@ -244,8 +244,16 @@ Adj invert_adj(Adj const down, Int const nlows_per_high, LO const nlows,
                          high_plural_name + " to " + high_plural_name;
   auto const codes_name =
       std::string(low_singular_name) + " " + high_plural_name + " codes";
+  /* on the host, counting by blocks leaves each upward list sorted
+     already. on devices, filling it with atomics and then sorting
+     each list is faster */
+#ifdef OMEGA_H_USE_CUDA
   auto const l2hl =
       invert_map_by_atomics(down.ab2b, nlows, l2lh_name, lh2hl_name);
+#else
+  auto const l2hl =
+      invert_map_by_blocks(down.ab2b, nlows, l2lh_name, lh2hl_name);
+#endif
   auto const l2lh = l2hl.a2ab;
   auto const lh2hl = l2hl.ab2b;
   LO const nlh = lh2hl.size();
@@ -258,7 +266,9 @@ Adj invert_adj(Adj const down, Int const nlows_per_high, LO const nlows,
   } else {
     separate_upward_no_codes(nlh, lh2hl, nlows_per_high, lh2h, codes);
   }
+#ifdef OMEGA_H_USE_CUDA
   sort_by_high_index(l2lh, lh2h, codes);
+#endif
   return Adj(l2lh, lh2h, codes);
 }
 
@@ -267,7 +277,9 @@ Bytes filter_parents(Parents const c2p, Int const parent_dim) {
   Write<Byte> filter(c2p.parent_idx.size());
   auto f = OMEGA_H_LAMBDA(LO c) {
     auto const code = c2p.codes[c];
-    if (amr::code_parent_dim(code) == parent_dim)
+    /* entities without a parent have code zero, which would otherwise
+       read as a vertex parent */
+    if (c2p.parent_idx[c] >= 0 && amr::code_parent_dim(code) == parent_dim)
       filter[c] = 1;
     else
       filter[c] = 0;
@@ -282,12 +294,18 @@ Children invert_parents(
   auto const filter = filter_parents(c2p, parent_dim);
   auto const rc2c = collect_marked(filter);
   auto const rc2p = unmap(rc2c, c2p.parent_idx, 1);
+#ifdef OMEGA_H_USE_CUDA
   auto const p2rc = invert_map_by_atomics(rc2p, nparent_dim_ents);
+#else
+  auto const p2rc = invert_map_by_blocks(rc2p, nparent_dim_ents);
+#endif
   auto const p2pc = p2rc.a2ab;
   auto const pc2rc = p2rc.ab2b;
   auto const pc2c = unmap(pc2rc, rc2c, 1);
   auto const codes = unmap(pc2c, c2p.codes, 1);
+#ifdef OMEGA_H_USE_CUDA
   sort_by_high_index(p2pc, pc2c, codes);
+#endif
   return Children(p2pc, pc2c, codes);
 }
 
@@ -537,7 +555,7 @@ Graph edges_across_tris(Adj const f2e, Adj const e2f) {
   auto const e2ef_codes = e2f.codes;
   auto const ne = e2ef.size() - 1;
   auto const e2ef_degrees = get_degrees(e2ef);
-  auto const e2ee_degrees = multiply_each_by(e2ef_degrees, 2);
+  auto const e2ee_degrees = multiply_each_by(e2ef_degrees, LO(2));
   auto const e2ee = offset_scan(e2ee_degrees, "edges to edge edges");
   auto const nee = e2ee.last();
   Write<LO> ee2e(nee, "edge edges to edges");
@@ -660,7 +678,9 @@ Graph elements_across_sides(Int const dim, Adj const elems2sides,
   template Read<I8> get_codes_to_canonical(Int deg, Read<T> ev2v);             \
   template void find_matches_ex(Int deg, LOs a2fv, Read<T> av2v, Read<T> bv2v, \
       Adj v2b, Write<LO>* a2b_out, Write<I8>* codes_out, bool);
+#ifndef OMEGA_H_LO_64
 INST(LO)
+#endif
 INST(GO)
 #undef INST
 
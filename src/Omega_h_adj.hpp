@@ -48,6 +48,11 @@ Adj unmap_adjacency(LOs const a2b, Adj const b2c);
 Adj invert_adj(Adj const down, Int const nlows_per_high, LO const nlows,
     Int const high_dim, Int const low_dim);
 
+/* sorts each upward list (lh2h) and its codes by high entity index,
+   for upward lists filled in no particular order */
+void sort_by_high_index(
+    LOs const l2lh, Write<LO> const lh2h, Write<I8> const codes);
+
 Children invert_parents(Parents const children2parents, Int const parent_dim,
     Int const nparent_dim_ents);
 
@@ -26,7 +26,9 @@ Read<T> align_ev2v(Int deg, Read<T> ev2v, Read<I8> codes) {
 
 #define INST(T)                                                                \
   template Read<T> align_ev2v(Int deg, Read<T> ev2v, Read<I8> codes);
+#ifndef OMEGA_H_LO_64
 INST(LO)
+#endif
 INST(GO)
 #undef INST
 
@@ -1,13 +1,17 @@
 #include <Omega_h_amr.hpp>
 #include <Omega_h_amr_topology.hpp>
 #include <Omega_h_amr_transfer.hpp>
+#include <Omega_h_array_ops.hpp>
+#include <Omega_h_dist.hpp>
 #include <Omega_h_for.hpp>
 #include <Omega_h_globals.hpp>
+#include <Omega_h_graph.hpp>
 #include <Omega_h_hypercube.hpp>
 #include <Omega_h_int_scan.hpp>
 #include <Omega_h_map.hpp>
 #include <Omega_h_mesh.hpp>
 #include <Omega_h_modify.hpp>
+#include <Omega_h_sort.hpp>
 #include <Omega_h_unmap_mesh.hpp>
 
 namespace Omega_h {
@@ -80,6 +84,200 @@ Bytes enforce_2to1_refine(Mesh* mesh, Int bridge_dim, Bytes elems_are_marked) {
   return one_level_mark;
 }
 
+/* the distinct entries of (ents), sorted */
+static LOs get_unique(LOs ents) {
+  if (ents.size() == 0) return ents;
+  LOs const sorted = unmap(sort_by_keys(ents), ents, 1);
+  auto const n = sorted.size();
+  Write<I8> is_first(n);
+  auto f = OMEGA_H_LAMBDA(LO i) {
+    is_first[i] = (i == 0 || sorted[i] != sorted[i - 1]);
+  };
+  parallel_for(n, f, "get_unique");
+  return unmap(collect_marked(Read<I8>(is_first)), sorted, 1);
+}
+
+static LOs concat(LOs a, LOs b) {
+  Write<LO> out(a.size() + b.size());
+  auto const na = a.size();
+  auto fa = OMEGA_H_LAMBDA(LO i) { out[i] = a[i]; };
+  parallel_for(na, fa, "concat");
+  auto fb = OMEGA_H_LAMBDA(LO i) { out[na + i] = b[i]; };
+  parallel_for(b.size(), fb, "concat");
+  return out;
+}
+
+namespace {
+/* the entities of one dimension that have copies on other ranks,
+   with the Dists between those copies and their owners, so that a
+   round only exchanges the demands on the partition boundary */
+struct SharedEnts {
+  LOs shared2ents;
+  Dist copies2owners;
+  Dist owners2copies;
+};
+}  // end anonymous namespace
+
+static SharedEnts get_shared_ents(Mesh* mesh, Int ent_dim) {
+  SharedEnts shared;
+  if (!mesh->could_be_shared(ent_dim)) return shared;
+  auto const nents = mesh->nents(ent_dim);
+  auto const ncopies = mesh->sync_array(ent_dim,
+      mesh->reduce_array(ent_dim, LOs(nents, 1), 1, OMEGA_H_SUM), 1);
+  shared.shared2ents = collect_marked(each_gt(ncopies, LO(1)));
+  auto const ents2shared = invert_injective_map(shared.shared2ents, nents);
+  auto const ents2owner_shared = mesh->sync_array(ent_dim, ents2shared, 1);
+  auto const owners = mesh->ask_owners(ent_dim);
+  auto const shared2owners =
+      Remotes(unmap(shared.shared2ents, owners.ranks, 1),
+          unmap(shared.shared2ents, ents2owner_shared, 1));
+  shared.copies2owners =
+      Dist(mesh->comm(), shared2owners, shared.shared2ents.size());
+  shared.owners2copies = shared.copies2owners.invert();
+  return shared;
+}
+
+/* raises the demand of each shared entity to the highest among its
+   copies and returns the entities whose demand went up on this rank */
+static LOs exchange_demands(SharedEnts const& shared, Write<I8> demands) {
+  auto const shared2ents = shared.shared2ents;
+  if (!shared2ents.exists()) return LOs({});
+  Read<I8> const local = unmap(shared2ents, Read<I8>(demands), 1);
+  auto const at_owners =
+      shared.copies2owners.exch_reduce(local, 1, OMEGA_H_MAX);
+  auto const highest = shared.owners2copies.exch(at_owners, 1);
+  Write<I8> raised(shared2ents.size());
+  auto f = OMEGA_H_LAMBDA(LO i) {
+    auto const ent = shared2ents[i];
+    raised[i] = (highest[i] > demands[ent]);
+    if (raised[i]) demands[ent] = highest[i];
+  };
+  parallel_for(shared2ents.size(), f, "exchange_demands");
+  return unmap(collect_marked(Read<I8>(raised)), shared2ents, 1);
+}
+
+/* a demand is the highest level among the marked leaves that touch an
+   entity: directly for the bridge demands, and through the bridges it
+   was split into for the lifted demands of each dimension. marks only
+   grow, and so do demands, which is why a round only has to look at
+   the entities around the leaves marked in the previous one */
+Bytes enforce_2to1_refine_fixed_point(
+    Mesh* mesh, Int bridge_dim, Bytes elems_are_marked, Int* p_nrounds) {
+  auto elem_dim = mesh->dim();
+  OMEGA_H_CHECK(bridge_dim >= 0);
+  OMEGA_H_CHECK(bridge_dim < elem_dim);
+  auto is_elem_leaf = mesh->ask_leaves(elem_dim);
+  auto elem_levels = mesh->ask_levels(elem_dim);
+  auto bridge_parents = mesh->ask_parents(bridge_dim);
+  auto bridges2elems = mesh->ask_up(bridge_dim, elem_dim);
+  auto nbridges = mesh->nents(bridge_dim);
+  Few<Adj, 3> elems2ents;
+  Few<Adj, 3> ents2elems;
+  Few<Int, 3> nents_per_elem;
+  Few<Children, 3> children;
+  Few<Write<I8>, 3> demands;
+  Few<SharedEnts, 3> shared;
+  for (Int ent_dim = bridge_dim; ent_dim < elem_dim; ++ent_dim) {
+    elems2ents[ent_dim] = mesh->ask_down(elem_dim, ent_dim);
+    ents2elems[ent_dim] = mesh->ask_up(ent_dim, elem_dim);
+    nents_per_elem[ent_dim] = hypercube_degree(elem_dim, ent_dim);
+    children[ent_dim] = mesh->ask_children(ent_dim, bridge_dim);
+    demands[ent_dim] = Write<I8>(mesh->nents(ent_dim), I8(-1));
+    shared[ent_dim] = get_shared_ents(mesh, ent_dim);
+  }
+  Write<I8> bridge_demands(nbridges, I8(-1));
+  Write<Byte> marks = deep_copy(land_each(elems_are_marked, is_elem_leaf));
+  LOs frontier = collect_marked(Read<Byte>(marks));
+  Int nrounds = 0;
+  while (mesh->comm()->reduce_or(frontier.size() != 0)) {
+    ++nrounds;
+    /* bridges of the leaves marked last round */
+    auto touched_bridges = get_unique(unmap(frontier,
+        elems2ents[bridge_dim].ab2b, nents_per_elem[bridge_dim]));
+    auto set_bridge_demands = OMEGA_H_LAMBDA(LO i) {
+      auto const bridge = touched_bridges[i];
+      I8 demand = bridge_demands[bridge];
+      for (auto be = bridges2elems.a2ab[bridge];
+           be < bridges2elems.a2ab[bridge + 1]; ++be) {
+        auto const elem = bridges2elems.ab2b[be];
+        if (marks[elem] && elem_levels[elem] > demand) {
+          demand = elem_levels[elem];
+        }
+      }
+      bridge_demands[bridge] = demand;
+    };
+    parallel_for(touched_bridges.size(), set_bridge_demands,
+        "enforce_2to1_refine_fixed_point(bridges)");
+    touched_bridges = get_unique(concat(touched_bridges,
+        exchange_demands(shared[bridge_dim], bridge_demands)));
+    /* lift them to the entities they were split from, and find
+       the leaves those touch */
+    auto candidates = LOs({});
+    for (Int ent_dim = bridge_dim; ent_dim < elem_dim; ++ent_dim) {
+      Write<LO> parents(touched_bridges.size());
+      auto get_parents = OMEGA_H_LAMBDA(LO i) {
+        auto const bridge = touched_bridges[i];
+        auto const parent = bridge_parents.parent_idx[bridge];
+        auto const code = bridge_parents.codes[bridge];
+        parents[i] =
+            (parent >= 0 && code_parent_dim(code) == ent_dim) ? parent : -1;
+      };
+      parallel_for(touched_bridges.size(), get_parents,
+          "enforce_2to1_refine_fixed_point(parents)");
+      LOs const all_parents = parents;
+      LOs touched =
+          unmap(collect_marked(each_geq_to(all_parents, LO(0))), all_parents, 1);
+      if (ent_dim == bridge_dim) touched = concat(touched, touched_bridges);
+      touched = get_unique(touched);
+      auto const ent_children = children[ent_dim];
+      auto const ent_demands = demands[ent_dim];
+      auto const is_bridge = (ent_dim == bridge_dim);
+      auto lift = OMEGA_H_LAMBDA(LO i) {
+        auto const ent = touched[i];
+        I8 demand = ent_demands[ent];
+        if (is_bridge && bridge_demands[ent] > demand) {
+          demand = bridge_demands[ent];
+        }
+        for (auto c = ent_children.a2ab[ent]; c < ent_children.a2ab[ent + 1];
+             ++c) {
+          auto const child = ent_children.ab2b[c];
+          if (bridge_demands[child] > demand) demand = bridge_demands[child];
+        }
+        ent_demands[ent] = demand;
+      };
+      parallel_for(
+          touched.size(), lift, "enforce_2to1_refine_fixed_point(lift)");
+      touched = concat(touched, exchange_demands(shared[ent_dim], ent_demands));
+      candidates = concat(
+          candidates, unmap_graph(touched, ents2elems[ent_dim]).ab2b);
+    }
+    candidates = get_unique(candidates);
+    Write<Byte> newly_marked(candidates.size());
+    auto mark = OMEGA_H_LAMBDA(LO i) {
+      auto const elem = candidates[i];
+      Byte is_new = 0;
+      if (is_elem_leaf[elem] && !marks[elem]) {
+        for (Int ent_dim = bridge_dim; ent_dim < elem_dim; ++ent_dim) {
+          auto deg = nents_per_elem[ent_dim];
+          for (Int e = 0; e < deg; ++e) {
+            auto ent = elems2ents[ent_dim].ab2b[elem * deg + e];
+            if (demands[ent_dim][ent] > elem_levels[elem]) is_new = 1;
+          }
+        }
+      }
+      newly_marked[i] = is_new;
+    };
+    parallel_for(
+        candidates.size(), mark, "enforce_2to1_refine_fixed_point(mark)");
+    frontier = unmap(collect_marked(Read<Byte>(newly_marked)), candidates, 1);
+    auto set_marks = OMEGA_H_LAMBDA(LO i) { marks[frontier[i]] = 1; };
+    parallel_for(
+        frontier.size(), set_marks, "enforce_2to1_refine_fixed_point(set)");
+  }
+  if (p_nrounds) *p_nrounds = nrounds;
+  return marks;
+}
+
 static void refine_ghosted(Mesh* mesh) {
   Few<LOs, 4> mods2mds;
   for (Int mod_dim = 0; mod_dim <= mesh->dim(); ++mod_dim) {
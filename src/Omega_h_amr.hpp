@@ -20,6 +20,15 @@ OMEGA_H_INLINE constexpr I8 make_code(Int which_child, Int parent_dim) {
 
 void remove_non_leaf_uses(Mesh* mesh);
 Bytes enforce_2to1_refine(Mesh* mesh, Int bridge_dim, Bytes elems_are_marked);
+/* marks every leaf that must be refined along with the marked ones so
+   that leaves meeting at an entity of (bridge_dim), vertices included,
+   differ by at most one level afterwards. the mesh must satisfy that
+   already. each round only propagates from the leaves marked in the
+   previous one, and exchanges demands on shared entities with the
+   neighboring ranks. rounds repeat until none marks anything new, and
+   their count, including that last one, goes to (nrounds) */
+Bytes enforce_2to1_refine_fixed_point(Mesh* mesh, Int bridge_dim,
+    Bytes elems_are_marked, Int* nrounds = nullptr);
 void refine(Mesh* mesh, Bytes elems_are_marked, TransferOpts xfer_opts);
 void derefine(Mesh* mesh, Bytes elems_are_marked, TransferOpts xfer_opts);
 
@@ -0,0 +1,883 @@
+#include <Omega_h_amr_forest.hpp>
+
+#include <cstdint>
+
+#include <Omega_h_align.hpp>
+#include <Omega_h_amr.hpp>
+#include <Omega_h_array_ops.hpp>
+#include <Omega_h_build.hpp>
+#include <Omega_h_dist.hpp>
+#include <Omega_h_for.hpp>
+#include <Omega_h_hypercube.hpp>
+#include <Omega_h_int_scan.hpp>
+#include <Omega_h_map.hpp>
+#include <Omega_h_sort.hpp>
+#include <Omega_h_transfer.hpp>
+
+namespace Omega_h {
+
+namespace amr {
+
+namespace {
+
+/* points of a root are given by integer coordinates on a lattice twice
+   as fine as the deepest level, so that the centers of the smallest
+   edges and faces are lattice points too.
+   this is the number of lattice steps along each root edge */
+OMEGA_H_INLINE I64 get_extent(Int dim) {
+  return I64(1) << (forest_max_level(dim) + 1);
+}
+
+/* the hypercube vertex at the corner whose coordinate along axis (i)
+   is bit (i) of (bits). it is its own inverse */
+OMEGA_H_INLINE Int tensor2vert(Int dim, Int bits) {
+  auto const layer = (dim == 3) ? (bits & 4) : 0;
+  switch (bits & 3) {
+    case 2:
+      return layer | 3;
+    case 3:
+      return layer | 2;
+  }
+  return bits;
+}
+
+OMEGA_H_INLINE I64 morton_encode(Int dim, Few<I64, 3> x) {
+  I64 code = 0;
+  for (Int b = 0; b < forest_max_level(dim); ++b) {
+    for (Int a = 0; a < dim; ++a) {
+      code |= ((x[a] >> b) & 1) << (b * dim + a);
+    }
+  }
+  return code;
+}
+
+OMEGA_H_INLINE Few<I64, 3> morton_decode(Int dim, I64 code) {
+  Few<I64, 3> x;
+  for (Int a = 0; a < 3; ++a) x[a] = 0;
+  for (Int b = 0; b < forest_max_level(dim); ++b) {
+    for (Int a = 0; a < dim; ++a) {
+      x[a] |= ((code >> (b * dim + a)) & 1) << b;
+    }
+  }
+  return x;
+}
+
+/* the lowest bit of the Morton digit that says which child of its
+   parent a leaf of (level) is */
+OMEGA_H_INLINE Int digit_shift(Int dim, Int level) {
+  return dim * (forest_max_level(dim) - level);
+}
+
+/* the lattice point at a corner of a leaf */
+OMEGA_H_INLINE Few<I64, 3> get_leaf_corner(
+    Int dim, I64 code, Int level, Int bits) {
+  auto x = morton_decode(dim, code);
+  auto const h = I64(1) << (forest_max_level(dim) - level);
+  for (Int a = 0; a < dim; ++a) x[a] = 2 * (x[a] + ((bits >> a) & 1) * h);
+  return x;
+}
+
+OMEGA_H_INLINE std::uint64_t hash_mix(std::uint64_t x) {
+  x ^= x >> 30;
+  x *= 0xbf58476d1ce4e5b9ULL;
+  x ^= x >> 27;
+  x *= 0x94d049bb133111ebULL;
+  x ^= x >> 31;
+  return x;
+}
+
+/* the parts of the root mesh that the tree kernels look at */
+struct RootMesh {
+  Int dim;
+  I64 extent;
+  LOs elem_verts;
+  Few<LOs, 3> elem_ents;
+  Few<LOs, 3> ent_verts;
+  LOs sides2side_elems;
+  LOs side_elems2elems;
+  Reals coords;
+};
+
+RootMesh get_root_mesh(Mesh* roots) {
+  RootMesh r;
+  r.dim = roots->dim();
+  r.extent = get_extent(r.dim);
+  r.elem_verts = roots->ask_elem_verts();
+  for (Int ent_dim = 1; ent_dim < r.dim; ++ent_dim) {
+    r.elem_ents[ent_dim] = roots->ask_down(r.dim, ent_dim).ab2b;
+    r.ent_verts[ent_dim] = roots->ask_verts_of(ent_dim);
+  }
+  auto const sides2elems = roots->ask_up(r.dim - 1, r.dim);
+  r.sides2side_elems = sides2elems.a2ab;
+  r.side_elems2elems = sides2elems.ab2b;
+  r.coords = roots->coords();
+  return r;
+}
+
+OMEGA_H_DEVICE LO get_root_corner(RootMesh const& r, LO root, Int bits) {
+  return r.elem_verts[root * (1 << r.dim) + tensor2vert(r.dim, bits)];
+}
+
+OMEGA_H_DEVICE Int find_root_corner(RootMesh const& r, LO root, LO vert) {
+  for (Int bits = 0; bits < (1 << r.dim); ++bits) {
+    if (get_root_corner(r, root, bits) == vert) return bits;
+  }
+  return -1;
+}
+
+/* the entity of (root) with exactly the given vertices */
+OMEGA_H_DEVICE LO find_root_ent(
+    RootMesh const& r, LO root, Int ent_dim, Few<LO, 8> const& verts) {
+  if (ent_dim == VERT) return verts[0];
+  if (ent_dim == r.dim) return root;
+  auto const nents = hypercube_degree(r.dim, ent_dim);
+  auto const nverts = 1 << ent_dim;
+  for (Int i = 0; i < nents; ++i) {
+    auto const ent = r.elem_ents[ent_dim][root * nents + i];
+    bool matches = true;
+    for (Int j = 0; j < nverts; ++j) {
+      auto const v = r.ent_verts[ent_dim][ent * nverts + j];
+      bool found = false;
+      for (Int k = 0; k < nverts; ++k) found = found || (verts[k] == v);
+      matches = matches && found;
+    }
+    if (matches) return ent;
+  }
+  return -1;
+}
+
+/* a lattice point as seen from the root entity whose interior holds it.
+   the coordinates are in a frame that all roots sharing the entity agree
+   on: its origin is the lowest numbered vertex and, on faces, the first
+   axis leads to the lower numbered neighbor of that vertex.
+   the vertices are listed in the tensor order of that frame */
+struct RootPoint {
+  Int dim;
+  LO ent;
+  Few<LO, 8> verts;
+  Few<I64, 3> u;
+};
+
+OMEGA_H_DEVICE RootPoint get_root_point(
+    RootMesh const& r, LO root, Few<I64, 3> p) {
+  RootPoint out;
+  Int nfree = 0;
+  Few<Int, 3> axes;
+  Int fixed = 0;
+  for (Int a = 0; a < r.dim; ++a) {
+    if (p[a] == r.extent) {
+      fixed |= (1 << a);
+    } else if (p[a] != 0) {
+      axes[nfree++] = a;
+    }
+  }
+  out.dim = nfree;
+  auto origin = fixed;
+  if (0 < nfree && nfree < r.dim) {
+    for (Int t = 0; t < (1 << nfree); ++t) {
+      auto bits = fixed;
+      for (Int i = 0; i < nfree; ++i) bits |= ((t >> i) & 1) << axes[i];
+      if (get_root_corner(r, root, bits) < get_root_corner(r, root, origin)) {
+        origin = bits;
+      }
+    }
+    if (nfree == 2 && get_root_corner(r, root, origin ^ (1 << axes[1])) <
+                          get_root_corner(r, root, origin ^ (1 << axes[0]))) {
+      swap2(axes[0], axes[1]);
+    }
+  }
+  for (Int t = 0; t < (1 << nfree); ++t) {
+    auto bits = origin;
+    for (Int i = 0; i < nfree; ++i) bits ^= ((t >> i) & 1) << axes[i];
+    out.verts[t] = get_root_corner(r, root, bits);
+  }
+  for (Int i = 0; i < 3; ++i) out.u[i] = 0;
+  for (Int i = 0; i < nfree; ++i) {
+    auto const o = ((origin >> axes[i]) & 1) ? r.extent : I64(0);
+    out.u[i] = (p[axes[i]] > o) ? (p[axes[i]] - o) : (o - p[axes[i]]);
+  }
+  out.ent = find_root_ent(r, root, nfree, out.verts);
+  return out;
+}
+
+/* the multilinear interpolation of the root coordinates,
+   which is the same from every root sharing the point */
+OMEGA_H_DEVICE Real get_root_coord(
+    RootMesh const& r, RootPoint const& pt, Int comp) {
+  Real x = 0.0;
+  for (Int t = 0; t < (1 << pt.dim); ++t) {
+    Real w = 1.0;
+    for (Int i = 0; i < pt.dim; ++i) {
+      auto const s = Real(pt.u[i]) / Real(r.extent);
+      w *= ((t >> i) & 1) ? s : (1.0 - s);
+    }
+    x += w * r.coords[pt.verts[t] * r.dim + comp];
+  }
+  return x;
+}
+
+/* three integers naming a point of the root mesh, so that equal
+   points from different roots and ranks have equal keys */
+OMEGA_H_DEVICE void set_point_key(
+    RootPoint const& pt, Write<GO> const& keys, LO i) {
+  keys[i * 3 + 0] = GO(pt.ent) * 4 + pt.dim;
+  keys[i * 3 + 1] = pt.u[0];
+  keys[i * 3 + 2] = (pt.u[1] << 31) | pt.u[2];
+}
+
+OMEGA_H_INLINE bool keys_equal(
+    Read<GO> const& a, LO i, Read<GO> const& b, LO j) {
+  return a[i * 3 + 0] == b[j * 3 + 0] && a[i * 3 + 1] == b[j * 3 + 1] &&
+         a[i * 3 + 2] == b[j * 3 + 2];
+}
+
+OMEGA_H_INLINE bool key_less(
+    Read<GO> const& a, LO i, Read<GO> const& b, LO j) {
+  for (Int k = 0; k < 3; ++k) {
+    if (a[i * 3 + k] != b[j * 3 + k]) return a[i * 3 + k] < b[j * 3 + k];
+  }
+  return false;
+}
+
+/* the lattice point at the center of entity (i) of dimension (ent_dim)
+   of a leaf, in the order of hypercube_down_template() */
+OMEGA_H_INLINE Few<I64, 3> get_leaf_ent_center(
+    Int dim, I64 code, Int level, Int ent_dim, Int i) {
+  Few<I64, 3> center;
+  for (Int a = 0; a < 3; ++a) center[a] = 0;
+  auto const nents_verts = 1 << ent_dim;
+  for (Int j = 0; j < nents_verts; ++j) {
+    auto const v =
+        (ent_dim == dim) ? j : hypercube_down_template(dim, ent_dim, i, j);
+    auto const p = get_leaf_corner(dim, code, level, tensor2vert(dim, v));
+    for (Int a = 0; a < dim; ++a) center[a] += p[a];
+  }
+  for (Int a = 0; a < dim; ++a) center[a] /= nents_verts;
+  return center;
+}
+
+/* the keys of the corners of each leaf, in hypercube vertex order */
+Read<GO> get_corner_keys(
+    RootMesh const& r, LOs leaf_roots, Read<I64> leaf_codes, Bytes levels) {
+  auto const nleaves = leaf_roots.size();
+  auto const ncorners = 1 << r.dim;
+  Write<GO> keys(nleaves * ncorners * 3);
+  auto f = OMEGA_H_LAMBDA(LO leaf) {
+    for (Int v = 0; v < ncorners; ++v) {
+      auto const p = get_leaf_corner(
+          r.dim, leaf_codes[leaf], levels[leaf], tensor2vert(r.dim, v));
+      auto const pt = get_root_point(r, leaf_roots[leaf], p);
+      set_point_key(pt, keys, leaf * ncorners + v);
+    }
+  };
+  parallel_for(nleaves, f, "get_corner_keys");
+  return keys;
+}
+
+/* numbers the distinct keys in sorted order.
+   returns the first key with each number */
+LOs find_unique_keys(Read<GO> keys, LOs* p_keys2uniq) {
+  auto const nkeys = divide_no_remainder(keys.size(), 3);
+  auto const perm = sort_by_keys(keys, 3);
+  Write<I8> starts_run(nkeys);
+  auto f = OMEGA_H_LAMBDA(LO i) {
+    starts_run[i] = (i == 0 || !keys_equal(keys, perm[i], keys, perm[i - 1]));
+  };
+  parallel_for(nkeys, f, "find_unique_keys(runs)");
+  auto const runs = offset_scan(Read<I8>(starts_run));
+  Write<LO> keys2uniq(nkeys);
+  Write<LO> uniq2keys(runs.last());
+  auto g = OMEGA_H_LAMBDA(LO i) {
+    auto const uniq = runs[i + 1] - 1;
+    keys2uniq[perm[i]] = uniq;
+    if (starts_run[i]) uniq2keys[uniq] = perm[i];
+  };
+  parallel_for(nkeys, g, "find_unique_keys(number)");
+  *p_keys2uniq = keys2uniq;
+  return uniq2keys;
+}
+
+/* numbers distinct keys across (comm), given in sorted order with no
+   repeats on each rank. each key is numbered by a rank picked by hashing
+   it, so equal keys on different ranks get the same number */
+GOs globalize_keys(CommPtr comm, Read<GO> keys) {
+  auto const nkeys = divide_no_remainder(keys.size(), 3);
+  if (comm->size() == 1) return GOs(nkeys, 0, 1);
+  auto const nranks = comm->size();
+  Write<I32> dest_ranks(nkeys);
+  auto f = OMEGA_H_LAMBDA(LO i) {
+    std::uint64_t h = 0;
+    for (Int j = 0; j < 3; ++j) h = hash_mix(h ^ std::uint64_t(keys[i * 3 + j]));
+    dest_ranks[i] = I32(h % std::uint64_t(nranks));
+  };
+  parallel_for(nkeys, f, "globalize_keys");
+  Dist keys2numberers;
+  keys2numberers.set_parent_comm(comm);
+  keys2numberers.set_dest_ranks(dest_ranks);
+  auto const recvd_keys = keys2numberers.exch(keys, 3);
+  LOs recvd2uniq;
+  auto const nuniq = find_unique_keys(recvd_keys, &recvd2uniq).size();
+  auto const offset = comm->exscan(GO(nuniq), OMEGA_H_SUM);
+  Write<GO> recvd_globals(recvd2uniq.size());
+  auto g = OMEGA_H_LAMBDA(LO i) { recvd_globals[i] = offset + recvd2uniq[i]; };
+  parallel_for(recvd2uniq.size(), g, "globalize_keys(number)");
+  return keys2numberers.invert().exch(GOs(recvd_globals), 1);
+}
+
+/* moves a lattice point outside of (root) into the root holding it,
+   crossing one side at a time. returns false if it leaves the mesh */
+OMEGA_H_DEVICE bool walk_to_root(
+    RootMesh const& r, LO* p_root, Few<I64, 3>* p_point) {
+  auto root = *p_root;
+  auto p = *p_point;
+  auto const nverts = 1 << r.dim;
+  for (Int step = 0; step < r.dim; ++step) {
+    Int axis = -1;
+    Int side = 0;
+    for (Int a = 0; a < r.dim && axis == -1; ++a) {
+      if (p[a] < 0) {
+        axis = a;
+        side = 0;
+      } else if (p[a] > r.extent) {
+        axis = a;
+        side = 1;
+      }
+    }
+    if (axis == -1) break;
+    Few<LO, 8> side_verts;
+    Int nside_verts = 0;
+    for (Int bits = 0; bits < nverts; ++bits) {
+      if (((bits >> axis) & 1) == side) {
+        side_verts[nside_verts++] = get_root_corner(r, root, bits);
+      }
+    }
+    auto const side_ent = find_root_ent(r, root, r.dim - 1, side_verts);
+    LO other = -1;
+    for (auto se = r.sides2side_elems[side_ent];
+         se < r.sides2side_elems[side_ent + 1]; ++se) {
+      if (r.side_elems2elems[se] != root) other = r.side_elems2elems[se];
+    }
+    if (other == -1) return false;
+    /* each axis along the side maps to the axis of (other) joining the
+       same two vertices, and the outward normal to the inward one */
+    auto const c0 = side << axis;
+    auto const b0 = find_root_corner(r, other, get_root_corner(r, root, c0));
+    Few<I64, 3> q;
+    for (Int a = 0; a < 3; ++a) q[a] = 0;
+    Int used = 0;
+    for (Int t = 0; t < r.dim; ++t) {
+      if (t == axis) continue;
+      auto const bt = find_root_corner(
+          r, other, get_root_corner(r, root, c0 | (1 << t)));
+      auto const diff = b0 ^ bt;
+      Int s = 0;
+      while (!((diff >> s) & 1)) ++s;
+      used |= diff;
+      q[s] = ((b0 >> s) & 1) ? (r.extent - p[t]) : p[t];
+    }
+    Int s = 0;
+    while ((used >> s) & 1) ++s;
+    auto const depth = side ? (p[axis] - r.extent) : (-p[axis]);
+    q[s] = ((b0 >> s) & 1) ? (r.extent - depth) : depth;
+    root = other;
+    p = q;
+  }
+  for (Int a = 0; a < r.dim; ++a) {
+    if (p[a] < 0 || p[a] > r.extent) return false;
+  }
+  *p_root = root;
+  *p_point = p;
+  return true;
+}
+
+/* the position of (root, code) in the order of the leaves,
+   within the sorted (roots, codes) */
+OMEGA_H_INLINE LO find_last_not_after(
+    LOs const& roots, Read<I64> const& codes, LO root, I64 code) {
+  LO lo = 0;
+  LO hi = roots.size();
+  while (lo < hi) {
+    auto const mid = (lo + hi) / 2;
+    auto const after = (root < roots[mid]) ||
+                       (root == roots[mid] && code < codes[mid]);
+    if (after) {
+      hi = mid;
+    } else {
+      lo = mid + 1;
+    }
+  }
+  return lo - 1;
+}
+
+/* the first leaf of each rank, with empty ranks taking that of the
+   next rank, so that the rank holding a leaf is the last one whose
+   first leaf is not after it.
+   (all_comm) connects every rank to every other one */
+void get_rank_firsts(CommPtr all_comm, LOs leaf_roots, Read<I64> leaf_codes,
+    LOs* p_rank_roots, Read<I64>* p_rank_codes) {
+  auto const nleaves = leaf_roots.size();
+  auto const none = ArithTraits<LO>::max();
+  auto const first_root = nleaves ? leaf_roots.get(0) : none;
+  auto const first_code = nleaves ? leaf_codes.get(0) : I64(0);
+  auto const roots = HostRead<LO>(all_comm->allgather(first_root));
+  auto const codes = HostRead<I64>(all_comm->allgather(first_code));
+  auto const nranks = roots.size();
+  HostWrite<LO> rank_roots(nranks);
+  HostWrite<I64> rank_codes(nranks);
+  for (LO rank = nranks - 1; rank >= 0; --rank) {
+    auto const is_empty = (roots[rank] == none && rank + 1 < nranks);
+    rank_roots[rank] = is_empty ? rank_roots[rank + 1] : roots[rank];
+    rank_codes[rank] = is_empty ? rank_codes[rank + 1] : codes[rank];
+  }
+  *p_rank_roots = rank_roots.write();
+  *p_rank_codes = rank_codes.write();
+}
+
+template <typename T>
+void inherit_elem_tag(Mesh* old_mesh, Mesh* new_mesh, LOs new2old,
+    std::string const& name) {
+  auto const dim = old_mesh->dim();
+  auto const ncomps = old_mesh->get_tagbase(dim, name)->ncomps();
+  auto const old_data = old_mesh->get_array<T>(dim, name);
+  new_mesh->add_tag(
+      dim, name, ncomps, Read<T>(unmap(new2old, old_data, ncomps)));
+}
+
+}  // end anonymous namespace
+
+Forest::Forest(Mesh* roots, CommPtr comm) : roots_(*roots), comm_(comm) {
+  OMEGA_H_CHECK(roots->family() == OMEGA_H_HYPERCUBE);
+  OMEGA_H_CHECK(roots->comm()->size() == 1);
+  auto const all_ranks = Read<I32>(comm->size(), 0, 1);
+  all_comm_ = comm->graph_adjacent(all_ranks, all_ranks);
+  GO begin, end;
+  suggest_slices(roots->nelems(), comm->size(), comm->rank(), &begin, &end);
+  auto const nleaves = LO(end - begin);
+  mesh_ = build(LOs(nleaves, LO(begin), 1), Read<I64>(nleaves, 0),
+      Bytes(nleaves, 0), nullptr);
+}
+
+Mesh* Forest::mesh() { return &mesh_; }
+
+Mesh* Forest::roots() { return &roots_; }
+
+Mesh Forest::build(LOs leaf_roots, Read<I64> leaf_codes, Bytes leaf_levels,
+    Read<GO>* vert_keys) {
+  auto const r = get_root_mesh(&roots_);
+  auto const dim = r.dim;
+  auto const nleaves = leaf_roots.size();
+  auto const nleaf_verts = 1 << dim;
+  auto const corner_keys =
+      get_corner_keys(r, leaf_roots, leaf_codes, leaf_levels);
+  LOs corners2uniq;
+  auto const uniq2corners = find_unique_keys(corner_keys, &corners2uniq);
+  Read<GO> const uniq_keys = unmap(uniq2corners, corner_keys, 3);
+  auto const uniq_globals = globalize_keys(comm_, uniq_keys);
+  /* vertices are ordered by their globals,
+     which keeps the elements in the order of the leaves */
+  auto const verts2uniq = sort_by_keys(uniq_globals);
+  LOs const ev2v = unmap(corners2uniq, invert_permutation(verts2uniq), 1);
+  Read<GO> const vert_globals = unmap(verts2uniq, uniq_globals, 1);
+  LOs const verts2corners = unmap(verts2uniq, uniq2corners, 1);
+  if (vert_keys) *vert_keys = unmap(verts2uniq, uniq_keys, 3);
+  auto const leaf_offset = comm_->exscan(GO(nleaves), OMEGA_H_SUM);
+  Mesh mesh(roots_.library());
+  mesh.set_comm(comm_);
+  mesh.set_parting(OMEGA_H_ELEM_BASED);
+  mesh.set_family(OMEGA_H_HYPERCUBE);
+  mesh.set_dim(dim);
+  build_verts_from_globals(&mesh, vert_globals);
+  build_ents_from_elems2verts(
+      &mesh, ev2v, vert_globals, GOs(nleaves, leaf_offset, 1));
+  /* every leaf entity is classified like the root entity
+     holding its center */
+  bool has_classes = true;
+  Few<Read<I8>, 4> root_class_dims;
+  Few<Read<ClassId>, 4> root_class_ids;
+  for (Int ent_dim = 0; ent_dim <= dim; ++ent_dim) {
+    has_classes = has_classes && roots_.has_tag(ent_dim, "class_dim") &&
+                  roots_.has_tag(ent_dim, "class_id");
+    if (!has_classes) break;
+    root_class_dims[ent_dim] = roots_.get_array<I8>(ent_dim, "class_dim");
+    root_class_ids[ent_dim] = roots_.get_array<ClassId>(ent_dim, "class_id");
+  }
+  auto const nverts = mesh.nverts();
+  Write<Real> coords(nverts * dim);
+  Write<I8> vert_class_dims(nverts);
+  Write<ClassId> vert_class_ids(nverts);
+  auto f = OMEGA_H_LAMBDA(LO v) {
+    auto const corner = verts2corners[v];
+    auto const leaf = corner / nleaf_verts;
+    auto const p = get_leaf_corner(dim, leaf_codes[leaf], leaf_levels[leaf],
+        tensor2vert(dim, corner % nleaf_verts));
+    auto const pt = get_root_point(r, leaf_roots[leaf], p);
+    for (Int i = 0; i < dim; ++i) coords[v * dim + i] = get_root_coord(r, pt, i);
+    if (has_classes) {
+      vert_class_dims[v] = root_class_dims[pt.dim][pt.ent];
+      vert_class_ids[v] = root_class_ids[pt.dim][pt.ent];
+    }
+  };
+  parallel_for(nverts, f, "Forest::build(verts)");
+  mesh.add_coords(coords);
+  if (has_classes) {
+    mesh.add_tag(VERT, "class_dim", 1, Read<I8>(vert_class_dims));
+    mesh.add_tag(VERT, "class_id", 1, Read<ClassId>(vert_class_ids));
+    for (Int ent_dim = 1; ent_dim <= dim; ++ent_dim) {
+      auto const nents_per_leaf = hypercube_degree(dim, ent_dim);
+      auto const leaves2ents = (ent_dim == dim)
+                                   ? LOs(nleaves, 0, 1)
+                                   : mesh.ask_down(dim, ent_dim).ab2b;
+      Write<I8> class_dims(mesh.nents(ent_dim));
+      Write<ClassId> class_ids(mesh.nents(ent_dim));
+      auto g = OMEGA_H_LAMBDA(LO leaf) {
+        for (Int i = 0; i < nents_per_leaf; ++i) {
+          auto const center = get_leaf_ent_center(
+              dim, leaf_codes[leaf], leaf_levels[leaf], ent_dim, i);
+          auto const pt = get_root_point(r, leaf_roots[leaf], center);
+          auto const ent = leaves2ents[leaf * nents_per_leaf + i];
+          class_dims[ent] = root_class_dims[pt.dim][pt.ent];
+          class_ids[ent] = root_class_ids[pt.dim][pt.ent];
+        }
+      };
+      parallel_for(nleaves, g, "Forest::build(classes)");
+      mesh.add_tag(ent_dim, "class_dim", 1, Read<I8>(class_dims));
+      mesh.add_tag(ent_dim, "class_id", 1, Read<ClassId>(class_ids));
+    }
+  }
+  mesh.add_tag(dim, "level", 1, leaf_levels);
+  mesh.add_tag(dim, "forest_root", 1, leaf_roots);
+  mesh.add_tag(dim, "forest_code", 1, leaf_codes);
+  return mesh;
+}
+
+Parents Forest::ask_parents(
+    LOs* parent_roots, Read<I64>* parent_codes, Bytes* parent_levels) {
+  auto const dim = mesh_.dim();
+  auto const nleaves = mesh_.nelems();
+  auto const leaf_roots = mesh_.get_array<LO>(dim, "forest_root");
+  auto const leaf_codes = mesh_.get_array<I64>(dim, "forest_code");
+  auto const levels = mesh_.ask_levels(dim);
+  auto const children2leaves = collect_marked(each_gt(levels, Byte(0)));
+  auto const nchildren = children2leaves.size();
+  Write<GO> keys(nchildren * 3);
+  auto f = OMEGA_H_LAMBDA(LO child) {
+    auto const leaf = children2leaves[child];
+    auto const level = levels[leaf];
+    auto const digit = I64((1 << dim) - 1) << digit_shift(dim, level);
+    keys[child * 3 + 0] = leaf_roots[leaf];
+    keys[child * 3 + 1] = leaf_codes[leaf] & ~digit;
+    keys[child * 3 + 2] = level - 1;
+  };
+  parallel_for(nchildren, f, "Forest::ask_parents");
+  /* sorting by root, code and then level puts the parents in tree order */
+  LOs children2parents;
+  auto const parents2children = find_unique_keys(keys, &children2parents);
+  Read<GO> const parent_keys = unmap(parents2children, Read<GO>(keys), 3);
+  auto const nparents = parents2children.size();
+  if (parent_roots || parent_codes || parent_levels) {
+    Write<LO> roots_w(nparents);
+    Write<I64> codes_w(nparents);
+    Write<Byte> levels_w(nparents);
+    auto g = OMEGA_H_LAMBDA(LO parent) {
+      roots_w[parent] = LO(parent_keys[parent * 3 + 0]);
+      codes_w[parent] = parent_keys[parent * 3 + 1];
+      levels_w[parent] = Byte(parent_keys[parent * 3 + 2]);
+    };
+    parallel_for(nparents, g, "Forest::ask_parents(nodes)");
+    if (parent_roots) *parent_roots = roots_w;
+    if (parent_codes) *parent_codes = codes_w;
+    if (parent_levels) *parent_levels = levels_w;
+  }
+  auto const parent_idx =
+      map_onto(children2parents, children2leaves, nleaves, LO(-1), 1);
+  Write<I8> codes(nleaves);
+  auto h = OMEGA_H_LAMBDA(LO leaf) {
+    auto const level = levels[leaf];
+    auto const which_child =
+        level ? Int((leaf_codes[leaf] >> digit_shift(dim, level)) &
+                    ((1 << dim) - 1))
+              : 0;
+    codes[leaf] = make_code(which_child, dim);
+  };
+  parallel_for(nleaves, h, "Forest::ask_parents(codes)");
+  return Parents(parent_idx, codes);
+}
+
+Children Forest::ask_children() {
+  LOs parent_roots;
+  auto const parents = ask_parents(&parent_roots);
+  return invert_parents(parents, mesh_.dim(), parent_roots.size());
+}
+
+Read<I8> Forest::mark_exposed_sides() {
+  auto const r = get_root_mesh(&roots_);
+  auto const dim = r.dim;
+  auto const leaf_roots = mesh_.get_array<LO>(dim, "forest_root");
+  auto const leaf_codes = mesh_.get_array<I64>(dim, "forest_code");
+  auto const levels = mesh_.ask_levels(dim);
+  auto const nsides_per_leaf = hypercube_degree(dim, dim - 1);
+  auto const leaves2sides = mesh_.ask_down(dim, dim - 1).ab2b;
+  Write<I8> exposed(mesh_.nents(dim - 1));
+  auto f = OMEGA_H_LAMBDA(LO leaf) {
+    for (Int i = 0; i < nsides_per_leaf; ++i) {
+      auto const center = get_leaf_ent_center(
+          dim, leaf_codes[leaf], levels[leaf], dim - 1, i);
+      auto const pt = get_root_point(r, leaf_roots[leaf], center);
+      auto const on_root_side = (pt.dim == dim - 1);
+      auto const nroots = on_root_side ? (r.sides2side_elems[pt.ent + 1] -
+                                             r.sides2side_elems[pt.ent])
+                                       : 2;
+      exposed[leaves2sides[leaf * nsides_per_leaf + i]] = (nroots < 2);
+    }
+  };
+  parallel_for(mesh_.nelems(), f, "Forest::mark_exposed_sides");
+  return exposed;
+}
+
+Bytes Forest::enforce_2to1_refine(Int bridge_dim, Bytes leaves_are_marked) {
+  auto const r = get_root_mesh(&roots_);
+  auto const dim = r.dim;
+  OMEGA_H_CHECK(0 <= bridge_dim && bridge_dim < dim);
+  auto const leaf_roots = mesh_.get_array<LO>(dim, "forest_root");
+  auto const leaf_codes = mesh_.get_array<I64>(dim, "forest_code");
+  auto const levels = mesh_.ask_levels(dim);
+  auto const nleaves = mesh_.nelems();
+  LOs rank_roots;
+  Read<I64> rank_codes;
+  get_rank_firsts(
+      all_comm_, leaf_roots, leaf_codes, &rank_roots, &rank_codes);
+  /* the neighbors meeting a leaf at an entity of (bridge_dim) or higher
+     lie in the directions with at most (dim - bridge_dim) nonzero
+     components. each direction is probed at the smallest cell next to
+     the lowest corner of the leaf, since a coarser neighbor in that
+     direction would contain that cell */
+  Int ndirs = 1;
+  for (Int a = 0; a < dim; ++a) ndirs *= 3;
+  auto const max_nonzeros = dim - bridge_dim;
+  auto marks = leaves_are_marked;
+  auto new_marks = leaves_are_marked;
+  while (true) {
+    auto const sources = collect_marked(new_marks);
+    auto const nprobes = sources.size() * ndirs;
+    Write<I32> probe_ranks(nprobes, -1);
+    Write<LO> probe_roots(nprobes);
+    Write<I64> probe_codes(nprobes);
+    Write<Byte> probe_levels(nprobes);
+    auto f = OMEGA_H_LAMBDA(LO source) {
+      auto const leaf = sources[source];
+      auto const level = levels[leaf];
+      auto const x = morton_decode(dim, leaf_codes[leaf]);
+      auto const h = I64(1) << (forest_max_level(dim) - level);
+      for (Int dir = 0; dir < ndirs; ++dir) {
+        Few<I64, 3> p;
+        for (Int a = 0; a < 3; ++a) p[a] = 0;
+        Int nonzeros = 0;
+        Int code = dir;
+        for (Int a = 0; a < dim; ++a) {
+          auto const step = code % 3 - 1;
+          code /= 3;
+          if (step) ++nonzeros;
+          if (step < 0) {
+            p[a] = 2 * x[a] - 1;
+          } else if (step > 0) {
+            p[a] = 2 * (x[a] + h) + 1;
+          } else {
+            p[a] = 2 * x[a] + 1;
+          }
+        }
+        if (nonzeros == 0 || nonzeros > max_nonzeros) continue;
+        LO root = leaf_roots[leaf];
+        if (!walk_to_root(r, &root, &p)) continue;
+        Few<I64, 3> cell;
+        for (Int a = 0; a < 3; ++a) cell[a] = (a < dim) ? (p[a] / 2) : 0;
+        auto const cell_code = morton_encode(dim, cell);
+        auto const probe = source * ndirs + dir;
+        probe_ranks[probe] =
+            find_last_not_after(rank_roots, rank_codes, root, cell_code);
+        probe_roots[probe] = root;
+        probe_codes[probe] = cell_code;
+        probe_levels[probe] = level;
+      }
+    };
+    parallel_for(sources.size(), f, "Forest::enforce_2to1_refine(probe)");
+    auto const sent2probes =
+        collect_marked(each_geq_to(Read<I32>(probe_ranks), I32(0)));
+    Dist probes2leaves;
+    probes2leaves.set_parent_comm(comm_);
+    probes2leaves.set_dest_ranks(unmap(sent2probes, Read<I32>(probe_ranks), 1));
+    auto const recvd_roots =
+        probes2leaves.exch(LOs(unmap(sent2probes, LOs(probe_roots), 1)), 1);
+    auto const recvd_codes =
+        probes2leaves.exch(
+            Read<I64>(unmap(sent2probes, Read<I64>(probe_codes), 1)), 1);
+    auto const recvd_levels =
+        probes2leaves.exch(Bytes(unmap(sent2probes, Bytes(probe_levels), 1)), 1);
+    Write<Byte> newly_marked(nleaves, 0);
+    auto g = OMEGA_H_LAMBDA(LO recvd) {
+      auto const leaf = find_last_not_after(
+          leaf_roots, leaf_codes, recvd_roots[recvd], recvd_codes[recvd]);
+      if (levels[leaf] < recvd_levels[recvd] && !marks[leaf]) {
+        newly_marked[leaf] = 1;
+      }
+    };
+    parallel_for(recvd_roots.size(), g, "Forest::enforce_2to1_refine(mark)");
+    new_marks = newly_marked;
+    if (get_max(comm_, new_marks) != 1) break;
+    marks = lor_each(marks, new_marks);
+  }
+  return marks;
+}
+
+void Forest::refine(Bytes leaves_are_marked, TransferOpts const& xfer_opts) {
+  auto const r = get_root_mesh(&roots_);
+  auto const dim = r.dim;
+  auto const nleaf_verts = 1 << dim;
+  auto const old_roots = mesh_.get_array<LO>(dim, "forest_root");
+  auto const old_codes = mesh_.get_array<I64>(dim, "forest_code");
+  auto const old_levels = mesh_.ask_levels(dim);
+  auto const nold = mesh_.nelems();
+  Write<LO> nkids(nold);
+  auto f = OMEGA_H_LAMBDA(LO leaf) {
+    OMEGA_H_CHECK(
+        !leaves_are_marked[leaf] || old_levels[leaf] < forest_max_level(dim));
+    nkids[leaf] = leaves_are_marked[leaf] ? nleaf_verts : 1;
+  };
+  parallel_for(nold, f, "Forest::refine(count)");
+  auto const old2new = offset_scan(LOs(nkids));
+  auto const nnew = old2new.last();
+  Write<LO> new_roots(nnew);
+  Write<I64> new_codes(nnew);
+  Write<Byte> new_levels(nnew);
+  Write<LO> new2old(nnew);
+  auto g = OMEGA_H_LAMBDA(LO leaf) {
+    auto const level = old_levels[leaf];
+    auto const nkids_of = old2new[leaf + 1] - old2new[leaf];
+    for (Int kid = 0; kid < nkids_of; ++kid) {
+      auto const idx = old2new[leaf] + kid;
+      new_roots[idx] = old_roots[leaf];
+      new2old[idx] = leaf;
+      if (leaves_are_marked[leaf]) {
+        new_codes[idx] =
+            old_codes[leaf] | (I64(kid) << digit_shift(dim, level + 1));
+        new_levels[idx] = Byte(level + 1);
+      } else {
+        new_codes[idx] = old_codes[leaf];
+        new_levels[idx] = level;
+      }
+    }
+  };
+  parallel_for(nold, g, "Forest::refine(children)");
+  Read<GO> new_vert_keys;
+  auto new_mesh = build(new_roots, new_codes, new_levels, &new_vert_keys);
+  /* vertices that existed keep their values,
+     new ones are interpolated inside the parent of one of their leaves */
+  auto const old_ev2v = mesh_.ask_elem_verts();
+  auto const old_corner_keys =
+      get_corner_keys(r, old_roots, old_codes, old_levels);
+  auto const old_verts2elems = mesh_.ask_up(VERT, dim);
+  auto const old_nverts = mesh_.nverts();
+  Write<GO> old_vert_keys(old_nverts * 3);
+  auto h = OMEGA_H_LAMBDA(LO v) {
+    auto const ve = old_verts2elems.a2ab[v];
+    auto const corner = old_verts2elems.ab2b[ve] * nleaf_verts +
+                        code_which_down(old_verts2elems.codes[ve]);
+    for (Int i = 0; i < 3; ++i) {
+      old_vert_keys[v * 3 + i] = old_corner_keys[corner * 3 + i];
+    }
+  };
+  parallel_for(old_nverts, h, "Forest::refine(old keys)");
+  auto const sorted2old_verts = sort_by_keys(Read<GO>(old_vert_keys), 3);
+  Read<GO> const sorted_keys = unmap(sorted2old_verts, Read<GO>(old_vert_keys), 3);
+  auto const new_verts2elems = new_mesh.ask_up(VERT, dim);
+  auto const new_nverts = new_mesh.nverts();
+  Write<LO> new2old_verts(new_nverts);
+  Write<LO> new_verts2parents(new_nverts);
+  Write<Real> new_verts2weights(new_nverts * nleaf_verts);
+  auto k = OMEGA_H_LAMBDA(LO v) {
+    LO lo = 0;
+    LO hi = sorted2old_verts.size();
+    while (lo < hi) {
+      auto const mid = (lo + hi) / 2;
+      if (key_less(sorted_keys, mid, new_vert_keys, v)) {
+        lo = mid + 1;
+      } else {
+        hi = mid;
+      }
+    }
+    auto const found =
+        lo < sorted2old_verts.size() && keys_equal(sorted_keys, lo, new_vert_keys, v);
+    new2old_verts[v] = found ? sorted2old_verts[lo] : -1;
+    auto const ve = new_verts2elems.a2ab[v];
+    auto const elem = new_verts2elems.ab2b[ve];
+    auto const which = code_which_down(new_verts2elems.codes[ve]);
+    auto const parent = new2old[elem];
+    new_verts2parents[v] = parent;
+    auto const p = get_leaf_corner(
+        dim, new_codes[elem], new_levels[elem], tensor2vert(dim, which));
+    auto const x = morton_decode(dim, old_codes[parent]);
+    auto const h2 = I64(2) << (forest_max_level(dim) - old_levels[parent]);
+    for (Int t = 0; t < nleaf_verts; ++t) {
+      Real w = 1.0;
+      for (Int a = 0; a < dim; ++a) {
+        auto const s = Real(p[a] - 2 * x[a]) / Real(h2);
+        w *= ((t >> a) & 1) ? s : (1.0 - s);
+      }
+      new_verts2weights[v * nleaf_verts + t] = w;
+    }
+  };
+  parallel_for(new_nverts, k, "Forest::refine(vert sources)");
+  for (Int i = 0; i < mesh_.ntags(VERT); ++i) {
+    auto const tagbase = mesh_.get_tag(VERT, i);
+    auto const& name = tagbase->name();
+    if (name == "coordinates") continue;
+    if (!should_interpolate(&mesh_, xfer_opts, VERT, tagbase)) continue;
+    auto const ncomps = tagbase->ncomps();
+    auto const old_data = mesh_.get_array<Real>(VERT, name);
+    Write<Real> new_data(new_nverts * ncomps);
+    auto l = OMEGA_H_LAMBDA(LO v) {
+      auto const old_v = new2old_verts[v];
+      for (Int c = 0; c < ncomps; ++c) {
+        if (old_v != -1) {
+          new_data[v * ncomps + c] = old_data[old_v * ncomps + c];
+          continue;
+        }
+        auto const parent = new_verts2parents[v];
+        Real value = 0.0;
+        for (Int t = 0; t < nleaf_verts; ++t) {
+          auto const pv = old_ev2v[parent * nleaf_verts + tensor2vert(dim, t)];
+          value += new_verts2weights[v * nleaf_verts + t] *
+                   old_data[pv * ncomps + c];
+        }
+        new_data[v * ncomps + c] = value;
+      }
+    };
+    parallel_for(new_nverts, l, "Forest::refine(interpolate)");
+    new_mesh.add_tag(VERT, name, ncomps,
+        new_mesh.sync_array(VERT, Reals(new_data), ncomps));
+  }
+  for (Int i = 0; i < mesh_.ntags(dim); ++i) {
+    auto const tagbase = mesh_.get_tag(dim, i);
+    auto const& name = tagbase->name();
+    if (new_mesh.has_tag(dim, name)) continue;
+    if (!is_transfer_required(xfer_opts, name, OMEGA_H_INHERIT)) continue;
+    switch (tagbase->type()) {
+      case OMEGA_H_I8:
+        inherit_elem_tag<I8>(&mesh_, &new_mesh, new2old, name);
+        break;
+      case OMEGA_H_I32:
+        inherit_elem_tag<I32>(&mesh_, &new_mesh, new2old, name);
+        break;
+      case OMEGA_H_I64:
+        inherit_elem_tag<I64>(&mesh_, &new_mesh, new2old, name);
+        break;
+      case OMEGA_H_F64:
+        inherit_elem_tag<Real>(&mesh_, &new_mesh, new2old, name);
+        break;
+    }
+  }
+  mesh_ = new_mesh;
+}
+
+}  // namespace amr
+
+}  // namespace Omega_h
@@ -0,0 +1,82 @@
+#ifndef OMEGA_H_AMR_FOREST_HPP
+#define OMEGA_H_AMR_FOREST_HPP
+
+#include <Omega_h_adapt.hpp>
+#include <Omega_h_adj.hpp>
+#include <Omega_h_mesh.hpp>
+
+namespace Omega_h {
+
+namespace amr {
+
+/* the deepest level a Forest can refine to, such that Morton codes
+   of the leaves fit in 64 bits */
+OMEGA_H_INLINE constexpr Int forest_max_level(Int dim) {
+  return (dim == 1) ? 60 : ((dim == 2) ? 29 : 20);
+}
+
+/* a compact alternative to refine() for deep hierarchies.
+   instead of keeping every level as mesh entities, a Forest keeps a mesh
+   of only the leaf elements, each tagged with the root element it
+   descends from ("forest_root"), the Morton code of its lowest corner
+   in the tree of that root ("forest_code") and its "level".
+   parents and children are derived from these codes when asked for.
+
+   the root mesh is kept whole on every rank, so each rank can find the
+   neighbors of its leaves in other roots by itself. the leaves are
+   ordered by root and code, each rank holds a contiguous range of that
+   order, and refinement keeps children on the rank of their parent.
+
+   leaf meshes are not conforming: a vertex where finer leaves meet a
+   coarser one belongs only to the finer leaves. */
+class Forest {
+ public:
+  /* (roots) is a hypercube mesh on a single rank, the same on every rank
+     of (comm). each rank starts with a slice of its elements as leaves */
+  Forest(Mesh* roots, CommPtr comm);
+  Mesh* mesh();
+  Mesh* roots();
+  /* the tree nodes one level above the leaves, which are not in the
+     mesh. they are numbered in tree order, and their roots, codes and
+     levels are returned through the optional pointers.
+     leaves of level zero have no parent */
+  Parents ask_parents(LOs* parent_roots = nullptr,
+      Read<I64>* parent_codes = nullptr, Bytes* parent_levels = nullptr);
+  /* the leaves on this rank that are children of each node
+     from ask_parents() */
+  Children ask_children();
+  /* the conforming counterpart of Omega_h::mark_exposed_sides():
+     the leaf sides on the boundary of the root mesh. a hanging side,
+     where a coarser leaf meets finer ones, has a single leaf in the
+     leaf mesh but is not exposed */
+  Read<I8> mark_exposed_sides();
+  /* adds to the marked leaves those that must also be refined so that
+     leaves meeting at an entity of (bridge_dim) differ by at most one
+     level afterwards. the forest must satisfy that already.
+     neighbors are found from the codes, walking into neighboring roots
+     through their shared sides, and requests cross ranks only when a
+     neighbor lives elsewhere. */
+  Bytes enforce_2to1_refine(Int bridge_dim, Bytes leaves_are_marked);
+  /* replaces each marked leaf by its children.
+     coordinates and classification come from the roots,
+     vertex fields marked for linear interpolation are interpolated
+     from the parent and element fields marked for inheritance
+     are copied from it */
+  void refine(Bytes leaves_are_marked, TransferOpts const& xfer_opts);
+
+ private:
+  Mesh build(LOs leaf_roots, Read<I64> leaf_codes, Bytes leaf_levels,
+      Read<GO>* vert_keys);
+  Mesh roots_;
+  CommPtr comm_;
+  /* a graph communicator from every rank to every rank,
+     for gathering the first leaf of each rank */
+  CommPtr all_comm_;
+  Mesh mesh_;
+};
+
+}  // namespace amr
+
+}  // namespace Omega_h
+
+#endif
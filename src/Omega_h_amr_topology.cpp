@@ -89,7 +89,7 @@ Few<LO, 4> count_refined(Mesh* mesh) {
   return num_ents;
 }
 
-LOs get_refined_topology(Mesh* mesh, Int child_dim, LO num_children,
+LOs get_refined_topology(Mesh* mesh, Int child_dim, Int num_children,
     Few<LOs, 4> mods2mds, Few<LOs, 4> mds2mods, Few<LOs, 4> mods2midverts,
     LOs old_verts2new_verts) {
   Int spatial_dim = mesh->dim();
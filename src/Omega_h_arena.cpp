@@ -0,0 +1,162 @@
+#include <Omega_h_arena.hpp>
+#include <Omega_h_fail.hpp>
+#include <Omega_h_malloc.hpp>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+namespace Omega_h {
+
+struct ArenaChunk {
+  void* data;
+  std::size_t bytes;
+  std::size_t used;
+  std::size_t nlive;
+};
+
+namespace {
+
+struct Arena {
+  std::size_t chunk_bytes;
+  int depth;
+  /* the chunk being bump-allocated from, if any */
+  ArenaChunk* open;
+  std::vector<ArenaChunk*> free_chunks;
+};
+
+/* arrays are allocated and freed by worker threads as well,
+   so everything below is guarded by global_arena_mutex.
+   global_arena is also atomic so that allocations can skip
+   the lock entirely while arenas are disabled */
+std::mutex global_arena_mutex;
+std::atomic<Arena*> global_arena(nullptr);
+std::atomic<std::size_t> global_nallocs(0);
+ArenaStats global_arena_stats = {0, 0, 0, 0, 0};
+
+/* keeps SIMD loads aligned and separate arrays on separate cache lines */
+constexpr std::size_t arena_alignment = 64;
+
+void free_chunk(ArenaChunk* chunk) {
+  maybe_pooled_device_free(chunk->data, chunk->bytes);
+  delete chunk;
+}
+
+ArenaChunk* get_chunk(Arena& arena) {
+  if (!arena.free_chunks.empty()) {
+    auto chunk = arena.free_chunks.back();
+    arena.free_chunks.pop_back();
+    ++global_arena_stats.nchunk_reuses;
+    return chunk;
+  }
+  auto data = maybe_pooled_device_malloc(arena.chunk_bytes);
+  if (data == nullptr) return nullptr;
+  ++global_arena_stats.nchunk_mallocs;
+  return new ArenaChunk{data, arena.chunk_bytes, 0, 0};
+}
+
+/* stop allocating from the open chunk. if nothing in it is
+   alive it can be recycled right away, otherwise that happens
+   when its last array dies */
+void close_chunk(Arena& arena) {
+  auto chunk = arena.open;
+  arena.open = nullptr;
+  if (!chunk) return;
+  if (chunk->nlive == 0) {
+    chunk->used = 0;
+    arena.free_chunks.push_back(chunk);
+  } else {
+    ++global_arena_stats.nchunk_pins;
+  }
+}
+
+}  // end anonymous namespace
+
+void enable_arenas(std::size_t chunk_bytes) {
+  std::lock_guard<std::mutex> lock(global_arena_mutex);
+  OMEGA_H_CHECK(global_arena == nullptr);
+  global_arena = new Arena{chunk_bytes, 0, nullptr, {}};
+}
+
+void disable_arenas() {
+  std::lock_guard<std::mutex> lock(global_arena_mutex);
+  Arena* arena = global_arena;
+  if (!arena) return;
+  close_chunk(*arena);
+  for (auto chunk : arena->free_chunks) free_chunk(chunk);
+  delete arena;
+  global_arena = nullptr;
+}
+
+bool arenas_enabled() { return global_arena != nullptr; }
+
+void* arena_allocate(std::size_t size, ArenaChunk** p_chunk) {
+  ++global_nallocs;
+  *p_chunk = nullptr;
+  if (!global_arena) return nullptr;
+  std::lock_guard<std::mutex> lock(global_arena_mutex);
+  Arena* arena = global_arena;
+  if (!arena || arena->depth == 0) return nullptr;
+  if (size == 0 || size > arena->chunk_bytes / 4) return nullptr;
+  auto const aligned_size =
+      ((size + arena_alignment - 1) / arena_alignment) * arena_alignment;
+  if (arena->open && arena->open->used + aligned_size > arena->open->bytes) {
+    close_chunk(*arena);
+  }
+  if (!arena->open) arena->open = get_chunk(*arena);
+  if (!arena->open) return nullptr;
+  auto chunk = arena->open;
+  auto ptr = static_cast<char*>(chunk->data) + chunk->used;
+  chunk->used += aligned_size;
+  ++chunk->nlive;
+  ++global_arena_stats.narena_allocs;
+  *p_chunk = chunk;
+  return ptr;
+}
+
+void arena_deallocate(ArenaChunk* chunk) {
+  std::lock_guard<std::mutex> lock(global_arena_mutex);
+  OMEGA_H_CHECK(chunk->nlive > 0);
+  --chunk->nlive;
+  if (chunk->nlive) return;
+  Arena* arena = global_arena;
+  if (!arena) {
+    /* the arena was disabled while this chunk was still in use */
+    free_chunk(chunk);
+  } else if (chunk == arena->open) {
+    chunk->used = 0;
+  } else {
+    chunk->used = 0;
+    arena->free_chunks.push_back(chunk);
+  }
+}
+
+ArenaStats get_arena_stats() {
+  std::lock_guard<std::mutex> lock(global_arena_mutex);
+  auto stats = global_arena_stats;
+  stats.nallocs = global_nallocs;
+  return stats;
+}
+
+void reset_arena_stats() {
+  std::lock_guard<std::mutex> lock(global_arena_mutex);
+  global_nallocs = 0;
+  global_arena_stats = ArenaStats{0, 0, 0, 0, 0};
+}
+
+ScopedArena::ScopedArena() {
+  std::lock_guard<std::mutex> lock(global_arena_mutex);
+  Arena* arena = global_arena;
+  if (arena) ++arena->depth;
+}
+
+ScopedArena::~ScopedArena() {
+  std::lock_guard<std::mutex> lock(global_arena_mutex);
+  Arena* arena = global_arena;
+  if (!arena || arena->depth == 0) return;
+  --arena->depth;
+  /* the next operator starts from a chunk that has nothing but
+     its own temporaries in it */
+  if (arena->depth == 0) close_chunk(*arena);
+}
+
+}  // namespace Omega_h
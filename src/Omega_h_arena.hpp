@@ -0,0 +1,63 @@
+#ifndef OMEGA_H_ARENA_HPP
+#define OMEGA_H_ARENA_HPP
+
+#include <cstddef>
+
+namespace Omega_h {
+
+/* arenas serve the many small, short-lived arrays that an adapt
+   operator creates (candidate lists, cavities, qualities, ...).
+   while a ScopedArena is alive, array allocations up to a quarter
+   of the chunk size are bump-allocated from a chunk of memory
+   that is reused across operators.
+   a chunk is released as a whole, once the last array in it dies,
+   so arrays which outlive the operator (the new mesh) are
+   perfectly safe, they just keep their chunk from being reused
+   until they are gone. the cost is that even a small long-lived
+   array pins its whole chunk; ArenaStats::nchunk_pins counts how
+   often that happened, and a smaller chunk size bounds it.
+   arrays may be allocated and freed from any thread.
+   ScopedArena depth is global, so an arena opened by one thread
+   also serves the allocations other threads make meanwhile.
+   with Kokkos, arrays are Kokkos::Views and arenas have no effect. */
+
+struct ArenaChunk;
+
+struct ArenaStats {
+  /* every array allocation, whether or not an arena was active */
+  std::size_t nallocs;
+  /* allocations served from an arena chunk */
+  std::size_t narena_allocs;
+  /* chunks obtained from the underlying allocator */
+  std::size_t nchunk_mallocs;
+  /* chunks that were recycled instead */
+  std::size_t nchunk_reuses;
+  /* chunks closed while arrays in them were still alive,
+     which keeps the whole chunk until the last of them dies */
+  std::size_t nchunk_pins;
+};
+
+void enable_arenas(std::size_t chunk_bytes = std::size_t(4) << 20);
+void disable_arenas();
+bool arenas_enabled();
+
+/* returns nullptr if the allocation should go elsewhere,
+   otherwise (*p_chunk) must be handed to arena_deallocate later */
+void* arena_allocate(std::size_t size, ArenaChunk** p_chunk);
+void arena_deallocate(ArenaChunk* chunk);
+
+ArenaStats get_arena_stats();
+void reset_arena_stats();
+
+struct ScopedArena {
+  ScopedArena();
+  ~ScopedArena();
+  ScopedArena(ScopedArena const&) = delete;
+  ScopedArena(ScopedArena&&) = delete;
+  ScopedArena& operator=(ScopedArena const&) = delete;
+  ScopedArena& operator=(ScopedArena&&) = delete;
+};
+
+}  // namespace Omega_h
+
+#endif
@@ -28,6 +28,10 @@ T* nonnull(T* p) {
 #ifdef OMEGA_H_USE_KOKKOS
 template <typename T>
 Write<T>::Write(Kokkos::View<T*> view_in) : view_(view_in) {}
+#else
+template <typename T>
+Write<T>::Write(SharedAlloc shared_alloc_in)
+    : shared_alloc_(std::move(shared_alloc_in)) {}
 #endif
 
 template <typename T>
@@ -388,6 +392,20 @@ Write<T> deep_copy(Read<T> a, std::string const& name) {
   return b;
 }
 
+template <class T>
+Write<T> adopt_host_memory(T* data, LO size, std::function<void()> release,
+    std::string const& name) {
+#if defined(OMEGA_H_USE_KOKKOS) || defined(OMEGA_H_USE_CUDA)
+  HostWrite<T> copy(size, name);
+  for (LO i = 0; i < size; ++i) copy[i] = data[i];
+  release();
+  return copy.write();
+#else
+  return Write<T>(SharedAlloc(sizeof(T) * static_cast<std::size_t>(size), name,
+      data, std::move(release)));
+#endif
+}
+
 #define INST(T)                                                                \
   template T* nonnull(T*);                                                     \
   template T const* nonnull(T const*);                                         \
@@ -399,7 +417,9 @@ Write<T> deep_copy(Read<T> a, std::string const& name) {
   template void fill(Write<T> a, T val);                                       \
   template void fill_linear(Write<T> a, T, T);                                 \
   template void copy_into(Read<T> a, Write<T> b);                              \
-  template Write<T> deep_copy(Read<T> a, std::string const&);
+  template Write<T> deep_copy(Read<T> a, std::string const&);                 \
+  template Write<T> adopt_host_memory(                                         \
+      T*, LO, std::function<void()>, std::string const&);
 
 INST(I8)
 INST(I32)
@@ -3,6 +3,7 @@
 
 #include <Omega_h_defines.hpp>
 #include <Omega_h_fail.hpp>
+#include <functional>
 #include <initializer_list>
 #include <memory>
 #ifdef OMEGA_H_USE_KOKKOS
@@ -41,6 +42,8 @@ class Write {
   }
 #ifdef OMEGA_H_USE_KOKKOS
   Write(Kokkos::View<T*> view_in);
+#else
+  Write(SharedAlloc shared_alloc_in);
 #endif
   Write(LO size_in, std::string const& name = "");
   Write(LO size_in, T value, std::string const& name = "");
@@ -267,6 +270,13 @@ template <class T>
 void copy_into(Read<T> a, Write<T> b);
 template <class T>
 Write<T> deep_copy(Read<T> a, std::string const& name = "");
+/* an array made of (size) values at (data) in host memory, which
+   belong to someone else. (release) is called once no array uses
+   them anymore. builds that keep arrays in host memory use them in place,
+   others copy them and call (release) right away. */
+template <class T>
+Write<T> adopt_host_memory(T* data, LO size, std::function<void()> release,
+    std::string const& name = "");
 
 /* begin explicit instantiation declarations */
 #define OMEGA_H_EXPL_INST_DECL(T)                                              \
@@ -279,7 +289,9 @@ Write<T> deep_copy(Read<T> a, std::string const& name = "");
   extern template void fill(Write<T> a, T val);                                \
   extern template void fill_linear(Write<T> a, T, T);                          \
   extern template void copy_into(Read<T> a, Write<T> b);                       \
-  extern template Write<T> deep_copy(Read<T> a, std::string const&);
+  extern template Write<T> deep_copy(Read<T> a, std::string const&);          \
+  extern template Write<T> adopt_host_memory(                                  \
+      T*, LO, std::function<void()>, std::string const&);
 OMEGA_H_EXPL_INST_DECL(I8)
 OMEGA_H_EXPL_INST_DECL(I32)
 OMEGA_H_EXPL_INST_DECL(I64)
@@ -19,16 +19,49 @@ bool operator==(Read<T> a, Read<T> b) {
   return transform_reduce(first, last, init, op, std::move(transform));
 }
 
+static bool repro_reductions = false;
+
+void enable_repro_reductions() { repro_reductions = true; }
+
+void disable_repro_reductions() { repro_reductions = false; }
+
+bool repro_reductions_enabled() { return repro_reductions; }
+
 template <typename T>
-promoted_t<T> get_sum(Read<T> a) {
+static promoted_t<T> fast_sum(Read<T> a) {
   using PT = promoted_t<T>;
   return transform_reduce(a.begin(), a.end(), PT(0), plus<PT>(),
       OMEGA_H_LAMBDA(T val)->PT { return PT(val); });
 }
 
+template <typename T>
+static promoted_t<T> any_order_sum(Read<T> a) {
+  return fast_sum(a);
+}
+
+static Real any_order_sum(Read<Real> a) {
+  if (repro_reductions) return repro_sum(a);
+  return fast_sum(a);
+}
+
+template <typename T>
+static promoted_t<T> any_order_sum(CommPtr comm, Read<T> a) {
+  return comm->allreduce(fast_sum(a), OMEGA_H_SUM);
+}
+
+static Real any_order_sum(CommPtr comm, Read<Real> a) {
+  if (repro_reductions) return repro_sum(comm, a);
+  return comm->allreduce(fast_sum(a), OMEGA_H_SUM);
+}
+
+template <typename T>
+promoted_t<T> get_sum(Read<T> a) {
+  return any_order_sum(a);
+}
+
 template <typename T>
 promoted_t<T> get_sum(CommPtr comm, Read<T> a) {
-  return comm->allreduce(get_sum(a), OMEGA_H_SUM);
+  return any_order_sum(comm, a);
 }
 
 template <typename T>
@@ -635,5 +668,8 @@ INST(Real)
 
 template Read<Real> array_cast(Read<I32>);
 template Read<I32> array_cast(Read<I8>);
+template Read<I64> array_cast(Read<I8>);
+template Read<I64> array_cast(Read<I32>);
+template Read<I32> array_cast(Read<I64>);
 
 }  // end namespace Omega_h
@@ -116,6 +116,19 @@ Real repro_sum(Reals a);
 Real repro_sum(CommPtr comm, Reals a);
 void repro_sum(CommPtr comm, Reals a, Int ncomps, Real result[]);
 
+/* while reproducible reductions are enabled (--osh-repro),
+   get_sum() of Reals is computed in fixed point as repro_sum() does,
+   so it gives the same result for the same values however they are
+   spread over threads and ranks.
+   fan_reduce() and what is built on it are unchanged: each fan is
+   summed serially in the order it lists its entries, which is already
+   reproducible on a fixed partition, and their per-rank partial sums
+   are rounded before ranks combine them, so they still depend on the
+   partition. minima, maxima and integer sums are exact in any order. */
+void enable_repro_reductions();
+void disable_repro_reductions();
+bool repro_reductions_enabled();
+
 Reals interpolate_between(Reals a, Reals b, Real t);
 Reals invert_each(Reals a);
 
@@ -171,6 +184,9 @@ OMEGA_H_EXPL_INST_DECL(Real)
 
 extern template Read<Real> array_cast(Read<I32>);
 extern template Read<I32> array_cast(Read<I8>);
+extern template Read<I64> array_cast(Read<I8>);
+extern template Read<I64> array_cast(Read<I32>);
+extern template Read<I32> array_cast(Read<I64>);
 
 }  // end namespace Omega_h
 
@@ -58,8 +58,8 @@ void update_from_file(Assoc* p_assoc, std::string const& filepath) {
       }
     }
     if (set_type >= NSET_TYPES) {
-      Omega_h_fail("Unknown set type \"%s\" at %s +%d\n", sline.c_str(),
-          filepath.c_str(), lc);
+      Omega_h_fail("Unknown set type \"%s\" at %s +%ld\n", sline.c_str(),
+          filepath.c_str(), long(lc));
     }
     std::stringstream rest_stream(rest);
     std::string set_name;
@@ -68,14 +68,15 @@ void update_from_file(Assoc* p_assoc, std::string const& filepath) {
     rest_stream >> set_size;
     if (!rest_stream) {
       Omega_h_fail(
-          "Couldn't parse set name and size at %s +%d\n", filepath.c_str(), lc);
+          "Couldn't parse set name and size at %s +%ld\n", filepath.c_str(),
+          long(lc));
     }
     for (LO i = 0; i < set_size; ++i) {
       std::string eline;
       std::getline(f, eline);
       if (!f || eline.empty()) {
         Omega_h_fail(
-            "Expected more pairs after %s +%d\n", filepath.c_str(), lc);
+            "Expected more pairs after %s +%ld\n", filepath.c_str(), long(lc));
       }
       ++lc;
       std::stringstream pair_stream(eline);
@@ -83,8 +84,8 @@ void update_from_file(Assoc* p_assoc, std::string const& filepath) {
       LO class_id;
       pair_stream >> class_dim >> class_id;
       if (!pair_stream) {
-        Omega_h_fail("Couldn't parse pair \"%s\" at %s +%d\n", eline.c_str(),
-            filepath.c_str(), lc);
+        Omega_h_fail("Couldn't parse pair \"%s\" at %s +%ld\n", eline.c_str(),
+            filepath.c_str(), long(lc));
       }
       assoc[set_type][set_name].push_back({class_dim, class_id});
     }
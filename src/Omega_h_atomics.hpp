@@ -1,7 +1,7 @@
 #ifndef OMEGA_H_ATOMICS_HPP
 #define OMEGA_H_ATOMICS_HPP
 
-#include <Omega_h_config.h>
+#include <Omega_h_defines.hpp>
 
 #if defined(OMEGA_H_USE_KOKKOS)
 #include <Kokkos_Core.hpp>
@@ -9,7 +9,7 @@
 
 namespace Omega_h {
 
-OMEGA_H_DEVICE int atomic_fetch_add(int* const dest, const int val) {
+OMEGA_H_DEVICE LO atomic_fetch_add(LO* const dest, const LO val) {
 #if defined(OMEGA_H_USE_KOKKOS)
   return Kokkos::atomic_fetch_add(dest, val);
 #elif defined(OMEGA_H_USE_OPENMP)
@@ -17,7 +17,7 @@ OMEGA_H_DEVICE int atomic_fetch_add(int* const dest, const int val) {
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wunused-value"
 #endif
-  int oldval;
+  LO oldval;
 #pragma omp atomic capture
   {
     oldval = *dest;
@@ -27,25 +27,32 @@ OMEGA_H_DEVICE int atomic_fetch_add(int* const dest, const int val) {
 #pragma GCC diagnostic pop
 #endif
   return oldval;
+#elif defined(OMEGA_H_USE_THREADS)
+  return __atomic_fetch_add(dest, val, __ATOMIC_RELAXED);
+#elif defined(OMEGA_H_USE_CUDA) && defined(OMEGA_H_LO_64)
+  using ULL = unsigned long long;
+  return LO(atomicAdd(reinterpret_cast<ULL*>(dest), ULL(val)));
 #elif defined(OMEGA_H_USE_CUDA)
   return atomicAdd(dest, val);
 #else
-  int oldval = *dest;
+  LO oldval = *dest;
   *dest += val;
   return oldval;
 #endif
 }
 
-OMEGA_H_DEVICE void atomic_increment(int* const dest) {
-#if defined(OMEGA_H_USE_OPENMP) || defined(OMEGA_H_USE_CUDA)
+OMEGA_H_DEVICE void atomic_increment(LO* const dest) {
+#if defined(OMEGA_H_USE_OPENMP) || defined(OMEGA_H_USE_CUDA) || \
+    defined(OMEGA_H_USE_THREADS)
   atomic_fetch_add(dest, 1);
 #else
   ++(*dest);
 #endif
 }
 
-OMEGA_H_DEVICE void atomic_add(int* const dest, const int val) {
-#if defined(OMEGA_H_USE_OPENMP) || defined(OMEGA_H_USE_CUDA)
+OMEGA_H_DEVICE void atomic_add(LO* const dest, const LO val) {
+#if defined(OMEGA_H_USE_OPENMP) || defined(OMEGA_H_USE_CUDA) || \
+    defined(OMEGA_H_USE_THREADS)
   atomic_fetch_add(dest, val);
 #else
   *dest += val;
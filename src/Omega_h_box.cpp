@@ -136,7 +136,7 @@ void classify_box_dim(Mesh* mesh, Int ent_dim, Reals centroids,
   mesh->add_tag<Byte>(ent_dim, "class_dim", 1, class_dims);
 }
 
-void classify_box(Mesh* mesh, Real x, Real y, Real z, LO nx, LO ny, LO nz) {
+void classify_box(Mesh* mesh, Real x, Real y, Real z, Int nx, Int ny, Int nz) {
   Few<LO, 3> nel({nx, ny, nz});
   Vector<3> l({x, y, z});
   for (Int ent_dim = 0; ent_dim <= mesh->dim(); ++ent_dim) {
@@ -6,6 +6,7 @@
 #include "Omega_h_class.hpp"
 #include "Omega_h_element.hpp"
 #include "Omega_h_for.hpp"
+#include "Omega_h_hilbert.hpp"
 #include "Omega_h_inertia.hpp"
 #include "Omega_h_linpart.hpp"
 #include "Omega_h_map.hpp"
@@ -148,6 +149,198 @@ Mesh build_box(CommPtr comm, Omega_h_Family family, Real x, Real y, Real z,
   return mesh;
 }
 
+/* the first cell of block (b) when (n) cells are split into (p) blocks
+   as suggest_slices() does */
+OMEGA_H_INLINE GO get_block_begin(GO n, I32 p, I32 b) {
+  auto const quot = n / p;
+  auto const rem = n % p;
+  return quot * b + ((b < rem) ? b : rem);
+}
+
+/* the block that owns vertex (i) of the (n + 1) along an axis,
+   which is the block of the cell above it, or the last block */
+OMEGA_H_INLINE I32 get_vert_block(GO i, GO n, I32 p) {
+  auto const c = (i < n) ? i : (n - 1);
+  auto const quot = n / p;
+  auto const rem = n % p;
+  auto const nbig = rem * (quot + 1);
+  if (c < nbig) return I32(c / (quot + 1));
+  return I32(rem + (c - nbig) / quot);
+}
+
+/* chooses how many blocks to cut each axis of the box into,
+   minimizing the area of the cuts. the block counts must multiply
+   to (nranks) and none may exceed the cells along its axis */
+static bool choose_box_blocks(
+    I32 nranks, Int dim, Few<GO, 3> n, Few<I32, 3>* p_blocks) {
+  Few<I32, 3> best = {0, 0, 0};
+  Real best_cost = 0.0;
+  for (I32 px = 1; px <= nranks; ++px) {
+    if (nranks % px || px > n[0]) continue;
+    for (I32 py = 1; py <= nranks / px; ++py) {
+      if ((nranks / px) % py || py > n[1]) continue;
+      auto const pz = nranks / px / py;
+      if (pz > n[2]) continue;
+      Real cost;
+      if (dim == 2) {
+        cost = Real(n[1]) * (px - 1) + Real(n[0]) * (py - 1);
+      } else {
+        cost = Real(n[1]) * Real(n[2]) * (px - 1) +
+               Real(n[0]) * Real(n[2]) * (py - 1) +
+               Real(n[0]) * Real(n[1]) * (pz - 1);
+      }
+      if (best[0] == 0 || cost < best_cost) {
+        best = {px, py, pz};
+        best_cost = cost;
+      }
+    }
+  }
+  if (p_blocks) *p_blocks = best;
+  return best[0] != 0;
+}
+
+static Few<GO, 3> get_box_cells(LO nx, LO ny, LO nz) {
+  return {nx, ny, (nz == 0) ? 1 : nz};
+}
+
+bool can_build_box_distributed(I32 nranks, LO nx, LO ny, LO nz) {
+  Int const dim = (nz == 0) ? 2 : 3;
+  return choose_box_blocks(nranks, dim, get_box_cells(nx, ny, nz), nullptr);
+}
+
+Mesh build_box_distributed(CommPtr comm, Omega_h_Family family, Real x,
+    Real y, Real z, LO nx, LO ny, LO nz, bool hilbert_order) {
+  OMEGA_H_TIME_FUNCTION;
+  OMEGA_H_CHECK(nx > 0);
+  OMEGA_H_CHECK(ny > 0);
+  OMEGA_H_CHECK(nz >= 0);
+  Int const dim = (nz == 0) ? 2 : 3;
+  /* a 2D box is treated as one layer of cells with one layer of vertices */
+  auto const n = get_box_cells(nx, ny, nz);
+  Few<I32, 3> p;
+  if (!choose_box_blocks(comm->size(), dim, n, &p)) {
+    Omega_h_fail("build_box_distributed: can't cut a %ld x %ld x %ld box "
+                 "into %d blocks\n",
+        long(n[0]), long(n[1]), long(n[2]), comm->size());
+  }
+  auto const rank = comm->rank();
+  Few<I32, 3> const b = {rank % p[0], (rank / p[0]) % p[1], rank / (p[0] * p[1])};
+  Few<GO, 3> c0;
+  Few<LO, 3> lc;
+  Few<LO, 3> lv;
+  for (Int a = 0; a < 3; ++a) {
+    GO end;
+    suggest_slices(n[a], p[a], b[a], &c0[a], &end);
+    lc[a] = LO(end - c0[a]);
+    lv[a] = lc[a] + 1;
+  }
+  if (dim == 2) lv[2] = 1;
+  Few<GO, 3> const gv = {n[0] + 1, n[1] + 1, n[2] + 1};
+  Few<Real, 3> const h = {x / nx, y / ny, (dim == 3) ? (z / nz) : 0.0};
+  /* vertices are numbered lexicographically on each rank as they are
+     globally, so local order follows global order and each vertex knows
+     the rank and local index of its owner without communicating */
+  auto const nverts = lv[0] * lv[1] * lv[2];
+  Write<GO> vert_globals_w(nverts);
+  Write<Real> coords_w(nverts * dim);
+  Write<I32> own_ranks_w(nverts);
+  Write<LO> own_idxs_w(nverts);
+  auto fill_verts = OMEGA_H_LAMBDA(LO v) {
+    Few<GO, 3> g;
+    g[0] = c0[0] + v % lv[0];
+    g[1] = c0[1] + (v / lv[0]) % lv[1];
+    g[2] = (dim == 3) ? (c0[2] + v / (lv[0] * lv[1])) : 0;
+    vert_globals_w[v] = g[0] + g[1] * gv[0] + g[2] * gv[0] * gv[1];
+    for (Int a = 0; a < dim; ++a) coords_w[v * dim + a] = Real(g[a]) * h[a];
+    I32 own_rank = 0;
+    LO own_idx = 0;
+    LO stride = 1;
+    I32 rank_stride = 1;
+    for (Int a = 0; a < dim; ++a) {
+      auto const ob = get_vert_block(g[a], n[a], p[a]);
+      auto const ob_begin = get_block_begin(n[a], p[a], ob);
+      auto const ob_end = get_block_begin(n[a], p[a], ob + 1);
+      own_rank += ob * rank_stride;
+      own_idx += LO(g[a] - ob_begin) * stride;
+      rank_stride *= p[a];
+      stride *= LO(ob_end - ob_begin) + 1;
+    }
+    own_ranks_w[v] = own_rank;
+    own_idxs_w[v] = own_idx;
+  };
+  parallel_for(nverts, fill_verts, "build_box_distributed(verts)");
+  auto const vert_globals = GOs(vert_globals_w);
+  /* the cells of this block, as make_2d_box and make_3d_box make them */
+  auto const ncells = lc[0] * lc[1] * lc[2];
+  auto const cell_degree = (dim == 3) ? 8 : 4;
+  Write<LO> cv2v_w(ncells * cell_degree);
+  Write<GO> cell_globals_w(ncells);
+  Write<Real> cell_centers_w(ncells * dim);
+  auto fill_cells = OMEGA_H_LAMBDA(LO c) {
+    auto const i = c % lc[0];
+    auto const j = (c / lc[0]) % lc[1];
+    auto const k = c / (lc[0] * lc[1]);
+    cell_globals_w[c] =
+        (c0[0] + i) + (c0[1] + j) * n[0] + (c0[2] + k) * n[0] * n[1];
+    auto const sj = lv[0];
+    auto const sk = lv[0] * lv[1];
+    auto const v0 = k * sk + j * sj + i;
+    cv2v_w[c * cell_degree + 0] = v0;
+    cv2v_w[c * cell_degree + 1] = v0 + 1;
+    cv2v_w[c * cell_degree + 2] = v0 + sj + 1;
+    cv2v_w[c * cell_degree + 3] = v0 + sj;
+    if (dim == 3) {
+      cv2v_w[c * cell_degree + 4] = v0 + sk;
+      cv2v_w[c * cell_degree + 5] = v0 + sk + 1;
+      cv2v_w[c * cell_degree + 6] = v0 + sk + sj + 1;
+      cv2v_w[c * cell_degree + 7] = v0 + sk + sj;
+    }
+    Few<GO, 3> const g = {c0[0] + i, c0[1] + j, c0[2] + k};
+    for (Int a = 0; a < dim; ++a) {
+      cell_centers_w[c * dim + a] = (Real(g[a]) + 0.5) * h[a];
+    }
+  };
+  parallel_for(ncells, fill_cells, "build_box_distributed(cells)");
+  LOs cv2v = cv2v_w;
+  GOs cell_globals = cell_globals_w;
+  if (hilbert_order) {
+    auto const new2old = hilbert::sort_coords(Reals(cell_centers_w), dim);
+    cv2v = unmap(new2old, cv2v, cell_degree);
+    cell_globals = unmap(new2old, cell_globals, 1);
+  }
+  auto ev2v = cv2v;
+  auto elem_globals = cell_globals;
+  if (family == OMEGA_H_SIMPLEX) {
+    /* local vertex order follows global order, so each cell is split
+       as it would be in serial, and every cell of a structured box
+       is split into the same number of simplices */
+    ev2v = (dim == 3) ? tets_from_hexes(cv2v) : tris_from_quads(cv2v);
+    auto const nelems = divide_no_remainder(ev2v.size(), dim + 1);
+    auto const per_cell = (ncells == 0) ? 1 : divide_no_remainder(nelems, ncells);
+    Write<GO> elem_globals_w(nelems);
+    auto fill_elem_globals = OMEGA_H_LAMBDA(LO e) {
+      elem_globals_w[e] = cell_globals[e / per_cell] * per_cell + e % per_cell;
+    };
+    parallel_for(nelems, fill_elem_globals, "build_box_distributed(globals)");
+    elem_globals = elem_globals_w;
+  }
+  auto mesh = Mesh(comm->library());
+  mesh.set_comm(comm);
+  mesh.set_parting(OMEGA_H_ELEM_BASED);
+  mesh.set_family(family);
+  mesh.set_dim(dim);
+  mesh.set_verts(nverts);
+  mesh.add_tag(VERT, "global", 1, vert_globals);
+  if (comm->size() > 1) {
+    mesh.set_owners(VERT, Remotes(Read<I32>(own_ranks_w), LOs(own_idxs_w)));
+  }
+  build_ents_from_elems2verts(&mesh, ev2v, vert_globals, elem_globals);
+  mesh.add_coords(Reals(coords_w));
+  classify_box(&mesh, x, y, z, nx, ny, nz);
+  mesh.class_sets = get_box_class_sets(dim);
+  return mesh;
+}
+
 /* When we try to build a mesh from _partitioned_
    element-to-vertex connectivity only, we have to derive
    consistent edges and faces in parallel.
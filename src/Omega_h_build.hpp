@@ -23,6 +23,21 @@ void build_from_elems_and_coords(
     Mesh* mesh, Omega_h_Family family, Int edim, LOs ev2v, Reals coords);
 Mesh build_box(CommPtr comm, Omega_h_Family family, Real x, Real y, Real z,
     LO nx, LO ny, LO nz, bool symmetric = false);
+/* builds the same box as build_box() (2D if nz is zero) already
+   partitioned: the box is cut into one block of cells per rank and each
+   rank generates only its own block. vertex and element global numbers
+   and vertex owners are computed directly from the block layout, so no
+   rank ever holds the whole box. owners of edges and faces are resolved
+   by resolve_derived_copies(). with (hilbert_order), the elements of
+   each rank are ordered along a Hilbert curve through their block.
+   the symmetric splitting of build_box() is not supported.
+   the blocks form a grid, so the number of ranks must be the product
+   of block counts along each axis, none of them more than the cells
+   along that axis (a prime number of ranks larger than every cell count
+   can't be used). can_build_box_distributed() tells whether it is */
+Mesh build_box_distributed(CommPtr comm, Omega_h_Family family, Real x,
+    Real y, Real z, LO nx, LO ny, LO nz, bool hilbert_order = true);
+bool can_build_box_distributed(I32 nranks, LO nx, LO ny, LO nz);
 void build_box_internal(Mesh* mesh, Omega_h_Family family, Real x, Real y,
     Real z, LO nx, LO ny, LO nz, bool symmetric = false);
 
@@ -3,6 +3,7 @@
 #include <iostream>
 
 #include <cstdlib>
+#include "Omega_h_arena.hpp"
 #include "Omega_h_array_ops.hpp"
 #include "Omega_h_collapse.hpp"
 #include "Omega_h_for.hpp"
@@ -196,7 +197,8 @@ static bool coarsen_ents(Mesh* mesh, AdaptOpts const& opts, Int ent_dim,
 }
 
 bool coarsen_by_size(Mesh* mesh, AdaptOpts const& opts) {
-  OMEGA_H_TIME_FUNCTION;
+  OMEGA_H_TIME_PHASE;
+  ScopedArena arena;
   auto comm = mesh->comm();
   auto lengths = mesh->ask_lengths();
   auto edge_is_cand = each_lt(lengths, opts.min_length_desired);
@@ -208,7 +210,8 @@ bool coarsen_by_size(Mesh* mesh, AdaptOpts const& opts) {
 }
 
 bool coarsen_slivers(Mesh* mesh, AdaptOpts const& opts) {
-  OMEGA_H_TIME_FUNCTION;
+  OMEGA_H_TIME_PHASE;
+  ScopedArena arena;
   mesh->set_parting(OMEGA_H_GHOSTED);
   auto comm = mesh->comm();
   auto elems_are_cands =
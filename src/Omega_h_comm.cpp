@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <string>
+#include <vector>
 
 #include "Omega_h_array_ops.hpp"
 #include "Omega_h_int_scan.hpp"
@@ -50,10 +51,10 @@ Comm::Comm(Library* library_in, bool is_graph, bool sends_to_self)
     : library_(library_in) {
   if (is_graph) {
     if (sends_to_self) {
-      srcs_ = Read<LO>({0});
+      srcs_ = Read<I32>({0});
       self_src_ = self_dst_ = 0;
     } else {
-      srcs_ = Read<LO>({});
+      srcs_ = Read<I32>({});
       self_src_ = self_dst_ = -1;
     }
     dsts_ = srcs_;
@@ -164,16 +165,65 @@ static std::vector<int> sources_from_destinations(
 }
 #endif
 
+#ifdef OMEGA_H_USE_MPI
+/* the number of graph communicators each communicator keeps around.
+   it has to fit in the bits of an int, see Comm::graph() */
+constexpr std::size_t graph_cache_capacity = 16;
+
+static bool same_ranks(HostRead<I32> a, HostRead<I32> b) {
+  if (a.size() != b.size()) return false;
+  for (LO i = 0; i < a.size(); ++i) {
+    if (a[i] != b[i]) return false;
+  }
+  return true;
+}
+#endif
+
+/* most communication patterns are built many times over, for example
+   by every migration and ghosting of a mesh that didn't change much,
+   so recently created graph communicators are kept and reused.
+   the sources of a rank depend on the destinations of all ranks, so
+   a cached communicator can only be reused if every rank asks for
+   exactly the destinations it was created with.
+   the cache is modified by all ranks in the same way, so its entries
+   line up across ranks and one bitwise AND over the entries each rank
+   could reuse finds those that all of them can. that reduction is much
+   cheaper than the consensus and MPI_Comm_dup() of a new communicator.
+   messages of different users of one communicator can't be confused,
+   since all ranks post them in the same order. */
 CommPtr Comm::graph(Read<I32> dsts) const {
 #ifdef OMEGA_H_USE_MPI
   HostRead<I32> h_destinations(dsts);
+  static_assert(graph_cache_capacity <= sizeof(int) * 8,
+      "graph cache entries must fit in an int bitmask");
+  int reusable = 0;
+  for (std::size_t i = 0; i < graph_cache_.size(); ++i) {
+    if (same_ranks(graph_cache_[i]->host_dsts_, h_destinations)) {
+      reusable |= (1 << i);
+    }
+  }
+  CALL(MPI_Allreduce(MPI_IN_PLACE, &reusable, 1, MPI_INT, MPI_BAND, impl_));
+  for (auto i = int(graph_cache_.size()) - 1; i >= 0; --i) {
+    if (!(reusable & (1 << i))) continue;
+    auto const it = graph_cache_.begin() + i;
+    auto const cached = *it;
+    graph_cache_.erase(it);
+    graph_cache_.push_back(cached);
+    return cached;
+  }
   auto v_sources = sources_from_destinations(impl_, h_destinations);
   HostWrite<I32> h_sources(int(v_sources.size()));
   for (int i = 0; i < h_sources.size(); ++i)
     h_sources[i] = v_sources[std::size_t(i)];
   MPI_Comm impl2;
   CALL(MPI_Comm_dup(impl_, &impl2));
-  return CommPtr(new Comm(library_, impl2, h_sources.write(), dsts));
+  auto const created =
+      CommPtr(new Comm(library_, impl2, h_sources.write(), dsts));
+  if (graph_cache_.size() == graph_cache_capacity) {
+    graph_cache_.erase(graph_cache_.begin());
+  }
+  graph_cache_.push_back(created);
+  return created;
 #else
   return CommPtr(new Comm(library_, true, dsts.size() == 1));
 #endif
@@ -191,7 +241,13 @@ CommPtr Comm::graph_adjacent(Read<I32> srcs, Read<I32> dsts) const {
 }
 
 CommPtr Comm::graph_inverse() const {
+#ifdef OMEGA_H_USE_MPI
+  /* graph communicators are reused, and so are their inverses */
+  if (!inverse_) inverse_ = graph_adjacent(destinations(), sources());
+  return inverse_;
+#else
   return graph_adjacent(destinations(), sources());
+#endif
 }
 
 Read<I32> Comm::sources() const { return srcs_; }
@@ -383,6 +439,28 @@ Read<T> Comm::allgather(T x) const {
 #endif
 }
 
+template <typename T>
+Read<T> Comm::allgatherv(Read<T> x) const {
+#ifdef OMEGA_H_USE_MPI
+  int const count = x.size();
+  std::vector<int> counts(static_cast<std::size_t>(size()));
+  CALL(MPI_Allgather(
+      &count, 1, MPI_INT, counts.data(), 1, MPI_INT, impl_));
+  std::vector<int> displs(counts.size() + 1, 0);
+  for (std::size_t i = 0; i < counts.size(); ++i) {
+    displs[i + 1] = displs[i] + counts[i];
+  }
+  HostRead<T> sendbuf(x);
+  HostWrite<T> recvbuf(displs.back());
+  CALL(MPI_Allgatherv(nonnull(sendbuf.data()), count,
+      MpiTraits<T>::datatype(), nonnull(recvbuf.data()), counts.data(),
+      displs.data(), MpiTraits<T>::datatype(), impl_));
+  return recvbuf.write();
+#else
+  return x;
+#endif
+}
+
 template <typename T>
 Read<T> Comm::alltoall(Read<T> x) const {
 #ifdef OMEGA_H_USE_MPI
@@ -579,6 +657,7 @@ void Comm::barrier() const {
   template T Comm::exscan(T x, Omega_h_Op op) const;                           \
   template void Comm::bcast(T& x, int root_rank) const;                        \
   template Read<T> Comm::allgather(T x) const;                                 \
+  template Read<T> Comm::allgatherv(Read<T> x) const;                          \
   template Read<T> Comm::alltoall(Read<T> x) const;                            \
   template Read<T> Comm::alltoallv(                                            \
       Read<T> sendbuf, Read<LO> sdispls, Read<LO> rdispls, Int width) const;   \
@@ -2,6 +2,7 @@
 #define OMEGA_H_COMM_HPP
 
 #include <memory>
+#include <vector>
 
 #include <Omega_h_mpi.h>
 #include <Omega_h_array.hpp>
@@ -36,6 +37,14 @@ class Comm {
   HostRead<I32> host_dsts_;
   LO self_src_;
   LO self_dst_;
+#ifdef OMEGA_H_USE_MPI
+  /* graph communicators recently created by graph(),
+     least recently used first. see Comm::graph() */
+  mutable std::vector<CommPtr> graph_cache_;
+  /* this graph communicator with its edges reversed,
+     once graph_inverse() has been called */
+  mutable CommPtr inverse_;
+#endif
 
  public:
   Comm();
@@ -73,6 +82,10 @@ class Comm {
   void bcast_string(std::string& s, int root_rank=0) const;
   template <typename T>
   Read<T> allgather(T x) const;
+  /* the arrays of all ranks concatenated in rank order.
+     unlike the other collectives here, this one needs no graph */
+  template <typename T>
+  Read<T> allgatherv(Read<T> x) const;
   template <typename T>
   Read<T> alltoall(Read<T> x) const;
   template <typename T>
@@ -218,6 +231,7 @@ void Comm::recv(int rank, T& x) {
   extern template T Comm::exscan(T x, Omega_h_Op op) const;                    \
   extern template void Comm::bcast(T& x, int root_rank) const;                 \
   extern template Read<T> Comm::allgather(T x) const;                          \
+  extern template Read<T> Comm::allgatherv(Read<T> x) const;                   \
   extern template Read<T> Comm::alltoall(Read<T> x) const;                     \
   extern template Read<T> Comm::alltoallv(                                     \
       Read<T> sendbuf, Read<LO> sdispls, Read<LO> rdispls, Int width) const;   \
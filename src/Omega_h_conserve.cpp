@@ -63,7 +63,7 @@ struct SeparationResult {
    need the outer loop to be over one color, we just need the
    sub-cavities to be single-color as they're processed */
 SeparationResult separate_by_color_once(
-    Cavs cavs, LOs old_elem_colors, LOs new_elem_colors) {
+    Cavs cavs, Read<ClassId> old_elem_colors, Read<ClassId> new_elem_colors) {
   auto keys2old = cavs.keys2old_elems;
   auto keys2new = cavs.keys2new_elems;
   auto nkeys = cavs.size();
@@ -109,7 +109,7 @@ using CavsByColorMethod = std::array<CavsByColor, 3>;
 using CavsByBdryStatus = std::array<CavsByColorMethod, 3>;
 
 static CavsByColor separate_by_color(
-    Cavs cavs, LOs old_elem_colors, LOs new_elem_colors) {
+    Cavs cavs, Read<ClassId> old_elem_colors, Read<ClassId> new_elem_colors) {
   CavsByColor cavs_by_color;
   while (cavs.keys2old_elems.nedges() || cavs.keys2new_elems.nedges()) {
     auto res = separate_by_color_once(cavs, old_elem_colors, new_elem_colors);
@@ -119,11 +119,11 @@ static CavsByColor separate_by_color(
   return cavs_by_color;
 }
 
-static LOs get_elem_class_ids(Mesh* mesh) {
+static Read<ClassId> get_elem_class_ids(Mesh* mesh) {
   if (mesh->has_tag(mesh->dim(), "class_id")) {
     return mesh->get_array<ClassId>(mesh->dim(), "class_id");
   } else {
-    return LOs(mesh->nelems(), 1);
+    return Read<ClassId>(mesh->nelems(), 1);
   }
 }
 
@@ -147,7 +147,7 @@ static CavsByBdryStatus separate_cavities(Mesh* old_mesh, Mesh* new_mesh,
   auto old_elems_are_bdry = array_cast<LO>(old_elems_are_bdry_i8);
   auto cavs2nbdry_elems =
       graph_reduce(cavs.keys2old_elems, old_elems_are_bdry, 1, OMEGA_H_SUM);
-  auto cavs_are_bdry = each_gt(cavs2nbdry_elems, 0);
+  auto cavs_are_bdry = each_gt(cavs2nbdry_elems, LO(0));
   auto cavs_arent_bdry = invert_marks(cavs_are_bdry);
   auto int_cavs2cavs = collect_marked(cavs_arent_bdry);
   out[NOT_BDRY][NO_COLOR].push_back(unmap_cavs(int_cavs2cavs, cavs));
@@ -168,9 +168,9 @@ static CavsByBdryStatus separate_cavities(Mesh* old_mesh, Mesh* new_mesh,
   out[KEY_BDRY][CLASS_COLOR] = separate_by_color(
       out[KEY_BDRY][NO_COLOR][0], old_elem_class_ids, new_elem_class_ids);
   out[NOT_BDRY][CLASS_BDRY_COLOR].push_back(out[NOT_BDRY][NO_COLOR][0]);
-  auto old_bdry_colors = old_elems_are_bdry;
+  auto old_bdry_colors = array_cast<ClassId>(old_elems_are_bdry_i8);
   auto new_elems_are_bdry = get_elems_are_bdry(new_mesh);
-  auto new_bdry_colors = array_cast<LO>(new_elems_are_bdry);
+  auto new_bdry_colors = array_cast<ClassId>(new_elems_are_bdry);
   out[TOUCH_BDRY][CLASS_BDRY_COLOR] = separate_by_color(
       out[TOUCH_BDRY][NO_COLOR][0], old_bdry_colors, new_bdry_colors);
   out[KEY_BDRY][CLASS_BDRY_COLOR] = separate_by_color(
@@ -76,7 +76,11 @@ typedef std::int32_t I32;
 typedef std::int64_t I64;
 typedef I8 Byte;
 typedef I32 Int;
+#ifdef OMEGA_H_LO_64
+typedef I64 LO;
+#else
 typedef I32 LO;
+#endif
 typedef I32 ClassId;
 typedef I64 GO;
 typedef double Real;
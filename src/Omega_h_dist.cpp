@@ -132,9 +132,12 @@ Future<T> Dist::iexch(Read<T> data, Int width) const {
     data = permute(data, items2content_[F], width);
   }
   auto future = comm_[F]->ialltoallv(data, msgs2content_[F], msgs2content_[R], width);
-  auto callback = [this,width](Read<T> buf) {
-    if (this->items2content_[R].exists()) {
-      buf = unmap(this->items2content_[R], buf, width);
+  /* capture by value: the Dist may be gone by the time
+     the future is waited on */
+  auto rcontent2ritems = items2content_[R];
+  auto callback = [rcontent2ritems, width](Read<T> buf) {
+    if (rcontent2ritems.exists()) {
+      buf = unmap(rcontent2ritems, buf, width);
     }
     return buf;
   };
@@ -167,7 +170,7 @@ LOs Dist::roots2items() const { return roots2items_[F]; }
 Read<I32> Dist::msgs2ranks() const { return comm_[F]->destinations(); }
 
 Read<I32> Dist::items2ranks() const {
-  return compound_maps(items2msgs(), msgs2ranks());
+  return unmap(items2msgs(), msgs2ranks(), 1);
 }
 
 LOs Dist::items2dest_idxs() const {
@@ -11,6 +11,7 @@
 
 #include <algorithm>
 #include <iostream>
+#include <map>
 #include <set>
 #include <sstream>
 
@@ -453,8 +454,8 @@ Mesh read_sliced(filesystem::path const& path, CommPtr comm, bool verbose, int,
     oss << "P" << comm->rank() << ": init params for " << path << ":\n";
     oss << " ExodusII " << version << '\n';
     oss << " Exodus ID " << file << '\n';
-    oss << " comp_ws " << comp_ws << '\n';
-    oss << " io_ws " << io_ws << '\n';
+    oss << " comp_ws " << sizeof(Real) << '\n';
+    oss << " io_ws " << sizeof(Real) << '\n';
     oss << " Title " << init_params.title << '\n';
     oss << " num_dim " << init_params.num_dim << '\n';
     oss << " num_nodes " << init_params.num_nodes << '\n';
@@ -585,29 +586,71 @@ Mesh read_sliced(filesystem::path const&, CommPtr, bool, int, int) {
 }
 #endif
 
-void write(
-    filesystem::path const& path, Mesh* mesh, bool verbose, int classify_with) {
-  begin_code("exodus::write");
+/* real values are stored in the file as they are in memory */
+static int create(filesystem::path const& path) {
   auto comp_ws = int(sizeof(Real));
   auto io_ws = comp_ws;
   auto mode = EX_CLOBBER | EX_MAPS_INT64_API;
   auto file = ex_create(path.c_str(), mode, &comp_ws, &io_ws);
   if (file < 0) Omega_h_fail("can't create Exodus file %s\n", path.c_str());
+  return file;
+}
+
+namespace {
+struct ElemBlock {
+  ClassId id;
+  /* indices into the elements written to the file */
+  LOs file_elems;
+};
+
+/* what write_mesh() put in a file */
+struct FileMesh {
+  /* the vertices of the file elements, in the order of the file */
+  LOs file_verts2verts;
+  /* the position of each element in the file, or -1 */
+  LOs elems2file_elems;
+  /* the element blocks in the order they are in the file */
+  std::vector<ElemBlock> blocks;
+  /* the vertices and sides of each node and side set */
+  std::map<ClassId, LOs> node_sets;
+  std::map<ClassId, LOs> side_sets;
+};
+}  // namespace
+
+/* writes the mesh made of the elements (file_elems2elems), which
+   must be in ascending order, and of their vertices. the global
+   numbers of both go in the node and element id maps */
+static FileMesh write_mesh(int file, filesystem::path const& path,
+    Mesh* mesh, LOs file_elems2elems, bool verbose, int classify_with) {
   auto title = "Omega_h " OMEGA_H_SEMVER " Exodus Output";
   std::set<LO> region_set;
   auto dim = mesh->dim();
-  auto elem_class_ids = mesh->get_array<ClassId>(dim, "class_id");
+  auto nfile_elems = file_elems2elems.size();
+  FileMesh file_mesh;
+  auto elem_class_ids = read(
+      unmap(file_elems2elems, mesh->get_array<ClassId>(dim, "class_id"), 1));
   auto h_elem_class_ids = HostRead<LO>(elem_class_ids);
   for (LO i = 0; i < h_elem_class_ids.size(); ++i) {
     region_set.insert(h_elem_class_ids[i]);
   }
+  auto elems_written =
+      map_onto(Read<I8>(nfile_elems, I8(1)), file_elems2elems, mesh->nelems(),
+          I8(0), 1);
+  auto sides_written = mark_down(mesh, dim, dim - 1, elems_written);
+  auto verts_written = mark_down(mesh, dim, VERT, elems_written);
+  auto file_verts2verts = collect_marked(verts_written);
+  auto verts2file_verts =
+      invert_injective_map(file_verts2verts, mesh->nverts());
+  auto nfile_verts = file_verts2verts.size();
+  file_mesh.file_verts2verts = file_verts2verts;
   auto side_class_ids = mesh->get_array<ClassId>(dim - 1, "class_id");
   auto side_class_dims = mesh->get_array<I8>(dim - 1, "class_dim");
   auto h_side_class_ids = HostRead<LO>(side_class_ids);
   auto h_side_class_dims = HostRead<I8>(side_class_dims);
   std::set<LO> surface_set;
+  auto h_sides_written = HostRead<I8>(sides_written);
   for (LO i = 0; i < h_side_class_ids.size(); ++i) {
-    if (h_side_class_dims[i] == I8(dim - 1) &&
+    if (h_sides_written[i] && h_side_class_dims[i] == I8(dim - 1) &&
         h_side_class_ids[i] > 0) {
       surface_set.insert(h_side_class_ids[i]);
     }
@@ -621,38 +664,43 @@ void write(
     std::ostringstream oss;
     oss << "P" << mesh->comm()->rank() << ": init params for " << path << ":\n";
     oss << " Exodus ID " << file << '\n';
-    oss << " comp_ws " << comp_ws << '\n';
-    oss << " io_ws " << io_ws << '\n';
+    oss << " comp_ws " << sizeof(Real) << '\n';
+    oss << " io_ws " << sizeof(Real) << '\n';
     oss << " Title " << title << '\n';
     oss << " num_dim " << dim << '\n';
-    oss << " num_nodes " << mesh->nverts() << '\n';
-    oss << " num_elem " << mesh->nelems() << '\n';
+    oss << " num_nodes " << nfile_verts << '\n';
+    oss << " num_elem " << nfile_elems << '\n';
     oss << " num_elem_blk " << nelem_blocks << '\n';
     oss << " num_node_sets " << nnode_sets << '\n';
     oss << " num_side_sets " << nside_sets;
     std::cout << oss.str() << std::endl;
   }
-  CALL(ex_put_init(file, title, dim, mesh->nverts(), mesh->nelems(),
-      nelem_blocks, nnode_sets, nside_sets));
+  CALL(ex_put_init(file, title, dim, nfile_verts, nfile_elems, nelem_blocks,
+      nnode_sets, nside_sets));
   Few<Write<Real>, 3> coord_blk;
-  for (Int i = 0; i < dim; ++i) coord_blk[i] = Write<Real>(mesh->nverts());
+  for (Int i = 0; i < dim; ++i) coord_blk[i] = Write<Real>(nfile_verts);
   auto coords = mesh->coords();
   auto f0 = OMEGA_H_LAMBDA(LO i) {
-    for (Int j = 0; j < dim; ++j) coord_blk[j][i] = coords[i * dim + j];
+    auto vert = file_verts2verts[i];
+    for (Int j = 0; j < dim; ++j) coord_blk[j][i] = coords[vert * dim + j];
   };
-  parallel_for(mesh->nverts(), f0, "copy_coords");
+  parallel_for(nfile_verts, f0, "copy_coords");
   HostRead<Real> h_coord_blk[3];
   for (Int i = 0; i < dim; ++i) h_coord_blk[i] = HostRead<Real>(coord_blk[i]);
   CALL(ex_put_coord(file, h_coord_blk[0].data(), h_coord_blk[1].data(),
       h_coord_blk[2].data()));
   auto all_conn = mesh->ask_elem_verts();
-  auto elems2file_idx = Write<LO>(mesh->nelems());
+  auto elems2file_idx = Write<LO>(mesh->nelems(), -1);
   auto elem_file_offset = LO(0);
+  std::vector<ElemBlock> blocks;
   for (auto block_id : region_set) {
     auto type_name = (dim == 3) ? "tetra4" : "tri3";
     auto elems_in_block = each_eq_to(elem_class_ids, block_id);
-    auto block_elems2elem = collect_marked(elems_in_block);
+    auto block_elems2file_elem = collect_marked(elems_in_block);
+    auto block_elems2elem =
+        read(unmap(block_elems2file_elem, file_elems2elems, 1));
     auto nblock_elems = block_elems2elem.size();
+    blocks.push_back({block_id, block_elems2file_elem});
     if (verbose) {
       std::cout << "P" << mesh->comm()->rank() <<  ": element block " << block_id << " has " << nblock_elems
                 << " of type " << type_name << '\n';
@@ -663,7 +711,8 @@ void write(
     std::string block_name = "block_" + std::to_string(block_id);
     CALL(ex_put_name(file, EX_ELEM_BLOCK, block_id, block_name.c_str()));
     auto block_conn = read(unmap(block_elems2elem, all_conn, deg));
-    auto block_conn_ex = add_to_each(block_conn, 1);
+    auto block_conn_ex =
+        add_to_each(read(unmap(block_conn, verts2file_verts, 1)), 1);
     auto h_block_conn = HostRead<LO>(block_conn_ex);
     CALL(ex_put_conn(
         file, EX_ELEM_BLOCK, block_id, h_block_conn.data(), nullptr, nullptr));
@@ -674,10 +723,31 @@ void write(
     parallel_for(nblock_elems, f);
     elem_file_offset += nblock_elems;
   }
+  file_mesh.elems2file_elems = elems2file_idx;
+  /* Exodus numbers from one */
+  auto const vert_globals = mesh->globals(VERT);
+  Write<GO> file_vert_ids(nfile_verts);
+  auto f2 = OMEGA_H_LAMBDA(LO i) {
+    file_vert_ids[i] = vert_globals[file_verts2verts[i]] + 1;
+  };
+  parallel_for(nfile_verts, f2, "file_vert_ids");
+  auto const elem_globals = mesh->globals(dim);
+  Write<GO> file_elem_ids(nfile_elems);
+  auto f3 = OMEGA_H_LAMBDA(LO elem) {
+    auto file_elem = elems2file_idx[elem];
+    if (file_elem != -1) file_elem_ids[file_elem] = elem_globals[elem] + 1;
+  };
+  parallel_for(mesh->nelems(), f3, "file_elem_ids");
+  auto h_file_vert_ids = HostRead<GO>(file_vert_ids);
+  auto h_file_elem_ids = HostRead<GO>(file_elem_ids);
+  CALL(ex_put_id_map(file, EX_NODE_MAP, h_file_vert_ids.data()));
+  CALL(ex_put_id_map(file, EX_ELEM_MAP, h_file_elem_ids.data()));
   if (classify_with) {
     for (auto set_id : surface_set) {
-      auto sides_in_set = land_each(each_eq_to(side_class_ids, set_id),
-          each_eq_to(side_class_dims, I8(dim - 1)));
+      auto sides_in_set =
+          land_each(land_each(each_eq_to(side_class_ids, set_id),
+                        each_eq_to(side_class_dims, I8(dim - 1))),
+              sides_written);
       if (classify_with & exodus::SIDE_SETS) {
         auto set_sides2side = collect_marked(sides_in_set);
         auto nset_sides = set_sides2side.size();
@@ -690,17 +760,23 @@ void write(
         Write<int> set_sides2local(nset_sides);
         auto f1 = OMEGA_H_LAMBDA(LO set_side) {
           auto side = set_sides2side[set_side];
-          auto side_elem = sides2elems.a2ab[side];
-          auto elem = sides2elems.ab2b[side_elem];
-          auto elem_in_file = elems2file_idx[elem];
-          auto code = sides2elems.codes[side_elem];
-          auto which_down = code_which_down(code);
-          set_sides2elem[set_side] = elem_in_file + 1;
-          set_sides2local[set_side] = side_osh2exo(dim, which_down);
+          /* the first adjacent element that is in the file */
+          for (auto side_elem = sides2elems.a2ab[side];
+               side_elem < sides2elems.a2ab[side + 1]; ++side_elem) {
+            auto elem = sides2elems.ab2b[side_elem];
+            auto elem_in_file = elems2file_idx[elem];
+            if (elem_in_file == -1) continue;
+            auto code = sides2elems.codes[side_elem];
+            auto which_down = code_which_down(code);
+            set_sides2elem[set_side] = elem_in_file + 1;
+            set_sides2local[set_side] = side_osh2exo(dim, which_down);
+            break;
+          }
         };
         parallel_for(nset_sides, f1, "set_sides2elem");
         auto h_set_sides2elem = HostRead<int>(set_sides2elem);
         auto h_set_sides2local = HostRead<int>(set_sides2local);
+        file_mesh.side_sets[set_id] = set_sides2side;
         CALL(ex_put_set_param(file, EX_SIDE_SET, set_id, nset_sides, 0));
         CALL(ex_put_set(file, EX_SIDE_SET, set_id, h_set_sides2elem.data(),
             h_set_sides2local.data()));
@@ -708,7 +784,9 @@ void write(
       if (classify_with & exodus::NODE_SETS) {
         auto nodes_in_set = mark_down(mesh, dim - 1, VERT, sides_in_set);
         auto set_nodes2node = collect_marked(nodes_in_set);
-        auto set_nodes2node_ex = add_to_each(set_nodes2node, 1);
+        file_mesh.node_sets[set_id] = set_nodes2node;
+        auto set_nodes2node_ex =
+            add_to_each(read(unmap(set_nodes2node, verts2file_verts, 1)), 1);
         auto nset_nodes = set_nodes2node.size();
         if (verbose) {
           std::cout << "P" << mesh->comm()->rank() << ": node set " << set_id << " has " << nset_nodes
@@ -758,10 +836,549 @@ void write(
       CALL(ex_put_names(file, EX_SIDE_SET, set_name_ptrs.data()));
     }
   }
+  file_mesh.blocks = blocks;
+  return file_mesh;
+}
+
+void write(
+    filesystem::path const& path, Mesh* mesh, bool verbose, int classify_with) {
+  begin_code("exodus::write");
+  auto file = create(path);
+  write_mesh(
+      file, path, mesh, LOs(mesh->nelems(), 0, 1), verbose, classify_with);
+  CALL(ex_close(file));
+  end_code();
+}
+
+static std::vector<std::string> component_names(
+    std::string const& name, Int ncomps, Int dim) {
+  std::vector<std::string> names;
+  for (Int comp = 0; comp < ncomps; ++comp) {
+    if (ncomps == 1) {
+      names.push_back(name);
+    } else if (ncomps == dim) {
+      /* readers assemble these into vectors */
+      names.push_back(name + "_" + "xyz"[comp]);
+    } else {
+      names.push_back(name + "_" + std::to_string(comp + 1));
+    }
+  }
+  return names;
+}
+
+static void put_variable_names(
+    int file, ex_entity_type type, std::vector<std::string> const& names) {
+  auto nvars = int(names.size());
+  if (nvars == 0) return;
+  std::vector<char*> name_ptrs;
+  for (auto& name : names) name_ptrs.push_back(const_cast<char*>(name.c_str()));
+  CALL(ex_put_variable_param(file, type, nvars));
+  CALL(ex_put_variable_names(file, type, nvars, name_ptrs.data()));
+}
+
+template <typename T>
+static Read<T> to_device(std::vector<T> const& v) {
+  HostWrite<T> h_v(LO(v.size()));
+  for (LO i = 0; i < h_v.size(); ++i) h_v[i] = v[std::size_t(i)];
+  return h_v.write();
+}
+
+/* for each other rank, the entities of (ent_dim) in this rank's file
+   that are also in the file of that rank, in ascending order */
+static std::map<I32, std::vector<LO>> get_file_sharers(
+    Mesh* mesh, Int ent_dim, Read<I8> ents_in_file) {
+  std::map<I32, std::vector<LO>> sharers;
+  if (!mesh->could_be_shared(ent_dim)) return sharers;
+  auto const copies2owners = mesh->ask_dist(ent_dim);
+  auto const owners2copies = copies2owners.invert();
+  auto const h_in_file = HostRead<I8>(copies2owners.exch(ents_in_file, 1));
+  auto const h_owners2copies = HostRead<LO>(owners2copies.roots2items());
+  auto const h_copies2ranks = HostRead<I32>(owners2copies.items2ranks());
+  auto const h_copies2idxs = HostRead<LO>(owners2copies.items2dest_idxs());
+  /* each owner sends every copy in a file the ranks of the others */
+  std::vector<I32> dest_ranks;
+  std::vector<LO> dest_idxs;
+  std::vector<I32> other_ranks;
+  for (LO owner = 0; owner + 1 < h_owners2copies.size(); ++owner) {
+    auto const begin = h_owners2copies[owner];
+    auto const end = h_owners2copies[owner + 1];
+    for (auto copy = begin; copy < end; ++copy) {
+      if (!h_in_file[copy]) continue;
+      for (auto other = begin; other < end; ++other) {
+        if (other == copy || !h_in_file[other]) continue;
+        dest_ranks.push_back(h_copies2ranks[copy]);
+        dest_idxs.push_back(h_copies2idxs[copy]);
+        other_ranks.push_back(h_copies2ranks[other]);
+      }
+    }
+  }
+  Dist owners2sharers;
+  owners2sharers.set_parent_comm(mesh->comm());
+  owners2sharers.set_dest_ranks(to_device(dest_ranks));
+  owners2sharers.set_dest_idxs(to_device(dest_idxs), mesh->nents(ent_dim));
+  auto const h_ranks =
+      HostRead<I32>(owners2sharers.exch(to_device(other_ranks), 1));
+  auto const h_ents2ranks =
+      HostRead<LO>(owners2sharers.invert().roots2items());
+  for (LO ent = 0; ent + 1 < h_ents2ranks.size(); ++ent) {
+    for (auto i = h_ents2ranks[ent]; i < h_ents2ranks[ent + 1]; ++i) {
+      sharers[h_ranks[i]].push_back(ent);
+    }
+  }
+  return sharers;
+}
+
+/* an entity in several files counts in the one of the lowest rank */
+static LO count_once(LOs set_ents,
+    std::map<I32, std::vector<LO>> const& sharers, I32 rank) {
+  auto const h_set_ents = HostRead<LO>(set_ents);
+  std::set<LO> elsewhere;
+  for (auto& pair : sharers) {
+    if (pair.first > rank) break;
+    elsewhere.insert(pair.second.begin(), pair.second.end());
+  }
+  LO n = 0;
+  for (LO i = 0; i < h_set_ents.size(); ++i) {
+    if (!elsewhere.count(h_set_ents[i])) ++n;
+  }
+  return n;
+}
+
+/* the union over all ranks of a small set of ids, such as those of
+   the element blocks */
+static std::set<ClassId> get_global_ids(
+    CommPtr comm, std::set<ClassId> const& ids) {
+  HostWrite<ClassId> h_local(LO(ids.size()));
+  LO i = 0;
+  for (auto id : ids) h_local[i++] = id;
+  auto const h_all =
+      HostRead<ClassId>(comm->allgatherv(Read<ClassId>(h_local.write())));
+  std::set<ClassId> global;
+  for (LO j = 0; j < h_all.size(); ++j) global.insert(h_all[j]);
+  return global;
+}
+
+/* the Nemesis load balance data of the file of this rank, which SEACAS
+   epu needs to join the files of all ranks. vertices and sides in the
+   files of other ranks too are on the border, and elements with a
+   vertex there are as well. nothing is external, since each file
+   holds every vertex of its elements */
+static void write_loadbal(
+    int file, Mesh* mesh, FileMesh const& file_mesh, bool verbose) {
+  auto const comm = mesh->comm();
+  auto const rank = comm->rank();
+  auto const dim = mesh->dim();
+  auto const file_verts2verts = file_mesh.file_verts2verts;
+  auto const elems2file_elems = file_mesh.elems2file_elems;
+  auto const nfile_verts = file_verts2verts.size();
+  auto const verts_in_file =
+      map_onto(Read<I8>(nfile_verts, I8(1)), file_verts2verts, mesh->nverts(),
+          I8(0), 1);
+  auto const elems_in_file = each_geq_to(elems2file_elems, LO(0));
+  auto const sides_in_file = mark_down(mesh, dim, dim - 1, elems_in_file);
+  auto const vert_sharers = get_file_sharers(mesh, VERT, verts_in_file);
+  auto const side_sharers = get_file_sharers(mesh, dim - 1, sides_in_file);
+  auto const h_verts2file_verts = HostRead<LO>(
+      invert_injective_map(file_verts2verts, mesh->nverts()));
+  auto const h_elems2file_elems = HostRead<LO>(elems2file_elems);
+  /* global parameters */
+  std::set<ClassId> block_ids;
+  for (auto& block : file_mesh.blocks) block_ids.insert(block.id);
+  std::set<ClassId> node_set_ids;
+  for (auto& pair : file_mesh.node_sets) node_set_ids.insert(pair.first);
+  std::set<ClassId> side_set_ids;
+  for (auto& pair : file_mesh.side_sets) side_set_ids.insert(pair.first);
+  auto const global_block_ids = get_global_ids(comm, block_ids);
+  auto const global_node_set_ids = get_global_ids(comm, node_set_ids);
+  auto const global_side_set_ids = get_global_ids(comm, side_set_ids);
+  CALL(ex_put_init_info(file, comm->size(), 1, const_cast<char*>("p")));
+  CALL(ex_put_init_global(file, mesh->nglobal_ents(VERT),
+      mesh->nglobal_ents(dim), int64_t(global_block_ids.size()),
+      int64_t(global_node_set_ids.size()),
+      int64_t(global_side_set_ids.size())));
+  std::vector<int> ids;
+  std::vector<int> counts;
+  for (auto id : global_block_ids) {
+    LO nblock_elems = 0;
+    for (auto& block : file_mesh.blocks) {
+      if (block.id == id) nblock_elems = block.file_elems.size();
+    }
+    ids.push_back(int(id));
+    counts.push_back(int(comm->allreduce(GO(nblock_elems), OMEGA_H_SUM)));
+  }
+  if (!ids.empty()) {
+    CALL(ex_put_eb_info_global(file, ids.data(), counts.data()));
+  }
+  ids.clear();
+  counts.clear();
+  for (auto id : global_node_set_ids) {
+    auto it = file_mesh.node_sets.find(id);
+    auto const n = (it == file_mesh.node_sets.end())
+                       ? LO(0)
+                       : count_once(it->second, vert_sharers, rank);
+    ids.push_back(int(id));
+    counts.push_back(int(comm->allreduce(GO(n), OMEGA_H_SUM)));
+  }
+  if (!ids.empty()) {
+    std::vector<int> df_counts(ids.size(), 0);
+    CALL(ex_put_ns_param_global(
+        file, ids.data(), counts.data(), df_counts.data()));
+  }
+  ids.clear();
+  counts.clear();
+  for (auto id : global_side_set_ids) {
+    auto it = file_mesh.side_sets.find(id);
+    auto const n = (it == file_mesh.side_sets.end())
+                       ? LO(0)
+                       : count_once(it->second, side_sharers, rank);
+    ids.push_back(int(id));
+    counts.push_back(int(comm->allreduce(GO(n), OMEGA_H_SUM)));
+  }
+  if (!ids.empty()) {
+    std::vector<int> df_counts(ids.size(), 0);
+    CALL(ex_put_ss_param_global(
+        file, ids.data(), counts.data(), df_counts.data()));
+  }
+  /* internal and border vertices and elements */
+  std::vector<I8> file_verts_on_border(std::size_t(nfile_verts), 0);
+  for (auto& pair : vert_sharers) {
+    for (auto vert : pair.second) {
+      file_verts_on_border[std::size_t(h_verts2file_verts[vert])] = 1;
+    }
+  }
+  std::vector<int> internal_verts;
+  std::vector<int> border_verts;
+  for (LO i = 0; i < nfile_verts; ++i) {
+    auto& list = file_verts_on_border[std::size_t(i)] ? border_verts
+                                                      : internal_verts;
+    list.push_back(int(i + 1));
+  }
+  auto const file_verts_on_border_dev = to_device(file_verts_on_border);
+  auto const elems_on_border = land_each(elems_in_file,
+      mark_up(mesh, VERT, dim,
+          map_onto(file_verts_on_border_dev, file_verts2verts, mesh->nverts(),
+              I8(0), 1)));
+  auto const h_elems_on_border = HostRead<I8>(elems_on_border);
+  std::vector<int> internal_elems;
+  std::vector<int> border_elems;
+  for (LO elem = 0; elem < mesh->nelems(); ++elem) {
+    auto const file_elem = h_elems2file_elems[elem];
+    if (file_elem == -1) continue;
+    auto& list = h_elems_on_border[elem] ? border_elems : internal_elems;
+    list.push_back(int(file_elem + 1));
+  }
+  std::sort(internal_elems.begin(), internal_elems.end());
+  std::sort(border_elems.begin(), border_elems.end());
+  /* communication maps, one per neighboring rank and named after it */
+  std::vector<int> node_cmap_ids;
+  std::vector<int> node_cmap_counts;
+  for (auto& pair : vert_sharers) {
+    node_cmap_ids.push_back(int(pair.first));
+    node_cmap_counts.push_back(int(pair.second.size()));
+  }
+  auto const sides2elems = mesh->ask_up(dim - 1, dim);
+  auto const h_sides2elems = HostRead<LO>(sides2elems.a2ab);
+  auto const h_side_elems = HostRead<LO>(sides2elems.ab2b);
+  auto const h_side_codes = HostRead<I8>(sides2elems.codes);
+  std::vector<int> elem_cmap_ids;
+  std::vector<int> elem_cmap_counts;
+  for (auto& pair : side_sharers) {
+    elem_cmap_ids.push_back(int(pair.first));
+    elem_cmap_counts.push_back(int(pair.second.size()));
+  }
+  if (verbose) {
+    std::cout << "P" << rank << ": " << internal_verts.size()
+              << " internal and " << border_verts.size()
+              << " border nodes, " << internal_elems.size() << " internal and "
+              << border_elems.size() << " border elements, "
+              << node_cmap_ids.size() << " node and " << elem_cmap_ids.size()
+              << " element communication maps\n";
+  }
+  CALL(ex_put_loadbal_param(file, int64_t(internal_verts.size()),
+      int64_t(border_verts.size()), 0, int64_t(internal_elems.size()),
+      int64_t(border_elems.size()), int64_t(node_cmap_ids.size()),
+      int64_t(elem_cmap_ids.size()), rank));
+  CALL(ex_put_processor_node_maps(
+      file, internal_verts.data(), border_verts.data(), nullptr, rank));
+  CALL(ex_put_processor_elem_maps(
+      file, internal_elems.data(), border_elems.data(), rank));
+  CALL(ex_put_cmap_params(file, node_cmap_ids.data(), node_cmap_counts.data(),
+      elem_cmap_ids.data(), elem_cmap_counts.data(), rank));
+  for (auto& pair : vert_sharers) {
+    std::vector<int> cmap_verts;
+    for (auto vert : pair.second) {
+      cmap_verts.push_back(int(h_verts2file_verts[vert] + 1));
+    }
+    std::vector<int> cmap_ranks(cmap_verts.size(), int(pair.first));
+    CALL(ex_put_node_cmap(
+        file, pair.first, cmap_verts.data(), cmap_ranks.data(), rank));
+  }
+  for (auto& pair : side_sharers) {
+    std::vector<int> cmap_elems;
+    std::vector<int> cmap_sides;
+    for (auto side : pair.second) {
+      /* a side in two files has one element in each */
+      for (auto se = h_sides2elems[side]; se < h_sides2elems[side + 1]; ++se) {
+        auto const elem = h_side_elems[se];
+        auto const file_elem = h_elems2file_elems[elem];
+        if (file_elem == -1) continue;
+        cmap_elems.push_back(int(file_elem + 1));
+        cmap_sides.push_back(
+            side_osh2exo(dim, code_which_down(h_side_codes[se])));
+        break;
+      }
+    }
+    std::vector<int> cmap_ranks(cmap_elems.size(), int(pair.first));
+    CALL(ex_put_elem_cmap(file, pair.first, cmap_elems.data(),
+        cmap_sides.data(), cmap_ranks.data(), rank));
+  }
+}
+
+Writer::Writer(filesystem::path const& path, Mesh* mesh, bool background,
+    bool verbose, int classify_with)
+    : mesh_(mesh),
+      nverts_(mesh->nverts()),
+      file_(-1),
+      verbose_(verbose),
+      nvert_vars_(0),
+      nelem_vars_(0),
+      step_(0),
+      background_(background),
+      closing_(false) {
+  begin_code("exodus::Writer");
+  auto const comm = mesh->comm();
+  auto file_path = path;
+  if (comm->size() > 1) {
+    file_path += "." + std::to_string(comm->size()) + "." +
+                 std::to_string(comm->rank());
+  }
+  file_ = create(file_path);
+  file_elems2elems_ = collect_marked(mesh->owned(mesh->dim()));
+  auto const file_mesh = write_mesh(
+      file_, file_path, mesh, file_elems2elems_, verbose, classify_with);
+  if (comm->size() > 1) write_loadbal(file_, mesh, file_mesh, verbose);
+  file_verts2verts_ = file_mesh.file_verts2verts;
+  auto const& blocks = file_mesh.blocks;
+  Write<LO> block_elems2file_elems(file_elems2elems_.size());
+  LO offset = 0;
+  for (auto& block : blocks) {
+    auto const block_file_elems = block.file_elems;
+    auto f = OMEGA_H_LAMBDA(LO block_elem) {
+      block_elems2file_elems[offset + block_elem] =
+          block_file_elems[block_elem];
+    };
+    parallel_for(block_file_elems.size(), f, "concat_elem_blocks");
+    block_ids_.push_back(block.id);
+    block_sizes_.push_back(block_file_elems.size());
+    offset += block_file_elems.size();
+  }
+  block_elems2file_elems_ = block_elems2file_elems;
+  if (background_) worker_ = std::thread([this]() { this->work(); });
+  end_code();
+}
+
+/* lets the worker finish the pending steps and stops it */
+void Writer::stop() {
+  if (!worker_.joinable()) return;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    closing_ = true;
+  }
+  changed_.notify_all();
+  worker_.join();
+}
+
+void Writer::rethrow() {
+  if (!error_) return;
+  auto error = error_;
+  error_ = nullptr;
+  std::rethrow_exception(error);
+}
+
+void Writer::close() {
+  if (file_ == -1) return;
+  stop();
+  auto const file = file_;
+  file_ = -1;
+  if (error_) {
+    ex_close(file);
+    rethrow();
+  }
   CALL(ex_close(file));
+}
+
+/* errors can't be reported from here, so a caller that wants them
+   calls close() first */
+Writer::~Writer() {
+  stop();
+  if (file_ != -1) ex_close(file_);
+}
+
+void Writer::define(TagSet const& tags) {
+  auto const dim = mesh_->dim();
+  for (Int ent_dim = 0; ent_dim <= dim; ++ent_dim) {
+    if (ent_dim == VERT || ent_dim == dim) continue;
+    if (!tags[size_t(ent_dim)].empty()) {
+      Omega_h_fail("exodus::Writer only writes vertex and element fields\n");
+    }
+  }
+  std::vector<std::string> names[2];
+  for (Int i = 0; i < 2; ++i) {
+    auto const ent_dim = (i == 0) ? Int(VERT) : dim;
+    for (auto& name : tags[size_t(ent_dim)]) {
+      auto const tagbase = mesh_->get_tagbase(ent_dim, name);
+      if (tagbase->type() != OMEGA_H_REAL) {
+        Omega_h_fail("exodus::Writer: tag \"%s\" is not of type Real\n",
+            name.c_str());
+      }
+      for (auto& comp_name : component_names(name, tagbase->ncomps(), dim)) {
+        names[i].push_back(comp_name);
+      }
+    }
+  }
+  put_variable_names(file_, EX_NODAL, names[0]);
+  put_variable_names(file_, EX_ELEM_BLOCK, names[1]);
+  nvert_vars_ = int(names[0].size());
+  nelem_vars_ = int(names[1].size());
+  /* declaring that every block has every variable up front saves
+     Exodus from redefining the file as each block is written */
+  if (nelem_vars_ && !block_ids_.empty()) {
+    std::vector<int> truth_table(block_ids_.size() * names[1].size(), 1);
+    CALL(ex_put_truth_table(file_, EX_ELEM_BLOCK, int(block_ids_.size()),
+        nelem_vars_, truth_table.data()));
+  }
+  tags_ = tags;
+}
+
+void Writer::put(Step const& step) {
+  auto const time = step.time;
+  auto const file_step = step.index + 1;
+  CALL(ex_put_time(file_, file_step, &time));
+  auto values = step.values.data();
+  auto const nfile_verts = file_verts2verts_.size();
+  for (int var = 0; var < nvert_vars_; ++var) {
+    CALL(ex_put_var(file_, file_step, EX_NODAL, var + 1, /*obj_id*/ 0,
+        nfile_verts, values));
+    values += nfile_verts;
+  }
+  for (int var = 0; var < nelem_vars_; ++var) {
+    for (std::size_t block = 0; block < block_ids_.size(); ++block) {
+      CALL(ex_put_var(file_, file_step, EX_ELEM_BLOCK, var + 1,
+          block_ids_[block], block_sizes_[block], values));
+      values += block_sizes_[block];
+    }
+  }
+  CALL(ex_update(file_));
+  if (verbose_) {
+    std::cout << "P" << mesh_->comm()->rank() << ": wrote time step "
+              << file_step << " at time " << time << '\n';
+  }
+}
+
+void Writer::work() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    changed_.wait(lock, [this]() { return closing_ || !pending_.empty(); });
+    if (pending_.empty()) return;
+    /* the step stays queued while it is written, so the caller
+       can tell how many steps are not yet in the file */
+    auto& step = pending_.front();
+    lock.unlock();
+    std::exception_ptr error;
+    try {
+      put(step);
+    } catch (...) {
+      error = std::current_exception();
+    }
+    lock.lock();
+    if (error) {
+      /* the later steps would fail the same way, the caller
+         gets the first error from write() or close() */
+      error_ = error;
+      pending_.clear();
+      changed_.notify_all();
+      return;
+    }
+    pending_.pop_front();
+    changed_.notify_all();
+  }
+}
+
+void Writer::write(Real time, TagSet const& tags) {
+  begin_code("exodus::Writer::write");
+  OMEGA_H_CHECK(file_ != -1);
+  OMEGA_H_CHECK(mesh_->nverts() == nverts_);
+  if (step_ == 0) {
+    define(tags);
+  } else if (tags != tags_) {
+    Omega_h_fail(
+        "exodus::Writer: each time step must write the tags of the first\n");
+  }
+  auto const dim = mesh_->dim();
+  auto const nfile_verts = file_verts2verts_.size();
+  auto const nfile_elems = block_elems2file_elems_.size();
+  Step step;
+  step.index = step_++;
+  step.time = time;
+  step.values.reserve(std::size_t(nfile_verts) * std::size_t(nvert_vars_) +
+                      std::size_t(nfile_elems) * std::size_t(nelem_vars_));
+  /* gather every variable into one host buffer, in the order put()
+     writes them, so the Exodus calls of a step run back to back */
+  for (auto& name : tags_[VERT]) {
+    auto const ncomps = mesh_->get_tagbase(VERT, name)->ncomps();
+    auto const h_values = HostRead<Real>(unmap(
+        file_verts2verts_, mesh_->get_array<Real>(VERT, name), ncomps));
+    for (Int comp = 0; comp < ncomps; ++comp) {
+      for (LO vert = 0; vert < nfile_verts; ++vert) {
+        step.values.push_back(h_values[vert * ncomps + comp]);
+      }
+    }
+  }
+  for (auto& name : tags_[size_t(dim)]) {
+    auto const ncomps = mesh_->get_tagbase(dim, name)->ncomps();
+    auto const owned_values =
+        mesh_->owned_array(dim, mesh_->get_array<Real>(dim, name), ncomps);
+    auto const h_values =
+        HostRead<Real>(unmap(block_elems2file_elems_, owned_values, ncomps));
+    for (Int comp = 0; comp < ncomps; ++comp) {
+      for (LO elem = 0; elem < nfile_elems; ++elem) {
+        step.values.push_back(h_values[elem * ncomps + comp]);
+      }
+    }
+  }
+  if (!background_) {
+    put(step);
+  } else {
+    std::unique_lock<std::mutex> lock(mutex_);
+    /* one step being written and one waiting at most,
+       which bounds the memory held by pending steps */
+    changed_.wait(
+        lock, [this]() { return error_ || pending_.size() < 2; });
+    if (error_) {
+      lock.unlock();
+      end_code();
+      rethrow();
+    }
+    pending_.push_back(std::move(step));
+    lock.unlock();
+    changed_.notify_all();
+  }
   end_code();
 }
 
+void Writer::write(Real time) {
+  TagSet tags;
+  for (auto ent_dim : {Int(VERT), mesh_->dim()}) {
+    for (Int i = 0; i < mesh_->ntags(ent_dim); ++i) {
+      auto const tagbase = mesh_->get_tag(ent_dim, i);
+      if (tagbase->type() != OMEGA_H_REAL) continue;
+      if (tagbase->name() == "coordinates") continue;
+      tags[size_t(ent_dim)].insert(tagbase->name());
+    }
+  }
+  this->write(time, tags);
+}
+
 #undef CALL
 
 }  // end namespace exodus
@@ -5,17 +5,28 @@
 #include <cerrno>
 #include <cstring>
 #include <fstream>
+#include <functional>
 #include <iomanip>
 #include <iostream>
+#include <sstream>
 
 #ifdef OMEGA_H_USE_ZLIB
 #include <zlib.h>
 #endif
 
+#ifndef OMEGA_H_USE_MPI
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 #include "Omega_h_array_ops.hpp"
+#include "Omega_h_dist.hpp"
 #include "Omega_h_for.hpp"
 #include "Omega_h_inertia.hpp"
+#include "Omega_h_int_scan.hpp"
+#include "Omega_h_map.hpp"
 #include "Omega_h_mesh.hpp"
+#include "Omega_h_migrate.hpp"
 
 namespace Omega_h {
 
@@ -30,7 +41,8 @@ namespace binary {
 namespace {
 
 static_assert(sizeof(Int) == 4, "osh format assumes 32 bit Int");
-static_assert(sizeof(LO) == 4, "osh format assumes 32 bit LO");
+static_assert(
+    sizeof(LO) == 4 || sizeof(LO) == 8, "osh format assumes 32 or 64 bit LO");
 static_assert(sizeof(GO) == 8, "osh format assumes 64 bit GO");
 static_assert(sizeof(Real) == 8, "osh format assumes 64 bit Real");
 
@@ -87,6 +99,17 @@ struct SwapBytes<T, 8> {
 
 unsigned char const magic[2] = {0xa1, 0x1a};
 
+/* one part of a mesh written by (nparts) ranks, as read by a rank
+   that need not be the one that wrote it. the owners of its entities
+   refer to the writing ranks, so they are kept aside rather than
+   given to the mesh */
+struct Part {
+  Mesh mesh;
+  I32 nparts;
+  I32 rank;
+  Remotes owners[DIMS];
+};
+
 }  // end anonymous namespace
 
 template <typename T>
@@ -147,11 +170,30 @@ void write_array(std::ostream& stream, Read<T> array, bool is_compressed,
   }
 }
 
+/* reads a local index written by a build whose LO was
+   (index_width) bytes wide */
+static LO read_index(
+    std::istream& stream, bool needs_swapping, Int index_width) {
+  if (index_width == 8) {
+    I64 index;
+    read_value(stream, index, needs_swapping);
+    if (index > I64(ArithTraits<LO>::max())) {
+      Omega_h_fail(
+          "osh file has local indices past the 32 bit LO of this build,"
+          " rebuild with Omega_h_LO_64\n");
+    }
+    return LO(index);
+  }
+  OMEGA_H_CHECK(index_width == 4);
+  I32 index;
+  read_value(stream, index, needs_swapping);
+  return LO(index);
+}
+
 template <typename T>
 void read_array(std::istream& stream, Read<T>& array, bool is_compressed,
-    bool needs_swapping) {
-  LO size;
-  read_value(stream, size, needs_swapping);
+    bool needs_swapping, Int index_width) {
+  LO size = read_index(stream, needs_swapping, index_width);
   OMEGA_H_CHECK(size >= 0);
   I64 uncompressed_bytes =
       static_cast<I64>(static_cast<std::size_t>(size) * sizeof(T));
@@ -183,6 +225,35 @@ void read_array(std::istream& stream, Read<T>& array, bool is_compressed,
   array = swap_bytes(Read<T>(uncompressed.write()), needs_swapping);
 }
 
+template <typename T>
+static LOs convert_indices(Read<T> in) {
+  if (in.size() && I64(get_max(in)) > I64(ArithTraits<LO>::max())) {
+    Omega_h_fail(
+        "osh file has local indices past the 32 bit LO of this build,"
+        " rebuild with Omega_h_LO_64\n");
+  }
+  Write<LO> out(in.size());
+  auto f = OMEGA_H_LAMBDA(LO i) { out[i] = LO(in[i]); };
+  parallel_for(in.size(), f, "convert_indices");
+  return out;
+}
+
+void read_index_array(std::istream& stream, LOs& array, bool is_compressed,
+    bool needs_swapping, Int index_width) {
+  if (index_width == Int(sizeof(LO))) {
+    read_array(stream, array, is_compressed, needs_swapping, index_width);
+  } else if (index_width == 4) {
+    Read<I32> narrow;
+    read_array(stream, narrow, is_compressed, needs_swapping, index_width);
+    array = convert_indices(narrow);
+  } else {
+    OMEGA_H_CHECK(index_width == 8);
+    Read<I64> wide;
+    read_array(stream, wide, is_compressed, needs_swapping, index_width);
+    array = convert_indices(wide);
+  }
+}
+
 void write(std::ostream& stream, std::string const& val, bool needs_swapping) {
   I32 len = static_cast<I32>(val.length());
   write_value(stream, len, needs_swapping);
@@ -223,8 +294,8 @@ static void write_meta(
   }
 }
 
-static void read_meta(
-    std::istream& stream, Mesh* mesh, Int version, bool needs_swapping) {
+static void read_meta(std::istream& stream, Mesh* mesh, Int version,
+    bool needs_swapping, Part* part) {
   if (version >= 7) {
     I8 family;
     read_value(stream, family, needs_swapping);
@@ -235,10 +306,15 @@ static void read_meta(
   mesh->set_dim(Int(dim));
   I32 comm_size;
   read_value(stream, comm_size, needs_swapping);
-  OMEGA_H_CHECK(mesh->comm()->size() == comm_size);
   I32 comm_rank;
   read_value(stream, comm_rank, needs_swapping);
-  OMEGA_H_CHECK(mesh->comm()->rank() == comm_rank);
+  if (part) {
+    part->nparts = comm_size;
+    part->rank = comm_rank;
+  } else {
+    OMEGA_H_CHECK(mesh->comm()->size() == comm_size);
+    OMEGA_H_CHECK(mesh->comm()->rank() == comm_rank);
+  }
   I8 parting_i8;
   read_value(stream, parting_i8, needs_swapping);
   OMEGA_H_CHECK(parting_i8 == I8(OMEGA_H_ELEM_BASED) ||
@@ -292,7 +368,7 @@ static void write_tag(std::ostream& stream, TagBase const* tag,
 }
 
 static void read_tag(std::istream& stream, Mesh* mesh, Int d,
-    bool is_compressed, I32 version, bool needs_swapping) {
+    bool is_compressed, I32 version, bool needs_swapping, Int index_width) {
   std::string name;
   read(stream, name, needs_swapping);
   I8 ncomps;
@@ -309,19 +385,19 @@ static void read_tag(std::istream& stream, Mesh* mesh, Int d,
   }
   if (type == OMEGA_H_I8) {
     Read<I8> array;
-    read_array(stream, array, is_compressed, needs_swapping);
+    read_array(stream, array, is_compressed, needs_swapping, index_width);
     mesh->add_tag(d, name, ncomps, array, true);
   } else if (type == OMEGA_H_I32) {
     Read<I32> array;
-    read_array(stream, array, is_compressed, needs_swapping);
+    read_array(stream, array, is_compressed, needs_swapping, index_width);
     mesh->add_tag(d, name, ncomps, array, true);
   } else if (type == OMEGA_H_I64) {
     Read<I64> array;
-    read_array(stream, array, is_compressed, needs_swapping);
+    read_array(stream, array, is_compressed, needs_swapping, index_width);
     mesh->add_tag(d, name, ncomps, array, true);
   } else if (type == OMEGA_H_F64) {
     Read<Real> array;
-    read_array(stream, array, is_compressed, needs_swapping);
+    read_array(stream, array, is_compressed, needs_swapping, index_width);
     mesh->add_tag(d, name, ncomps, array, true);
   } else {
     Omega_h_fail("unexpected tag type in binary read\n");
@@ -371,6 +447,8 @@ void write(std::ostream& stream, Mesh* mesh) {
 #endif
   bool needs_swapping = !is_little_endian_cpu();
   write_value(stream, is_compressed, needs_swapping);
+  I8 index_width = sizeof(LO);
+  write_value(stream, index_width, needs_swapping);
   write_meta(stream, mesh, needs_swapping);
   LO nverts = mesh->nverts();
   write_value(stream, nverts, needs_swapping);
@@ -406,8 +484,8 @@ void write(std::ostream& stream, Mesh* mesh) {
   end_code();
 }
 
-void read(std::istream& stream, Mesh* mesh, I32 version) {
-  ScopedTimer timer("binary::read(istream, mesh, version)");
+static void read_part(
+    std::istream& stream, Mesh* mesh, I32 version, Part* part) {
   unsigned char magic_in[2];
   stream.read(reinterpret_cast<char*>(magic_in), sizeof(magic));
   OMEGA_H_CHECK(magic_in[0] == magic[0]);
@@ -421,15 +499,19 @@ void read(std::istream& stream, Mesh* mesh, I32 version) {
 #ifndef OMEGA_H_USE_ZLIB
   OMEGA_H_CHECK(!is_compressed);
 #endif
-  read_meta(stream, mesh, version, needs_swapping);
-  LO nverts;
-  read_value(stream, nverts, needs_swapping);
+  I8 index_width = 4;
+  if (version >= 10) read_value(stream, index_width, needs_swapping);
+  read_meta(stream, mesh, version, needs_swapping, part);
+  auto const nparts = part ? part->nparts : mesh->comm()->size();
+  LO nverts = read_index(stream, needs_swapping, index_width);
   mesh->set_verts(nverts);
   for (Int d = 1; d <= mesh->dim(); ++d) {
     Adj down;
-    read_array(stream, down.ab2b, is_compressed, needs_swapping);
+    read_index_array(
+        stream, down.ab2b, is_compressed, needs_swapping, index_width);
     if (d > 1) {
-      read_array(stream, down.codes, is_compressed, needs_swapping);
+      read_array(
+          stream, down.codes, is_compressed, needs_swapping, index_width);
     }
     mesh->set_ents(d, down);
   }
@@ -437,13 +519,23 @@ void read(std::istream& stream, Mesh* mesh, I32 version) {
     Int ntags;
     read_value(stream, ntags, needs_swapping);
     for (Int i = 0; i < ntags; ++i) {
-      read_tag(stream, mesh, d, is_compressed, version, needs_swapping);
+      read_tag(stream, mesh, d, is_compressed, version, needs_swapping,
+          index_width);
     }
-    if (mesh->comm()->size() > 1) {
+    if (nparts > 1) {
       Remotes owners;
-      read_array(stream, owners.ranks, is_compressed, needs_swapping);
-      read_array(stream, owners.idxs, is_compressed, needs_swapping);
-      mesh->set_owners(d, owners);
+      read_array(
+          stream, owners.ranks, is_compressed, needs_swapping, index_width);
+      read_index_array(
+          stream, owners.idxs, is_compressed, needs_swapping, index_width);
+      if (part) {
+        part->owners[d] = owners;
+      } else {
+        mesh->set_owners(d, owners);
+      }
+    } else if (part) {
+      auto const nents = mesh->nents(d);
+      part->owners[d] = Remotes(Read<I32>(nents, 0), LOs(nents, 0, 1));
     }
   }
   if (version >= 8) {
@@ -455,14 +547,21 @@ void read(std::istream& stream, Mesh* mesh, I32 version) {
     if (has_parents) {
       for (Int d = 0; d <= mesh->dim(); ++d) {
         Parents parents;
-        read_array(stream, parents.parent_idx, is_compressed, needs_swapping);
-        read_array(stream, parents.codes, is_compressed, needs_swapping);
+        read_index_array(stream, parents.parent_idx, is_compressed,
+            needs_swapping, index_width);
+        read_array(stream, parents.codes, is_compressed, needs_swapping,
+            index_width);
         mesh->set_parents(d, parents);
       }
     }
   }
 }
 
+void read(std::istream& stream, Mesh* mesh, I32 version) {
+  ScopedTimer timer("binary::read(istream, mesh, version)");
+  read_part(stream, mesh, version, nullptr);
+}
+
 static void write_int_file(
     filesystem::path const& filepath, Mesh* mesh, I32 value) {
   if (mesh->comm()->rank() == 0) {
@@ -548,7 +647,482 @@ void read_in_comm(
   read(file, mesh, version);
 }
 
-I32 read(filesystem::path const& path, CommPtr comm, Mesh* mesh, bool strict) {
+namespace {
+
+/* a file that all ranks of (comm) write or read at explicit offsets.
+   with MPI every access is a collective MPI-IO call, which lets the
+   MPI library merge the requests of many ranks into a few large ones
+   and keeps the file system down to one file per mesh.
+   without MPI there is one rank, which uses pwrite and pread. */
+class SharedFile {
+ public:
+  SharedFile(CommPtr comm, filesystem::path const& path, bool writing);
+  ~SharedFile();
+  SharedFile(SharedFile const&) = delete;
+  SharedFile& operator=(SharedFile const&) = delete;
+  /* these are collective: every rank calls them the same number
+     of times, with nothing to transfer if need be */
+  void write_at(I64 offset, std::string const& bytes);
+  std::string read_at(I64 offset, I64 size);
+
+ private:
+  CommPtr comm_;
+  filesystem::path path_;
+#ifdef OMEGA_H_USE_MPI
+  MPI_File file_;
+#else
+  int file_;
+#endif
+};
+
+/* MPI counts are ints, so transfers are split into rounds of this size */
+constexpr I64 max_transfer_bytes = I64(1) << 30;
+
+SharedFile::SharedFile(
+    CommPtr comm, filesystem::path const& path, bool writing)
+    : comm_(comm), path_(path) {
+#ifdef OMEGA_H_USE_MPI
+  auto const mode =
+      writing ? (MPI_MODE_CREATE | MPI_MODE_WRONLY) : MPI_MODE_RDONLY;
+  auto const err = MPI_File_open(
+      comm_->get_impl(), path_.c_str(), mode, MPI_INFO_NULL, &file_);
+  if (err != MPI_SUCCESS) {
+    Omega_h_fail("could not open \"%s\" with MPI-IO\n", path_.c_str());
+  }
+  /* a longer file left at this path would otherwise keep its tail */
+  if (writing) MPI_File_set_size(file_, 0);
+#else
+  file_ = writing ? ::open(path_.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0666)
+                  : ::open(path_.c_str(), O_RDONLY);
+  if (file_ < 0) {
+    Omega_h_fail("could not open \"%s\": %s\n", path_.c_str(),
+        std::strerror(errno));
+  }
+#endif
+}
+
+SharedFile::~SharedFile() {
+#ifdef OMEGA_H_USE_MPI
+  MPI_File_close(&file_);
+#else
+  ::close(file_);
+#endif
+}
+
+void SharedFile::write_at(I64 offset, std::string const& bytes) {
+  auto const size = I64(bytes.size());
+#ifdef OMEGA_H_USE_MPI
+  auto const nrounds = comm_->allreduce(
+      (size + max_transfer_bytes - 1) / max_transfer_bytes, OMEGA_H_MAX);
+  for (I64 round = 0; round < nrounds; ++round) {
+    auto const begin = min2(round * max_transfer_bytes, size);
+    auto const count = min2(max_transfer_bytes, size - begin);
+    MPI_Status status;
+    auto const err = MPI_File_write_at_all(file_, MPI_Offset(offset + begin),
+        bytes.data() + begin, int(count), MPI_BYTE, &status);
+    if (err != MPI_SUCCESS) {
+      Omega_h_fail("could not write to \"%s\" with MPI-IO\n", path_.c_str());
+    }
+  }
+#else
+  I64 done = 0;
+  while (done < size) {
+    auto const n = ::pwrite(file_, bytes.data() + done,
+        std::size_t(size - done), off_t(offset + done));
+    if (n < 0 && errno == EINTR) continue;
+    if (n < 0) {
+      Omega_h_fail("could not write to \"%s\": %s\n", path_.c_str(),
+          std::strerror(errno));
+    }
+    done += I64(n);
+  }
+#endif
+}
+
+std::string SharedFile::read_at(I64 offset, I64 size) {
+  std::string bytes(std::size_t(size), '\0');
+#ifdef OMEGA_H_USE_MPI
+  auto const nrounds = comm_->allreduce(
+      (size + max_transfer_bytes - 1) / max_transfer_bytes, OMEGA_H_MAX);
+  for (I64 round = 0; round < nrounds; ++round) {
+    auto const begin = min2(round * max_transfer_bytes, size);
+    auto const count = min2(max_transfer_bytes, size - begin);
+    MPI_Status status;
+    auto const err = MPI_File_read_at_all(file_, MPI_Offset(offset + begin),
+        &bytes[std::size_t(begin)], int(count), MPI_BYTE, &status);
+    if (err != MPI_SUCCESS) {
+      Omega_h_fail("could not read \"%s\" with MPI-IO\n", path_.c_str());
+    }
+  }
+#else
+  I64 done = 0;
+  while (done < size) {
+    auto const n = ::pread(file_, &bytes[std::size_t(done)],
+        std::size_t(size - done), off_t(offset + done));
+    if (n < 0 && errno == EINTR) continue;
+    if (n <= 0) {
+      Omega_h_fail("could not read \"%s\": %s\n", path_.c_str(),
+          (n < 0) ? std::strerror(errno) : "unexpected end of file");
+    }
+    done += I64(n);
+  }
+#endif
+  return bytes;
+}
+
+}  // end anonymous namespace
+
+/* a shared file begins with the magic bytes, the format version
+   and the number of parts, then a table of (nparts + 1) offsets
+   at which each part begins and the last one ends */
+static I64 shared_table_offset() {
+  return I64(sizeof(magic) + sizeof(I32) + sizeof(I32));
+}
+
+void write_shared(filesystem::path const& path, Mesh* mesh) {
+  begin_code("binary::write_shared");
+  auto const comm = mesh->comm();
+  auto const nparts = comm->size();
+  auto const rank = comm->rank();
+  bool needs_swapping = !is_little_endian_cpu();
+  std::ostringstream part_stream;
+  write(part_stream, mesh);
+  auto const part = part_stream.str();
+  auto const parts_offset =
+      shared_table_offset() + I64(nparts + 1) * I64(sizeof(I64));
+  auto const part_offset =
+      parts_offset + comm->exscan(I64(part.size()), OMEGA_H_SUM);
+  /* the header is written by all ranks, each providing the table
+     entry of its own part and rank 0 also the leading values */
+  std::ostringstream header;
+  if (rank == 0) {
+    header.write(reinterpret_cast<const char*>(magic), sizeof(magic));
+    write_value(header, latest_version, needs_swapping);
+    write_value(header, nparts, needs_swapping);
+  }
+  write_value(header, part_offset, needs_swapping);
+  if (rank == nparts - 1) {
+    write_value(header, part_offset + I64(part.size()), needs_swapping);
+  }
+  auto const header_offset =
+      (rank == 0) ? I64(0)
+                  : shared_table_offset() + I64(rank) * I64(sizeof(I64));
+  SharedFile file(comm, path, true);
+  file.write_at(header_offset, header.str());
+  file.write_at(part_offset, part);
+  end_code();
+}
+
+/* a linear partition of (n) things into (k) contiguous ranges,
+   with the first thing of range (i) and the range of thing (j) */
+OMEGA_H_INLINE I32 linear_range_begin(I32 i, I32 n, I32 k) {
+  return I32((I64(i) * I64(n)) / I64(k));
+}
+
+OMEGA_H_INLINE I32 linear_range_of(I32 j, I32 n, I32 k) {
+  return I32(((I64(j) + 1) * I64(k) - 1) / I64(n));
+}
+
+/* which of (nparts) parts rank (rank) of (nranks) reads.
+   with more parts than ranks, each rank reads a contiguous range of
+   parts. otherwise, with (spread), the ranks are split into a contiguous
+   range per part, whose first rank reads the part and later hands slices
+   of it to the others. without it, part (p) is read by rank (p) and the
+   remaining ranks read nothing. */
+static void get_parts_read_by(
+    I32 rank, I32 nranks, I32 nparts, bool spread, I32* begin, I32* end) {
+  if (nparts > nranks) {
+    *begin = linear_range_begin(rank, nparts, nranks);
+    *end = linear_range_begin(rank + 1, nparts, nranks);
+    return;
+  }
+  if (!spread) {
+    *begin = (rank < nparts) ? rank : 0;
+    *end = (rank < nparts) ? (rank + 1) : 0;
+    return;
+  }
+  auto const part = linear_range_of(rank, nranks, nparts);
+  auto const is_reader = (linear_range_begin(part, nranks, nparts) == rank);
+  *begin = is_reader ? part : 0;
+  *end = is_reader ? (part + 1) : 0;
+}
+
+template <typename T>
+static Read<T> concat_arrays(std::vector<Read<T>> const& arrays) {
+  LO n = 0;
+  for (auto& array : arrays) n += array.size();
+  Write<T> out(n);
+  LO offset = 0;
+  for (auto& array : arrays) {
+    auto const piece = array;
+    auto f = OMEGA_H_LAMBDA(LO i) { out[offset + i] = piece[i]; };
+    parallel_for(piece.size(), f, "concat_arrays");
+    offset += piece.size();
+  }
+  return out;
+}
+
+template <typename T>
+static void concat_tag(std::vector<Part>& parts, Mesh* mesh, Int ent_dim,
+    std::string const& name, Int ncomps) {
+  std::vector<Read<T>> arrays;
+  for (auto& part : parts) {
+    arrays.push_back(part.mesh.get_array<T>(ent_dim, name));
+  }
+  mesh->add_tag(ent_dim, name, ncomps, concat_arrays(arrays), true);
+}
+
+/* the owners recorded in the parts are (writing rank, index in its
+   part). each becomes (rank reading that part, index of the part's
+   first entity in that rank's mesh plus the index in its part),
+   which only the reading rank knows, so we ask it */
+static Remotes owners_of_concatenated(CommPtr comm, I32 nparts,
+    I32 first_part, std::vector<LO> const& part_offsets,
+    Remotes part_owners) {
+  auto const nreaders = comm->size();
+  auto const n = part_owners.ranks.size();
+  auto const writer_ranks = part_owners.ranks;
+  auto const part_idxs = part_owners.idxs;
+  Write<I32> reader_ranks(n);
+  Write<LO> requests(n * 2);
+  auto f = OMEGA_H_LAMBDA(LO i) {
+    reader_ranks[i] = linear_range_of(writer_ranks[i], nparts, nreaders);
+    requests[i * 2 + 0] = writer_ranks[i];
+    requests[i * 2 + 1] = part_idxs[i];
+  };
+  parallel_for(n, f, "owner_requests");
+  Dist to_readers;
+  to_readers.set_parent_comm(comm);
+  to_readers.set_dest_ranks(reader_ranks);
+  auto const received = to_readers.exch(read(requests), 2);
+  HostWrite<LO> h_offsets(LO(part_offsets.size()));
+  for (LO i = 0; i < h_offsets.size(); ++i) {
+    h_offsets[i] = part_offsets[std::size_t(i)];
+  }
+  auto const offsets = read(h_offsets.write());
+  auto const nreceived = divide_no_remainder(received.size(), 2);
+  Write<LO> answers(nreceived);
+  auto g = OMEGA_H_LAMBDA(LO i) {
+    answers[i] = offsets[received[i * 2 + 0] - first_part] +
+                 received[i * 2 + 1];
+  };
+  parallel_for(nreceived, g, "owner_answers");
+  auto const idxs = to_readers.invert().exch(read(answers), 1);
+  return Remotes(reader_ranks, idxs);
+}
+
+/* migrates the (owned) elements, and only those, to (dest_ranks),
+   given per owned element. the elements arriving at a rank are
+   ordered by global number. then (parting) is restored */
+static void send_owned_elems(Mesh* mesh, Read<I8> owned,
+    Read<I32> dest_ranks, Omega_h_Parting parting, Int nghost_layers) {
+  OMEGA_H_CHECK(mesh->parting() == OMEGA_H_ELEM_BASED);
+  Dist old2new;
+  old2new.set_parent_comm(mesh->comm());
+  old2new.set_dest_ranks(dest_ranks);
+  old2new.set_roots2items(offset_scan(owned));
+  old2new.set_dest_globals(mesh->globals(mesh->dim()));
+  migrate_mesh(mesh, old2new.invert(), OMEGA_H_ELEM_BASED, false);
+  if (parting != OMEGA_H_ELEM_BASED) {
+    mesh->set_parting(parting, nghost_layers, false);
+  }
+}
+
+/* forms on each rank of (comm) the union of the parts it read, where
+   entities shared by two of those parts are still duplicated, and
+   then has every rank keep its owned elements, which removes the
+   duplicates and rebuilds ownership from the global numbers */
+static void assemble_parts(
+    CommPtr comm, I32 nparts, I32 first_part, std::vector<Part>& parts,
+    Mesh* mesh) {
+  auto& first = parts.front().mesh;
+  auto const dim = first.dim();
+  mesh->set_comm(comm);
+  mesh->set_family(first.family());
+  mesh->set_dim(dim);
+  mesh->set_parting(OMEGA_H_ELEM_BASED);
+  std::vector<LO> part_offsets[DIMS];
+  LO nents[DIMS] = {0, 0, 0, 0};
+  for (auto& part : parts) {
+    for (Int d = 0; d <= dim; ++d) {
+      part_offsets[d].push_back(nents[d]);
+      nents[d] += part.mesh.nents(d);
+    }
+  }
+  mesh->set_verts(nents[VERT]);
+  for (Int d = 1; d <= dim; ++d) {
+    std::vector<Read<LO>> ab2bs;
+    std::vector<Read<I8>> codes;
+    for (std::size_t i = 0; i < parts.size(); ++i) {
+      auto const down = parts[i].mesh.ask_down(d, d - 1);
+      ab2bs.push_back(add_to_each(down.ab2b, part_offsets[d - 1][i]));
+      if (d > 1) codes.push_back(down.codes);
+    }
+    if (d > 1) {
+      mesh->set_ents(d, Adj(concat_arrays(ab2bs), concat_arrays(codes)));
+    } else {
+      mesh->set_ents(d, Adj(concat_arrays(ab2bs)));
+    }
+  }
+  for (Int d = 0; d <= dim; ++d) {
+    for (Int i = 0; i < first.ntags(d); ++i) {
+      auto const tag = first.get_tag(d, i);
+      auto const& name = tag->name();
+      auto const ncomps = tag->ncomps();
+      switch (tag->type()) {
+        case OMEGA_H_I8:
+          concat_tag<I8>(parts, mesh, d, name, ncomps);
+          break;
+        case OMEGA_H_I32:
+          concat_tag<I32>(parts, mesh, d, name, ncomps);
+          break;
+        case OMEGA_H_I64:
+          concat_tag<I64>(parts, mesh, d, name, ncomps);
+          break;
+        case OMEGA_H_F64:
+          concat_tag<Real>(parts, mesh, d, name, ncomps);
+          break;
+      }
+    }
+    std::vector<Read<I32>> ranks;
+    std::vector<Read<LO>> idxs;
+    for (auto& part : parts) {
+      ranks.push_back(part.owners[d].ranks);
+      idxs.push_back(part.owners[d].idxs);
+    }
+    auto const part_owners =
+        Remotes(concat_arrays(ranks), concat_arrays(idxs));
+    mesh->set_owners(d, owners_of_concatenated(comm, nparts, first_part,
+                            part_offsets[d], part_owners));
+  }
+  mesh->class_sets = first.class_sets;
+  std::vector<Read<I8>> owned;
+  for (auto& part : parts) {
+    owned.push_back(each_eq_to(part.owners[dim].ranks, part.rank));
+  }
+  auto const elems_owned = concat_arrays(owned);
+  auto const nowned = get_sum(elems_owned);
+  send_owned_elems(mesh, elems_owned, Read<I32>(nowned, comm->rank()),
+      first.parting(), first.nghost_layers());
+}
+
+/* with fewer parts than ranks, the rank that read a part hands
+   contiguous slices of its elements to the other ranks of the part's
+   range (see get_parts_read_by()), which have no elements yet */
+static void spread_parts(Mesh* mesh, I32 nparts) {
+  auto const comm = mesh->comm();
+  auto const rank = comm->rank();
+  auto const nranks = comm->size();
+  auto const parting = mesh->parting();
+  auto const nghost_layers = mesh->nghost_layers();
+  mesh->set_parting(OMEGA_H_ELEM_BASED);
+  auto const nelems = mesh->nelems();
+  auto const part = linear_range_of(rank, nranks, nparts);
+  auto const nslices = linear_range_begin(part + 1, nranks, nparts) - rank;
+  Write<I32> dest_ranks(nelems);
+  auto f = OMEGA_H_LAMBDA(LO elem) {
+    dest_ranks[elem] = rank + linear_range_of(elem, nelems, nslices);
+  };
+  parallel_for(nelems, f, "spread_parts");
+  send_owned_elems(mesh, Read<I8>(nelems, 1), dest_ranks, parting,
+      nghost_layers);
+}
+
+/* reads the mesh written by (nparts) ranks onto (comm), each rank
+   reading the parts get_parts_read_by() gives it through (read_one).
+   with as many parts as ranks, each part is read as is by the rank
+   that wrote it. with (spread), fewer parts than ranks are handed out
+   in slices by spread_parts(). with (balance), a mesh that was read onto
+   a different number of ranks is then repartitioned by Mesh::balance,
+   which needs elements on every rank, so callers also set (spread) */
+static void read_parts(CommPtr comm, I32 nparts,
+    std::function<void(I32 part, Mesh* mesh, Part* info)> const& read_one,
+    Mesh* mesh, bool spread, bool balance) {
+  auto const rank = comm->rank();
+  auto const nranks = comm->size();
+  I32 begin, end;
+  get_parts_read_by(rank, nranks, nparts, spread, &begin, &end);
+  if (nparts > nranks) {
+    std::vector<Part> parts(std::size_t(end - begin));
+    for (I32 part = begin; part < end; ++part) {
+      auto& info = parts[std::size_t(part - begin)];
+      info.mesh = Mesh(comm->library());
+      info.mesh.set_comm(comm->library()->self());
+      read_one(part, &info.mesh, &info);
+    }
+    assemble_parts(comm, nparts, begin, parts, mesh);
+  } else {
+    /* the readers keep their order, so part (p) is read by
+       rank (p) of the subcommunicator, as it was written */
+    auto const in_subcomm = (end > begin);
+    auto const subcomm = comm->split(I32(!in_subcomm), 0);
+    if (in_subcomm) {
+      mesh->set_comm(subcomm);
+      read_one(begin, mesh, nullptr);
+    }
+    mesh->set_comm(comm);
+    if (nparts < nranks && spread) spread_parts(mesh, nparts);
+  }
+  if (balance && nparts != nranks) {
+    auto const parting = mesh->parting();
+    auto const nghost_layers = mesh->nghost_layers();
+    mesh->balance();
+    mesh->set_parting(parting, nghost_layers, false);
+  }
+}
+
+I32 read_shared(filesystem::path const& path, CommPtr comm, Mesh* mesh,
+    bool spread, bool balance) {
+  ScopedTimer timer("binary::read_shared(path, comm, mesh)");
+  bool needs_swapping = !is_little_endian_cpu();
+  SharedFile file(comm, path, false);
+  std::istringstream leading(file.read_at(0, shared_table_offset()));
+  unsigned char magic_in[2];
+  leading.read(reinterpret_cast<char*>(magic_in), sizeof(magic));
+  if (magic_in[0] != magic[0] || magic_in[1] != magic[1]) {
+    Omega_h_fail("\"%s\" is not a shared Omega_h file\n", path.c_str());
+  }
+  I32 version;
+  read_value(leading, version, needs_swapping);
+  OMEGA_H_CHECK(version >= 1);
+  OMEGA_H_CHECK(version <= latest_version);
+  I32 nparts;
+  read_value(leading, nparts, needs_swapping);
+  OMEGA_H_CHECK(nparts >= 1);
+  I32 begin, end;
+  spread = spread || balance;
+  get_parts_read_by(
+      comm->rank(), comm->size(), nparts, spread, &begin, &end);
+  auto const ntable = (end > begin) ? (end - begin + 1) : 0;
+  std::istringstream table(
+      file.read_at(shared_table_offset() + I64(begin) * I64(sizeof(I64)),
+          I64(ntable) * I64(sizeof(I64))));
+  std::vector<I64> offsets(static_cast<std::size_t>(ntable));
+  for (auto& offset : offsets) read_value(table, offset, needs_swapping);
+  auto const bytes_begin = ntable ? offsets.front() : I64(0);
+  auto const bytes_end = ntable ? offsets.back() : I64(0);
+  auto const bytes = file.read_at(bytes_begin, bytes_end - bytes_begin);
+  auto read_one = [&](I32 part, Mesh* part_mesh, Part* info) {
+    auto const i = std::size_t(part - begin);
+    std::istringstream stream(
+        bytes.substr(std::size_t(offsets[i] - bytes_begin),
+            std::size_t(offsets[i + 1] - offsets[i])));
+    read_part(stream, part_mesh, version, info);
+  };
+  read_parts(comm, nparts, read_one, mesh, spread, balance);
+  return nparts;
+}
+
+Mesh read_shared(filesystem::path const& path, CommPtr comm, bool spread,
+    bool balance) {
+  ScopedTimer timer("binary::read_shared(path, comm)");
+  auto mesh = Mesh(comm->library());
+  binary::read_shared(path, comm, &mesh, spread, balance);
+  return mesh;
+}
+
+I32 read(filesystem::path const& path, CommPtr comm, Mesh* mesh, bool strict,
+    bool spread, bool balance) {
   ScopedTimer timer("binary::read(path, comm, mesh, strict)");
   auto const nparts = read_nparts(path, comm);
   auto const version = read_version(path, comm);
@@ -562,17 +1136,16 @@ I32 read(filesystem::path const& path, CommPtr comm, Mesh* mesh, bool strict) {
     }
     read_in_comm(path, comm, mesh, version);
   } else {
-    if (nparts > comm->size()) {
-      Omega_h_fail(
-          "path \"%s\" contains %d parts, but only %d ranks are reading it\n",
-          path.c_str(), nparts, comm->size());
-    }
-    auto const in_subcomm = (comm->rank() < nparts);
-    auto const subcomm = comm->split(I32(!in_subcomm), 0);
-    if (in_subcomm) {
-      read_in_comm(path, subcomm, mesh, version);
-    }
-    mesh->set_comm(comm);
+    spread = spread || balance;
+    auto read_one = [&](I32 part, Mesh* part_mesh, Part* info) {
+      auto filepath = path;
+      filepath /= std::to_string(part);
+      if (version != -1) filepath += ".osh";
+      std::ifstream file(filepath.c_str(), std::ios::binary);
+      OMEGA_H_CHECK(file.is_open());
+      read_part(file, part_mesh, version, info);
+    };
+    read_parts(comm, nparts, read_one, mesh, spread, balance);
   }
   return nparts;
 }
@@ -582,10 +1155,11 @@ Mesh read(filesystem::path const& path, Library* lib, bool strict) {
   return binary::read(path, lib->world(), strict);
 }
 
-Mesh read(filesystem::path const& path, CommPtr comm, bool strict) {
+Mesh read(filesystem::path const& path, CommPtr comm, bool strict,
+    bool spread, bool balance) {
   ScopedTimer timer("binary::read(path, comm, strict)");
   auto mesh = Mesh(comm->library());
-  binary::read(path, comm, &mesh, strict);
+  binary::read(path, comm, &mesh, strict, spread, balance);
   return mesh;
 }
 
@@ -595,8 +1169,8 @@ Mesh read(filesystem::path const& path, CommPtr comm, bool strict) {
   template void write_value(std::ostream& stream, T val, bool);                \
   template void read_value(std::istream& stream, T& val, bool);                \
   template void write_array(std::ostream& stream, Read<T> array, bool, bool);  \
-  template void read_array(                                                    \
-      std::istream& stream, Read<T>& array, bool is_compressed, bool);
+  template void read_array(std::istream& stream, Read<T>& array,             \
+      bool is_compressed, bool, Int);
 OMEGA_H_INST(I8)
 OMEGA_H_INST(I32)
 OMEGA_H_INST(I64)
@@ -5,6 +5,15 @@
 #include <vector>
 
 #include <Omega_h_config.h>
+
+#ifdef OMEGA_H_USE_SEACASEXODUS
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#endif
+
 #include <Omega_h_array.hpp>
 #include <Omega_h_comm.hpp>
 #include <Omega_h_defines.hpp>
@@ -48,6 +57,71 @@ void write(filesystem::path const& path, Mesh* mesh, bool verbose = false,
 Mesh read_sliced(filesystem::path const& path, CommPtr comm,
     bool verbose = false, int classify_with = NODE_SETS | SIDE_SETS,
     int time_step = -1);
+
+/* writes the mesh once and then appends time steps of vertex and
+   element fields to it, the Exodus analogue of vtk::Writer.
+   the variables are defined by the first step, and every later step
+   must write the same tags of the same mesh.
+   the global numbers of the vertices and elements are the node and
+   element id maps. on more than one rank, each rank writes its owned
+   elements and their vertices to "path.<nranks>.<rank>", the names
+   SEACAS epu joins, along with the Nemesis load balance data.
+   with (background) set, the values of each step are gathered to the
+   host by the caller and a worker thread writes them, so the caller
+   only waits for the file when more than one step is pending, and an
+   error of the worker is thrown by the next write() or by close().
+   close() writes the pending steps and reports any error; the
+   destructor does the same but ignores errors. */
+class Writer {
+ public:
+  Writer(filesystem::path const& path, Mesh* mesh, bool background = false,
+      bool verbose = false, int classify_with = NODE_SETS | SIDE_SETS);
+  ~Writer();
+  Writer(Writer const&) = delete;
+  Writer& operator=(Writer const&) = delete;
+  /* all Real tags on vertices and elements except coordinates */
+  void write(Real time);
+  void write(Real time, TagSet const& tags);
+  void close();
+
+ private:
+  struct Step {
+    int index;
+    Real time;
+    /* each vertex variable, then each element variable
+       split by element block */
+    std::vector<Real> values;
+  };
+  void define(TagSet const& tags);
+  void put(Step const& step);
+  void work();
+  void stop();
+  void rethrow();
+  Mesh* mesh_;
+  LO nverts_;
+  int file_;
+  bool verbose_;
+  /* the owned elements, which are the elements in the file */
+  LOs file_elems2elems_;
+  /* their vertices, which are the nodes in the file */
+  LOs file_verts2verts_;
+  /* the file elements in the order of the element blocks */
+  LOs block_elems2file_elems_;
+  std::vector<ClassId> block_ids_;
+  std::vector<LO> block_sizes_;
+  TagSet tags_;
+  int nvert_vars_;
+  int nelem_vars_;
+  int step_;
+  bool background_;
+  std::thread worker_;
+  std::mutex mutex_;
+  std::condition_variable changed_;
+  std::deque<Step> pending_;
+  bool closing_;
+  /* the first error of the worker, not yet thrown */
+  std::exception_ptr error_;
+};
 }  // namespace exodus
 #endif
 
@@ -57,6 +131,17 @@ Mesh read(filesystem::path const& filename, CommPtr comm);
 void write(std::ostream& stream, Mesh* mesh);
 void write(filesystem::path const& filepath, Mesh* mesh);
 
+/**
+ * Load a serial MSH file in format version 4.0 or higher directly into
+ * a distributed mesh: each rank parses only its own slice of the nodes
+ * and elements, so no rank has to hold the whole mesh.
+ *
+ * \param filename path to a file that every rank of \p comm can read
+ * \note the mesh is partitioned by file order, call Mesh::balance
+ * for a better partition
+ */
+Mesh read_sliced(filesystem::path const& filename, CommPtr comm);
+
 #ifdef OMEGA_H_USE_GMSH
 
 /**
@@ -143,15 +228,42 @@ namespace binary {
 
 void write(filesystem::path const& path, Mesh* mesh);
 Mesh read(filesystem::path const& path, Library* lib, bool strict = false);
-Mesh read(filesystem::path const& path, CommPtr comm, bool strict = false);
+/* unless (strict), the mesh may have been written by any number of ranks.
+   with more parts than ranks, each rank reads a contiguous range of
+   parts. with fewer, part (p) is read by rank (p) and the other ranks
+   are left empty, unless (spread) is given, in which case each part is
+   spread in slices over a range of ranks. with (balance), a mesh read
+   onto a different number of ranks is spread if needed and then
+   repartitioned by Mesh::balance */
+Mesh read(filesystem::path const& path, CommPtr comm, bool strict = false,
+    bool spread = false, bool balance = false);
 I32 read(filesystem::path const& path, CommPtr comm, Mesh* mesh,
-    bool strict = false);
+    bool strict = false, bool spread = false, bool balance = false);
 I32 read_nparts(filesystem::path const& path, CommPtr comm);
 I32 read_version(filesystem::path const& path, CommPtr comm);
 void read_in_comm(
     filesystem::path const& path, CommPtr comm, Mesh* mesh, I32 version);
 
-constexpr I32 latest_version = 9;
+/* writes the mesh as a single file shared by all ranks,
+   holding each rank's part as write() would and a table of
+   where they are, using collective MPI-IO where available */
+void write_shared(filesystem::path const& path, Mesh* mesh);
+/* reads a file from write_shared() by any number of ranks,
+   which are given parts as read() does.
+   returns the number of parts in the file */
+I32 read_shared(filesystem::path const& path, CommPtr comm, Mesh* mesh,
+    bool spread = false, bool balance = false);
+Mesh read_shared(filesystem::path const& path, CommPtr comm,
+    bool spread = false, bool balance = false);
+
+/* since version 10, files record the width of the LO that wrote them,
+   and local indices are converted to this build's LO on read.
+   this covers the indices the format knows about: connectivity,
+   owners and parents. a tag of type LO is stored by its runtime type,
+   which an Omega_h_LO_64 build cannot tell apart from I64, so it reads
+   back into a 32 bit build as an I64 tag. callers that need it as LO
+   there convert it themselves, e.g. with array_cast<LO>(Read<I64>) */
+constexpr I32 latest_version = 10;
 
 template <typename T>
 void swap_bytes(T&);
@@ -166,9 +278,15 @@ void read_value(std::istream& stream, T& val, bool needs_swapping);
 template <typename T>
 void write_array(std::ostream& stream, Read<T> array, bool is_compressed,
     bool needs_swapping);
+/* (index_width) is the size in bytes of the LO that wrote the array,
+   which its size is stored as */
 template <typename T>
 void read_array(std::istream& stream, Read<T>& array, bool is_compressed,
-    bool needs_swapping);
+    bool needs_swapping, Int index_width = Int(sizeof(LO)));
+/* reads an array of local indices written with (index_width) bytes each,
+   failing if they do not fit in this build's LO */
+void read_index_array(std::istream& stream, LOs& array, bool is_compressed,
+    bool needs_swapping, Int index_width);
 
 void write(std::ostream& stream, std::string const& val, bool needs_swapping);
 void read(std::istream& stream, std::string& val, bool needs_swapping);
@@ -184,7 +302,7 @@ void read(std::istream& stream, Mesh* mesh, I32 version);
   extern template void write_array(                                            \
       std::ostream& stream, Read<T> array, bool, bool);                        \
   extern template void read_array(                                             \
-      std::istream& stream, Read<T>& array, bool, bool);
+      std::istream& stream, Read<T>& array, bool, bool, Int);
 INST_DECL(I8)
 INST_DECL(I32)
 INST_DECL(I64)
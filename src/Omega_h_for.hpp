@@ -11,6 +11,10 @@
 #include <Omega_h_kokkos.hpp>
 #endif
 
+#ifdef OMEGA_H_USE_THREADS
+#include <Omega_h_threads.hpp>
+#endif
+
 namespace Omega_h {
 
 #if defined(OMEGA_H_USE_CUDA)
@@ -71,6 +75,11 @@ void for_each(InputIterator first, InputIterator last, UnaryFunction&& f) {
   for (LO i = 0; i < n; ++i) {
     f2(first[i]);
   }
+#elif defined(OMEGA_H_USE_THREADS)
+  LO const n = LO(last - first);
+  threads::for_each_range(n, [&](LO begin, LO end, Int) {
+    for (LO i = begin; i < end; ++i) f2(first[i]);
+  });
 #else
   for (; first != last; ++first) {
     f2(*first);
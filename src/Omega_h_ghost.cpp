@@ -1,9 +1,12 @@
 #include "Omega_h_ghost.hpp"
 
+#include "Omega_h_array_ops.hpp"
 #include "Omega_h_for.hpp"
 #include "Omega_h_map.hpp"
+#include "Omega_h_mark.hpp"
 #include "Omega_h_mesh.hpp"
 #include "Omega_h_migrate.hpp"
+#include "Omega_h_unmap_mesh.hpp"
 
 namespace Omega_h {
 
@@ -130,6 +133,48 @@ void partition_by_verts(Mesh* mesh, bool verbose) {
   migrate_mesh(mesh, elems2owners, OMEGA_H_VERT_BASED, verbose);
 }
 
+/* the owner of every entity is a rank with an owned element adjacent
+   to it, as long as ownership was decided while the mesh was
+   element based, which is how ghost_mesh() and partition_by_verts()
+   leave it. then dropping the elements owned by other ranks, and
+   entities only they use, leaves a valid element-based mesh whose
+   owners only need their new indices. this checks that
+   assumption and returns which entities each rank keeps. */
+static bool mark_kept_ents(Mesh* mesh, Read<I8> kept[]) {
+  auto const dim = mesh->dim();
+  kept[dim] = mesh->owned(dim);
+  I8 orphans = 0;
+  for (Int ent_dim = 0; ent_dim <= dim; ++ent_dim) {
+    if (ent_dim < dim) {
+      kept[ent_dim] = mark_down(mesh->ask_up(ent_dim, dim), kept[dim]);
+    }
+    auto const ent_kept = kept[ent_dim];
+    auto const owned = mesh->owned(ent_dim);
+    auto const copy_kept =
+        mesh->reduce_array(ent_dim, ent_kept, 1, OMEGA_H_MAX);
+    Write<I8> orphaned(mesh->nents(ent_dim));
+    auto f = OMEGA_H_LAMBDA(LO ent) {
+      orphaned[ent] = owned[ent] && copy_kept[ent] && !ent_kept[ent];
+    };
+    parallel_for(mesh->nents(ent_dim), f, "mark_kept_ents");
+    orphans = max2(orphans, get_max(Read<I8>(orphaned)));
+  }
+  return mesh->comm()->allreduce(orphans, OMEGA_H_MAX) == 0;
+}
+
+void drop_ghosts(Mesh* mesh, bool verbose) {
+  Read<I8> kept[4];
+  if (!mark_kept_ents(mesh, kept)) {
+    partition_by_elems(mesh, verbose);
+    return;
+  }
+  LOs new_ents2old_ents[4];
+  for (Int ent_dim = 0; ent_dim <= mesh->dim(); ++ent_dim) {
+    new_ents2old_ents[ent_dim] = collect_marked(kept[ent_dim]);
+  }
+  unmap_mesh(mesh, new_ents2old_ents);
+}
+
 void partition_by_elems(Mesh* mesh, bool verbose) {
   auto dim = mesh->dim();
   auto all2owners = mesh->ask_owners(dim);
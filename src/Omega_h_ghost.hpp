@@ -28,6 +28,18 @@ void ghost_mesh(Mesh* mesh, Int nlayers, bool verbose);
 void partition_by_verts(Mesh* mesh, bool verbose);
 void partition_by_elems(Mesh* mesh, bool verbose);
 
+/* goes from ghosted or vertex-based partitioning back to element-based
+   without migrating: each rank drops the elements it does not own and
+   the entities only they use, and only the new indices of owned
+   entities are communicated. falls back to partition_by_elems()
+   if ownership does not allow that.
+   Mesh::set_parting(OMEGA_H_ELEM_BASED) uses it instead of
+   partition_by_elems() on meshes set to drop ghosts locally.
+   this only saves the migration back to element-based partitioning:
+   ghost layers are still built from scratch by ghost_mesh() each
+   time they are needed. */
+void drop_ghosts(Mesh* mesh, bool verbose);
+
 }  // end namespace Omega_h
 
 #endif
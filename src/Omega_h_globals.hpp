@@ -13,6 +13,7 @@ GOs rescan_globals(Mesh* mesh, Read<T> counts);
 #define OMEGA_H_INST_DECL(T) extern template GOs rescan_globals(Mesh*, Read<T>);
 OMEGA_H_INST_DECL(I8)
 OMEGA_H_INST_DECL(I32)
+OMEGA_H_INST_DECL(I64)
 #undef OMEGA_H_INST_DECL
 
 }  // end namespace Omega_h
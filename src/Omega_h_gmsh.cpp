@@ -1,16 +1,31 @@
 #include "Omega_h_file.hpp"
 
 #include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
 #include <fstream>
 #include <iomanip>
-#include <cctype>
+#include <limits>
 #include <sstream>
 #include <unordered_map>
 
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "Omega_h_array_ops.hpp"
 #include "Omega_h_build.hpp"
 #include "Omega_h_class.hpp"
+#include "Omega_h_dist.hpp"
 #include "Omega_h_element.hpp"
+#include "Omega_h_for.hpp"
+#include "Omega_h_linpart.hpp"
 #include "Omega_h_map.hpp"
+#include "Omega_h_profile.hpp"
 #include "Omega_h_vector.hpp"
 
 #ifdef OMEGA_H_USE_GMSH
@@ -94,384 +109,669 @@ Int gmsh_type(Omega_h_Family family, Int dim) {
   return -1;
 }
 
-void seek_line(std::istream& stream, std::string const& want) {
-  OMEGA_H_CHECK(stream);
+/* the whole file in memory. files are memory-mapped when possible,
+   so nothing is copied and the operating system pages the file in
+   as the parser walks through it. the last byte is always
+   whitespace, so number parsing can never run off the end. */
+class FileBuffer {
+ public:
+  explicit FileBuffer(std::istream& stream);
+  explicit FileBuffer(filesystem::path const& path);
+  ~FileBuffer();
+  FileBuffer(FileBuffer const&) = delete;
+  FileBuffer& operator=(FileBuffer const&) = delete;
+  char const* begin() const { return begin_; }
+  char const* end() const { return end_; }
+
+ private:
+  void copy_from(std::istream& stream);
+  std::string copy_;
+  void* mapping_ = nullptr;
+  std::size_t mapping_bytes_ = 0;
+  char const* begin_ = nullptr;
+  char const* end_ = nullptr;
+};
+
+FileBuffer::FileBuffer(std::istream& stream) { copy_from(stream); }
+
+FileBuffer::FileBuffer(filesystem::path const& path) {
+#if defined(__unix__) || defined(__APPLE__)
+  auto const fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) Omega_h_fail("couldn't open \"%s\"\n", path.c_str());
+  struct stat status;
+  if (::fstat(fd, &status) == 0 && status.st_size > 0) {
+    auto const bytes = std::size_t(status.st_size);
+    auto const data = ::mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data != MAP_FAILED) {
+      auto const chars = static_cast<char const*>(data);
+      if (std::isspace(static_cast<unsigned char>(chars[bytes - 1]))) {
+        ::madvise(data, bytes, MADV_SEQUENTIAL);
+        mapping_ = data;
+        mapping_bytes_ = bytes;
+        begin_ = chars;
+        end_ = chars + bytes;
+        ::close(fd);
+        return;
+      }
+      ::munmap(data, bytes);
+    }
+  }
+  ::close(fd);
+#endif
+  std::ifstream file(path.c_str(), std::ios::binary);
+  if (!file.is_open()) {
+    Omega_h_fail("couldn't open \"%s\"\n", path.c_str());
+  }
+  copy_from(file);
+}
+
+FileBuffer::~FileBuffer() {
+#if defined(__unix__) || defined(__APPLE__)
+  if (mapping_) ::munmap(mapping_, mapping_bytes_);
+#endif
+}
+
+void FileBuffer::copy_from(std::istream& stream) {
+  auto const start = stream.tellg();
+  stream.seekg(0, std::ios::end);
+  auto const stop = stream.tellg();
+  if (start >= 0 && stop >= start) {
+    copy_.resize(std::size_t(stop - start));
+    stream.seekg(start);
+    stream.read(&copy_[0], std::streamsize(copy_.size()));
+  } else {
+    stream.clear();
+    std::ostringstream contents;
+    contents << stream.rdbuf();
+    copy_ = contents.str();
+  }
+  copy_.push_back('\n');
+  begin_ = copy_.data();
+  end_ = begin_ + copy_.size();
+}
+
+struct Parser {
+  char const* begin;
+  char const* pos;
+  char const* end;
+  bool is_binary;
+  bool needs_swapping;
+  /* the size of binary node and element tags, which grew
+     from int to size_t in version 4.1 */
+  Int tag_bytes;
+};
+
+/* binary counts are size_t (4.1) or unsigned long (4.0) */
+constexpr Int binary_size_bytes = 8;
+
+[[noreturn]] void fail_parse(Parser const& p, char const* what) {
+  Omega_h_fail("gmsh: expected %s at byte %lld\n", what,
+      static_cast<long long>(p.pos - p.begin));
+}
+
+bool is_space(char c) {
+  return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+void skip_space(Parser& p) {
+  while (p.pos != p.end && is_space(*p.pos)) ++p.pos;
+}
+
+char const* find_line_end(char const* pos, char const* end) {
+  auto const newline = static_cast<char const*>(
+      std::memchr(pos, '\n', std::size_t(end - pos)));
+  return newline ? newline : end;
+}
+
+void skip_line(Parser& p) {
+  auto const line_end = find_line_end(p.pos, p.end);
+  p.pos = (line_end == p.end) ? p.end : line_end + 1;
+}
+
+bool next_line(Parser& p, std::string* line) {
+  if (p.pos == p.end) return false;
+  auto const line_end = find_line_end(p.pos, p.end);
+  auto content_end = line_end;
+  if (content_end != p.pos && content_end[-1] == '\r') --content_end;
+  line->assign(p.pos, content_end);
+  p.pos = (line_end == p.end) ? p.end : line_end + 1;
+  return true;
+}
+
+void seek_line(Parser& p, std::string const& want) {
+  std::string line;
+  while (next_line(p, &line)) {
+    if (line == want) return;
+  }
+  Omega_h_fail("gmsh: couldn't find \"%s\"\n", want.c_str());
+}
+
+bool seek_optional_section(Parser& p, std::string const& want) {
+  auto const start = p.pos;
   std::string line;
-  while (std::getline(stream, line)) {
-    if (line == want) {
+  while (next_line(p, &line)) {
+    if (line == want) return true;
+    if (!line.empty() && line[0] == '$' && line.compare(0, 4, "$End") != 0) {
+      // found the beginning of a new section that is not the one expected
       break;
     }
   }
-  OMEGA_H_CHECK(stream);
+  p.pos = start;
+  return false;
 }
 
-static bool seek_optional_section(
-    std::istream& stream, std::string const& want) {
-  OMEGA_H_CHECK(stream);
+/* the end of a section follows its data on the next line */
+void end_section(Parser& p, std::string const& want) {
+  skip_space(p);
   std::string line;
-  auto const pos = stream.tellg();
-  bool found = false;
-  while (std::getline(stream, line)) {
-    if (line == want) {
-      found = true;
-      break;
+  if (!next_line(p, &line) || line != want) fail_parse(p, want.c_str());
+}
+
+I64 parse_int(Parser& p) {
+  skip_space(p);
+  auto s = p.pos;
+  bool negative = false;
+  if (s != p.end && (*s == '-' || *s == '+')) negative = (*s++ == '-');
+  auto const digits = s;
+  I64 value = 0;
+  while (s != p.end && '0' <= *s && *s <= '9') value = value * 10 + (*s++ - '0');
+  if (s == digits) fail_parse(p, "an integer");
+  p.pos = s;
+  return negative ? -value : value;
+}
+
+Real parse_real(Parser& p) {
+  skip_space(p);
+  if (p.pos == p.end) fail_parse(p, "a real number");
+  char* stop;
+  auto const value = std::strtod(p.pos, &stop);
+  if (stop == p.pos) fail_parse(p, "a real number");
+  p.pos = stop;
+  return value;
+}
+
+std::string parse_quoted(Parser& p) {
+  skip_space(p);
+  if (p.pos == p.end || *p.pos != '"') fail_parse(p, "a quoted name");
+  auto const first = p.pos + 1;
+  auto const line_end = find_line_end(first, p.end);
+  auto const last =
+      static_cast<char const*>(std::memchr(first, '"', std::size_t(line_end - first)));
+  if (!last) fail_parse(p, "a closing quote");
+  p.pos = last + 1;
+  return std::string(first, last);
+}
+
+template <typename T>
+T read_binary(Parser& p) {
+  if (std::size_t(p.end - p.pos) < sizeof(T)) fail_parse(p, "more binary data");
+  T value;
+  std::memcpy(&value, p.pos, sizeof(T));
+  p.pos += sizeof(T);
+  if (p.needs_swapping) binary::swap_bytes(value);
+  return value;
+}
+
+I64 read_int(Parser& p, Int nbytes) {
+  if (!p.is_binary) return parse_int(p);
+  if (nbytes == 8) return read_binary<I64>(p);
+  return read_binary<I32>(p);
+}
+
+Int read_int(Parser& p) { return Int(read_int(p, 4)); }
+
+I64 read_size(Parser& p) { return read_int(p, binary_size_bytes); }
+
+I64 read_tag(Parser& p) { return read_int(p, p.tag_bytes); }
+
+Real read_real(Parser& p) {
+  return p.is_binary ? read_binary<Real>(p) : parse_real(p);
+}
+
+/* reads (n) consecutive binary integers of (nbytes) each */
+void read_binary_ints(Parser& p, Int nbytes, std::size_t n, I64* out) {
+  if (std::size_t(p.end - p.pos) < n * std::size_t(nbytes)) {
+    fail_parse(p, "more binary data");
+  }
+  if (nbytes == 8) {
+    std::memcpy(out, p.pos, n * 8);
+    if (p.needs_swapping) {
+      for (std::size_t i = 0; i < n; ++i) binary::swap_bytes(out[i]);
     }
-    if (!line.empty() && line.rfind("$End") != 0 && line[0] == '$') {
-      // found the beginning of a new section that is not the one expected
-      break;
+  } else {
+    for (std::size_t i = 0; i < n; ++i) {
+      I32 value;
+      std::memcpy(&value, p.pos + i * 4, 4);
+      if (p.needs_swapping) binary::swap_bytes(value);
+      out[i] = value;
     }
   }
-  if (!found) {
-    stream.clear();
-    stream.seekg(pos);
+  p.pos += n * std::size_t(nbytes);
+}
+
+void read_binary_reals(Parser& p, std::size_t n, Real* out) {
+  if (std::size_t(p.end - p.pos) < n * sizeof(Real)) {
+    fail_parse(p, "more binary data");
+  }
+  std::memcpy(out, p.pos, n * sizeof(Real));
+  if (p.needs_swapping) {
+    for (std::size_t i = 0; i < n; ++i) binary::swap_bytes(out[i]);
   }
-  OMEGA_H_CHECK(stream);
-  return found;
+  p.pos += n * sizeof(Real);
+}
+
+/* runs (f) over [0, n) on the host, using OpenMP or pool threads
+   if enabled */
+template <typename F>
+void host_parallel_for(LO n, F const& f) {
+#if defined(OMEGA_H_USE_THREADS)
+  threads::for_each_range(n, [&](LO begin, LO end, Int) {
+    for (LO i = begin; i < end; ++i) f(i);
+  });
+#else
+#ifdef OMEGA_H_USE_OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+  for (LO i = 0; i < n; ++i) f(i);
+#endif
 }
 
-static void eat_newlines(std::istream& stream) {
-  while (stream.peek() == int('\n')) stream.get();
+/* splits off the next (n) lines of ASCII data and gives each
+   to (parse_line) with a Parser of its own, so that large node and
+   element blocks are parsed by all threads at once.
+   finding the line breaks is a fast sequential memchr() sweep. */
+template <typename F>
+void parse_lines(Parser& p, LO n, F const& parse_line) {
+  skip_space(p);
+  std::vector<char const*> starts(std::size_t(n) + 1);
+  auto pos = p.pos;
+  for (LO i = 0; i < n; ++i) {
+    if (pos == p.end) fail_parse(p, "more lines");
+    starts[std::size_t(i)] = pos;
+    auto const line_end = find_line_end(pos, p.end);
+    pos = (line_end == p.end) ? p.end : line_end + 1;
+  }
+  starts[std::size_t(n)] = pos;
+  p.pos = pos;
+  host_parallel_for(n, [&](LO i) {
+    auto line = p;
+    line.pos = starts[std::size_t(i)];
+    line.end = starts[std::size_t(i) + 1];
+    parse_line(i, line);
+  });
 }
 
-template <class T>
-static void read(
-    std::istream& stream, T& value, bool is_binary, bool needs_swapping) {
-  if (is_binary) {
-    binary::read_value(stream, value, needs_swapping);
+/* maps gmsh node tags to node indices. gmsh usually numbers nodes
+   densely from one, in which case a flat array does the job,
+   and a hash table takes care of sparse numberings. */
+class NodeTagMap {
+ public:
+  explicit NodeTagMap(std::vector<I64> const& tags);
+  LO operator()(I64 tag) const {
+    if (is_dense_) {
+      auto const i = tag - min_tag_;
+      if (0 <= i && i < I64(dense_.size()) && dense_[std::size_t(i)] >= 0) {
+        return dense_[std::size_t(i)];
+      }
+    } else {
+      auto const it = sparse_.find(tag);
+      if (it != sparse_.end()) return it->second;
+    }
+    Omega_h_fail("gmsh: element refers to missing node %lld\n",
+        static_cast<long long>(tag));
+  }
+
+ private:
+  bool is_dense_ = true;
+  I64 min_tag_ = 0;
+  std::vector<LO> dense_;
+  std::unordered_map<I64, LO> sparse_;
+};
+
+NodeTagMap::NodeTagMap(std::vector<I64> const& tags) {
+  if (tags.empty()) return;
+  auto const minmax = std::minmax_element(tags.begin(), tags.end());
+  min_tag_ = *minmax.first;
+  auto const range = *minmax.second - min_tag_ + 1;
+  auto const n = LO(tags.size());
+  is_dense_ = (range <= 2 * I64(n) + 1024);
+  if (is_dense_) {
+    dense_.assign(std::size_t(range), -1);
+    for (LO i = 0; i < n; ++i) {
+      dense_[std::size_t(tags[std::size_t(i)] - min_tag_)] = i;
+    }
   } else {
-    stream >> value;
+    sparse_.reserve(std::size_t(n));
+    for (LO i = 0; i < n; ++i) sparse_[tags[std::size_t(i)]] = i;
+  }
+}
+
+std::vector<std::string> read_physical_names(Parser& p) {
+  std::vector<std::string> physical_names;
+  // this section is ASCII even in binary files
+  auto const num_physicals = parse_int(p);
+  physical_names.reserve(static_cast<std::size_t>(num_physicals));
+  for (I64 i = 0; i < num_physicals; ++i) {
+    parse_int(p);  // dim
+    auto const number = parse_int(p);
+    OMEGA_H_CHECK(number == i + 1);
+    physical_names.push_back(parse_quoted(p));
   }
+  return physical_names;
 }
 
-static void read_internal_entities_section(Mesh& mesh, Real format,
-    std::vector<std::string>& physical_names, std::istream& stream,
-    bool is_binary, bool needs_swapping) {
-  Int num_points, num_curves, num_surfaces, num_volumes;
-  read(stream, num_points, is_binary, needs_swapping);
-  read(stream, num_curves, is_binary, needs_swapping);
-  read(stream, num_surfaces, is_binary, needs_swapping);
-  read(stream, num_volumes, is_binary, needs_swapping);
+void read_entities_section(Mesh& mesh, Real format,
+    std::vector<std::string> const& physical_names, Parser& p) {
+  auto num_points = read_size(p);
+  auto num_curves = read_size(p);
+  auto num_surfaces = read_size(p);
+  auto num_volumes = read_size(p);
   while (num_points-- > 0) {
-    Int tag;
-    Vector<3> point;
-    Int num_physicals;
-    read(stream, tag, is_binary, needs_swapping);
-    read(stream, point[0], is_binary, needs_swapping);
-    read(stream, point[1], is_binary, needs_swapping);
-    read(stream, point[2], is_binary, needs_swapping);
-    if (format == 4.0) {
-      // strangely, the point is specified twice in 4.0, not 4.1
-      read(stream, point[0], is_binary, needs_swapping);
-      read(stream, point[1], is_binary, needs_swapping);
-      read(stream, point[2], is_binary, needs_swapping);
-    }
-    read(stream, num_physicals, is_binary, needs_swapping);
+    auto const tag = read_int(p);
+    // strangely, the point is specified twice in 4.0, not 4.1
+    auto const ncoords = (format == 4.0) ? 6 : 3;
+    for (Int i = 0; i < ncoords; ++i) read_real(p);
+    auto num_physicals = read_size(p);
     while (num_physicals-- > 0) {
-      Int physical;
-      read(stream, physical, is_binary, needs_swapping);
+      auto const physical = read_int(p);
       OMEGA_H_CHECK(physical != 0);
       if (physical > 0) {
-        const auto& physicalname = physical_names[physical - 1];
-        mesh.class_sets[physicalname].emplace_back(0, tag);
+        const auto& physical_name = physical_names[std::size_t(physical - 1)];
+        mesh.class_sets[physical_name].emplace_back(0, tag);
       }
     }
   }
-  const std::vector<std::pair<Int, Int>> params{
-      {num_curves, 2}, {num_surfaces, 2}, {num_volumes, 3}};
+  const std::vector<std::pair<I64, Int>> params{
+      {num_curves, 1}, {num_surfaces, 2}, {num_volumes, 3}};
   for (auto param : params) {
     auto num_elements = param.first;
     const auto dim = param.second;
     while (num_elements-- > 0) {
-      Int tag;
-      Vector<3> min_point, max_point;
-      Int num_physicals;
-      read(stream, tag, is_binary, needs_swapping);
-      read(stream, min_point[0], is_binary, needs_swapping);
-      read(stream, min_point[1], is_binary, needs_swapping);
-      read(stream, min_point[2], is_binary, needs_swapping);
-      read(stream, max_point[0], is_binary, needs_swapping);
-      read(stream, max_point[1], is_binary, needs_swapping);
-      read(stream, max_point[2], is_binary, needs_swapping);
-      read(stream, num_physicals, is_binary, needs_swapping);
+      auto const tag = read_int(p);
+      for (Int i = 0; i < 6; ++i) read_real(p);  // bounding box
+      auto num_physicals = read_size(p);
       while (num_physicals-- > 0) {
-        Int physical;
-        read(stream, physical, is_binary, needs_swapping);
+        auto const physical = read_int(p);
         OMEGA_H_CHECK(physical != 0);
         if (physical > 0) {
-          const auto& physical_name = physical_names[physical - 1];
+          const auto& physical_name =
+              physical_names[std::size_t(physical - 1)];
           mesh.class_sets[physical_name].emplace_back(dim, tag);
         }
       }
-      Int num_bounding_points;
-      read(stream, num_bounding_points, is_binary, needs_swapping);
-      while (num_bounding_points-- > 0) {
-        Int points_tag;
-        read(stream, points_tag, is_binary, needs_swapping);
-      }
+      auto num_bounding_points = read_size(p);
+      while (num_bounding_points-- > 0) read_int(p);
     }
   }
+  end_section(p, "$EndEntities");
 }
 
-void read_internal(std::istream& stream, Mesh* mesh) {
-  seek_line(stream, "$MeshFormat");
-  Real format;
-  Int file_type;
-  Int data_size;
-  stream >> format >> file_type >> data_size;
-  OMEGA_H_CHECK(file_type == 0 || file_type == 1);
-  bool is_binary = (file_type == 1);
-  bool needs_swapping = false;
-  if (is_binary) {
-    eat_newlines(stream);
-    int one;
-    binary::read_value(stream, one, false);
-    if (one != 1) {
-      needs_swapping = true;
-      binary::swap_bytes(one);
-      OMEGA_H_CHECK(one == 1);
-    }
+/* node tags and coordinates of a $Nodes section, three per node */
+struct Nodes {
+  std::vector<I64> tags;
+  std::vector<Real> coords;
+};
+
+Nodes read_nodes_4(Parser& p, Real format) {
+  auto const num_entity_blocks = read_size(p);
+  auto const nnodes = read_size(p);
+  if (format >= 4.1) {
+    read_size(p);  // min tag
+    read_size(p);  // max tag
   }
-  OMEGA_H_CHECK(data_size == sizeof(Real));
-  std::vector<std::string> physical_names;
-  if (seek_optional_section(stream, "$PhysicalNames")) {
-    Int num_physicals;
-    read(stream, num_physicals, is_binary, needs_swapping);
-    physical_names.reserve(static_cast<std::size_t>(num_physicals));
-    eat_newlines(stream);
-    for (auto i = 0; i < num_physicals; ++i) {
-      Int dim, number;
-      read(stream, dim, is_binary, needs_swapping);
-      read(stream, number, is_binary, needs_swapping);
-      OMEGA_H_CHECK(number == i + 1);
-      std::string name;
-      stream >> name;
-      physical_names.push_back(name.substr(1, name.size() - 2));
-    }
-  }
-  if (seek_optional_section(stream, "$Entities")) {
-    read_internal_entities_section(
-        *mesh, format, physical_names, stream, is_binary, needs_swapping);
-    std::string line;
-    std::getline(stream, line);
-    // line matches "[ ]*"
-    if (!line.empty()) {
-      line.erase(std::remove_if(line.begin(), line.end(),
-          [](unsigned char c) { return std::isspace(c); }));
-    }
-    OMEGA_H_CHECK(line.empty());
-    std::getline(stream, line);
-    OMEGA_H_CHECK(line == "$EndEntities");
-  }
-  seek_line(stream, "$Nodes");
-  std::vector<Vector<3>> node_coords;
-  std::map<int, int> node_number_map;
-  int nnodes;
-  if (format >= 4.0) {
-    eat_newlines(stream);
-    int num_entity_blocks;
-    read(stream, num_entity_blocks, is_binary, needs_swapping);
-    read(stream, nnodes, is_binary, needs_swapping);
-    node_coords.reserve(std::size_t(nnodes));
+  Nodes nodes;
+  nodes.tags.resize(std::size_t(nnodes));
+  nodes.coords.resize(std::size_t(nnodes) * 3);
+  std::size_t offset = 0;
+  for (I64 entity_block = 0; entity_block < num_entity_blocks;
+       ++entity_block) {
+    Int class_dim, class_id;
     if (format >= 4.1) {
-      int node_tag;
-      read(stream, node_tag, is_binary, needs_swapping);  // min
-      read(stream, node_tag, is_binary, needs_swapping);  // max
-      for (int entity_block = 0; entity_block < num_entity_blocks;
-           ++entity_block) {
-        int class_id, class_dim;
-        read(stream, class_dim, is_binary, needs_swapping);
-        read(stream, class_id, is_binary, needs_swapping);
-        int node_type, num_block_nodes;
-        read(stream, node_type, is_binary, needs_swapping);
-        read(stream, num_block_nodes, is_binary, needs_swapping);
-        for (int block_node = 0; block_node < num_block_nodes; ++block_node) {
-          int node_number;
-          read(stream, node_number, is_binary, needs_swapping);
-          const auto position = int(node_coords.size() + block_node);
-          node_number_map[node_number] = position;
-        }
-        for (int block_node = 0; block_node < num_block_nodes; ++block_node) {
-          Vector<3> coords;
-          read(stream, coords[0], is_binary, needs_swapping);
-          read(stream, coords[1], is_binary, needs_swapping);
-          read(stream, coords[2], is_binary, needs_swapping);
-          node_coords.push_back(coords);
-        }
-      }
-
+      class_dim = read_int(p);
+      class_id = read_int(p);
     } else {
-      for (int entity_block = 0; entity_block < num_entity_blocks;
-           ++entity_block) {
-        int class_id, class_dim;
-        read(stream, class_id, is_binary, needs_swapping);
-        read(stream, class_dim, is_binary, needs_swapping);
-        int node_type, num_block_nodes;
-        read(stream, node_type, is_binary, needs_swapping);
-        read(stream, num_block_nodes, is_binary, needs_swapping);
-        for (int block_node = 0; block_node < num_block_nodes; ++block_node) {
-          int node_number;
-          read(stream, node_number, is_binary, needs_swapping);
-          node_number_map[node_number] = int(node_coords.size());
-          Vector<3> coords;
-          read(stream, coords[0], is_binary, needs_swapping);
-          read(stream, coords[1], is_binary, needs_swapping);
-          read(stream, coords[2], is_binary, needs_swapping);
-          node_coords.push_back(coords);
-        }
-      }
+      class_id = read_int(p);
+      class_dim = read_int(p);
     }
-  } else {
-    stream >> nnodes;
-    OMEGA_H_CHECK(nnodes >= 0);
-    node_coords.reserve(std::size_t(nnodes));
-    eat_newlines(stream);
-    for (LO i = 0; i < nnodes; ++i) {
-      LO number;
-      read(stream, number, is_binary, needs_swapping);
-      // the documentation says numbers don't have to be linear,
-      // but so far they have been and assuming they are saves
-      // me a big lookup structure (e.g. std::map)
-      OMEGA_H_CHECK(number == i + 1);
-      Vector<3> coords;
-      read(stream, coords[0], is_binary, needs_swapping);
-      read(stream, coords[1], is_binary, needs_swapping);
-      read(stream, coords[2], is_binary, needs_swapping);
-      node_coords.push_back(coords);
-    }
-  }
-  seek_line(stream, "$Elements");
-  std::array<std::vector<int>, 4> ent_class_ids;
-  std::array<std::vector<int>, 4> ent_nodes;
-  Omega_h_Family family = OMEGA_H_SIMPLEX;
-  if (format >= 4.0) {
-    eat_newlines(stream);
-    int num_entity_blocks, total_num_ents;
-    read(stream, num_entity_blocks, is_binary, needs_swapping);
-    read(stream, total_num_ents, is_binary, needs_swapping);
-    if (format >= 4.1) {
-      int element_tag;
-      read(stream, element_tag, is_binary, needs_swapping);  // min
-      read(stream, element_tag, is_binary, needs_swapping);  // max
-    }
-    for (int entity_block = 0; entity_block < num_entity_blocks;
-         ++entity_block) {
-      int class_id, class_dim;
-      if (format == 4.) {
-        read(stream, class_id, is_binary, needs_swapping);
-        read(stream, class_dim, is_binary, needs_swapping);
+    (void)class_id;
+    auto const parametric = read_int(p);
+    auto const num_block_nodes = LO(read_size(p));
+    OMEGA_H_CHECK(offset + std::size_t(num_block_nodes) <= nodes.tags.size());
+    // parametric coordinates follow x, y and z, and are ignored
+    auto const ncoords = 3 + (parametric ? class_dim : 0);
+    auto const tags = nodes.tags.data() + offset;
+    auto const coords = nodes.coords.data() + offset * 3;
+    if (format >= 4.1 && p.is_binary) {
+      read_binary_ints(p, p.tag_bytes, std::size_t(num_block_nodes), tags);
+      if (ncoords == 3) {
+        read_binary_reals(p, std::size_t(num_block_nodes) * 3, coords);
       } else {
-        read(stream, class_dim, is_binary, needs_swapping);
-        read(stream, class_id, is_binary, needs_swapping);
-      }
-      int ent_type, num_block_ents;
-      read(stream, ent_type, is_binary, needs_swapping);
-      read(stream, num_block_ents, is_binary, needs_swapping);
-      Int dim = type_dim(ent_type);
-      OMEGA_H_CHECK(dim == class_dim);
-      if (type_family(ent_type) == OMEGA_H_HYPERCUBE) {
-        family = OMEGA_H_HYPERCUBE;
-      }
-      int nodes_per_ent = element_degree(family, dim, 0);
-      ent_class_ids[dim].reserve(
-          ent_class_ids[dim].size() + std::size_t(num_block_ents));
-      ent_nodes[dim].reserve(
-          ent_nodes[dim].size() + std::size_t(num_block_ents * nodes_per_ent));
-      for (int block_ent = 0; block_ent < num_block_ents; ++block_ent) {
-        ent_class_ids[dim].push_back(class_id);
-        int ent_number;
-        read(stream, ent_number, is_binary, needs_swapping);
-        for (int ent_node = 0; ent_node < nodes_per_ent; ++ent_node) {
-          int node_number;
-          read(stream, node_number, is_binary, needs_swapping);
-          auto it = node_number_map.find(node_number);
-          OMEGA_H_CHECK(it != node_number_map.end());
-          ent_nodes[dim].push_back(it->second);
+        for (LO i = 0; i < num_block_nodes; ++i) {
+          read_binary_reals(p, 3, coords + i * 3);
+          for (Int j = 3; j < ncoords; ++j) read_binary<Real>(p);
         }
       }
+    } else if (format >= 4.1) {
+      parse_lines(p, num_block_nodes,
+          [=](LO i, Parser& line) { tags[i] = parse_int(line); });
+      parse_lines(p, num_block_nodes, [=](LO i, Parser& line) {
+        for (Int j = 0; j < 3; ++j) coords[i * 3 + j] = parse_real(line);
+      });
+    } else if (p.is_binary) {
+      for (LO i = 0; i < num_block_nodes; ++i) {
+        tags[i] = read_tag(p);
+        read_binary_reals(p, 3, coords + i * 3);
+        for (Int j = 3; j < ncoords; ++j) read_binary<Real>(p);
+      }
+    } else {
+      parse_lines(p, num_block_nodes, [=](LO i, Parser& line) {
+        tags[i] = parse_int(line);
+        for (Int j = 0; j < 3; ++j) coords[i * 3 + j] = parse_real(line);
+      });
     }
+    offset += std::size_t(num_block_nodes);
+  }
+  OMEGA_H_CHECK(offset == nodes.tags.size());
+  return nodes;
+}
 
+Nodes read_nodes_2(Parser& p) {
+  // the number of nodes is ASCII even in binary files
+  auto const nnodes = LO(parse_int(p));
+  OMEGA_H_CHECK(nnodes >= 0);
+  Nodes nodes;
+  nodes.tags.resize(std::size_t(nnodes));
+  nodes.coords.resize(std::size_t(nnodes) * 3);
+  auto const tags = nodes.tags.data();
+  auto const coords = nodes.coords.data();
+  if (p.is_binary) {
+    skip_line(p);
+    for (LO i = 0; i < nnodes; ++i) {
+      tags[i] = read_binary<I32>(p);
+      read_binary_reals(p, 3, coords + i * 3);
+    }
   } else {
-    LO nents;
-    stream >> nents;
-    OMEGA_H_CHECK(nents >= 0);
-    std::array<std::unordered_map<Int, Int>, 4> ent2physical;
-    if (is_binary) {
-      eat_newlines(stream);
-      LO i = 0;
-      while (i < nents) {
-        I32 type, nfollow, ntags;
-        binary::read_value(stream, type, needs_swapping);
-        binary::read_value(stream, nfollow, needs_swapping);
-        binary::read_value(stream, ntags, needs_swapping);
-        Int dim = type_dim(type);
-        if (type_family(type) == OMEGA_H_HYPERCUBE) {
-          family = OMEGA_H_HYPERCUBE;
-        }
-        Int neev = element_degree(family, dim, 0);
-        OMEGA_H_CHECK(ntags >= 2);
-        for (Int j = 0; j < nfollow; ++j, ++i) {
-          I32 number, physical, elementary;
-          binary::read_value(stream, number, needs_swapping);
-          binary::read_value(stream, physical, needs_swapping);
-          binary::read_value(stream, elementary, needs_swapping);
-          ent_class_ids[dim].push_back(elementary);
-          if (physical != 0) {
-            ent2physical[dim].emplace(elementary, physical);
-          }
-          for (Int k = 2; k < ntags; ++k) {
-            I32 ignored;
-            binary::read_value(stream, ignored, false);
-          }
-          for (Int k = 0; k < neev; ++k) {
-            I32 node_number;
-            binary::read_value(stream, node_number, needs_swapping);
-            ent_nodes[dim].push_back(node_number - 1);
-          }
-        }
-      }
+    parse_lines(p, nnodes, [=](LO i, Parser& line) {
+      tags[i] = parse_int(line);
+      for (Int j = 0; j < 3; ++j) coords[i * 3 + j] = parse_real(line);
+    });
+  }
+  return nodes;
+}
+
+struct Elements {
+  Omega_h_Family family = OMEGA_H_SIMPLEX;
+  std::array<std::vector<LO>, 4> class_ids;
+  std::array<std::vector<LO>, 4> nodes;
+};
+
+Elements read_elements_4(Parser& p, Real format, NodeTagMap const& node_map) {
+  Elements elements;
+  auto const num_entity_blocks = read_size(p);
+  read_size(p);  // total number of elements
+  if (format >= 4.1) {
+    read_size(p);  // min tag
+    read_size(p);  // max tag
+  }
+  std::vector<I64> block_tags;
+  for (I64 entity_block = 0; entity_block < num_entity_blocks;
+       ++entity_block) {
+    Int class_id, class_dim;
+    if (format == 4.) {
+      class_id = read_int(p);
+      class_dim = read_int(p);
     } else {
-      for (LO i = 0; i < nents; ++i) {
-        LO number;
-        stream >> number;
-        OMEGA_H_CHECK(number > 0);
-        Int type;
-        stream >> type;
-        Int dim = type_dim(type);
-        if (type_family(type) == OMEGA_H_HYPERCUBE) family = OMEGA_H_HYPERCUBE;
-        Int ntags;
-        stream >> ntags;
-        OMEGA_H_CHECK(ntags >= 2);
-        Int physical, elementary;
-        stream >> physical >> elementary;
-        ent_class_ids[dim].push_back(elementary);
-        if (physical != 0) {
-          ent2physical[dim].emplace(elementary, physical);
+      class_dim = read_int(p);
+      class_id = read_int(p);
+    }
+    auto const ent_type = read_int(p);
+    auto const num_block_ents = LO(read_size(p));
+    Int dim = type_dim(ent_type);
+    OMEGA_H_CHECK(dim == class_dim);
+    auto const ent_family = type_family(ent_type);
+    if (ent_family == OMEGA_H_HYPERCUBE) elements.family = OMEGA_H_HYPERCUBE;
+    auto const nodes_per_ent = element_degree(ent_family, dim, 0);
+    auto& class_ids = elements.class_ids[dim];
+    auto& ent_nodes = elements.nodes[dim];
+    class_ids.resize(class_ids.size() + std::size_t(num_block_ents), class_id);
+    auto const first = ent_nodes.size();
+    ent_nodes.resize(first + std::size_t(num_block_ents * nodes_per_ent));
+    auto const out = ent_nodes.data() + first;
+    if (p.is_binary) {
+      // each element is its tag followed by its node tags
+      auto const stride = nodes_per_ent + 1;
+      block_tags.resize(std::size_t(num_block_ents * stride));
+      read_binary_ints(p, p.tag_bytes, block_tags.size(), block_tags.data());
+      auto const in = block_tags.data();
+      host_parallel_for(num_block_ents, [&](LO i) {
+        for (Int j = 0; j < nodes_per_ent; ++j) {
+          out[i * nodes_per_ent + j] = node_map(in[i * stride + 1 + j]);
         }
-        Int tag;
-        for (Int j = 2; j < ntags; ++j) {
-          stream >> tag;
+      });
+    } else {
+      parse_lines(p, num_block_ents, [&](LO i, Parser& line) {
+        parse_int(line);  // element tag
+        for (Int j = 0; j < nodes_per_ent; ++j) {
+          out[i * nodes_per_ent + j] = node_map(parse_int(line));
         }
-        Int neev = dim + 1;
-        LO node_number;
-        for (Int j = 0; j < neev; ++j) {
-          stream >> node_number;
-          ent_nodes[dim].push_back(node_number - 1);
+      });
+    }
+  }
+  return elements;
+}
+
+Elements read_elements_2(Parser& p, Mesh* mesh,
+    std::vector<std::string> const& physical_names,
+    NodeTagMap const& node_map) {
+  Elements elements;
+  // the number of elements is ASCII even in binary files
+  auto const nents = LO(parse_int(p));
+  OMEGA_H_CHECK(nents >= 0);
+  std::array<std::unordered_map<Int, Int>, 4> ent2physical;
+  auto add_element = [&](Int type, Int physical, Int elementary) {
+    Int dim = type_dim(type);
+    if (type_family(type) == OMEGA_H_HYPERCUBE) {
+      elements.family = OMEGA_H_HYPERCUBE;
+    }
+    elements.class_ids[dim].push_back(elementary);
+    if (physical != 0) ent2physical[dim].emplace(elementary, physical);
+    return dim;
+  };
+  if (p.is_binary) {
+    skip_line(p);
+    LO i = 0;
+    while (i < nents) {
+      auto const type = read_binary<I32>(p);
+      auto const nfollow = read_binary<I32>(p);
+      auto const ntags = read_binary<I32>(p);
+      OMEGA_H_CHECK(ntags >= 2);
+      for (Int j = 0; j < nfollow; ++j, ++i) {
+        read_binary<I32>(p);  // number
+        auto const physical = read_binary<I32>(p);
+        auto const elementary = read_binary<I32>(p);
+        auto const dim = add_element(type, physical, elementary);
+        for (Int k = 2; k < ntags; ++k) read_binary<I32>(p);
+        auto const neev = element_degree(type_family(type), dim, 0);
+        for (Int k = 0; k < neev; ++k) {
+          elements.nodes[dim].push_back(node_map(read_binary<I32>(p)));
         }
       }
     }
-    for (Int dim = 0; dim < static_cast<Int>(ent2physical.size()); ++dim) {
-      const auto& entities = ent2physical[dim];
-      for (const auto& pair : entities) {
-        const auto entity = pair.first;
-        const auto physical = pair.second;
-        std::string physical_name(std::to_string(physical));
-        if (physical <= static_cast<Int>(physical_names.size())) {
-          physical_name = physical_names[physical - 1];
-        }
-        mesh->class_sets[physical_name].emplace_back(dim, entity);
+  } else {
+    for (LO i = 0; i < nents; ++i) {
+      auto const number = parse_int(p);
+      OMEGA_H_CHECK(number > 0);
+      auto const type = Int(parse_int(p));
+      auto const ntags = Int(parse_int(p));
+      OMEGA_H_CHECK(ntags >= 2);
+      auto const physical = Int(parse_int(p));
+      auto const elementary = Int(parse_int(p));
+      auto const dim = add_element(type, physical, elementary);
+      for (Int j = 2; j < ntags; ++j) parse_int(p);
+      auto const neev = element_degree(type_family(type), dim, 0);
+      for (Int j = 0; j < neev; ++j) {
+        elements.nodes[dim].push_back(node_map(parse_int(p)));
       }
     }
   }
+  for (Int dim = 0; dim < static_cast<Int>(ent2physical.size()); ++dim) {
+    const auto& entities = ent2physical[dim];
+    for (const auto& pair : entities) {
+      const auto entity = pair.first;
+      const auto physical = pair.second;
+      std::string physical_name(std::to_string(physical));
+      if (physical <= static_cast<Int>(physical_names.size())) {
+        physical_name = physical_names[std::size_t(physical - 1)];
+      }
+      mesh->class_sets[physical_name].emplace_back(dim, entity);
+    }
+  }
+  return elements;
+}
+
+/* reads the $MeshFormat section and sets up (p) accordingly */
+Real read_mesh_format(Parser& p) {
+  seek_line(p, "$MeshFormat");
+  auto const format = parse_real(p);
+  auto const file_type = parse_int(p);
+  auto const data_size = parse_int(p);
+  OMEGA_H_CHECK(file_type == 0 || file_type == 1);
+  p.is_binary = (file_type == 1);
+  if (p.is_binary) {
+    skip_line(p);
+    auto one = read_binary<I32>(p);
+    if (one != 1) {
+      p.needs_swapping = true;
+      binary::swap_bytes(one);
+      OMEGA_H_CHECK(one == 1);
+    }
+  }
+  OMEGA_H_CHECK(data_size == sizeof(Real));
+  if (format >= 4.1) p.tag_bytes = 8;
+  return format;
+}
+
+void read_internal(FileBuffer const& buffer, Mesh* mesh) {
+  Parser p{buffer.begin(), buffer.begin(), buffer.end(), false, false, 4};
+  auto const format = read_mesh_format(p);
+  std::vector<std::string> physical_names;
+  if (seek_optional_section(p, "$PhysicalNames")) {
+    physical_names = read_physical_names(p);
+  }
+  if (seek_optional_section(p, "$Entities")) {
+    read_entities_section(*mesh, format, physical_names, p);
+  }
+  seek_line(p, "$Nodes");
+  auto const nodes = (format >= 4.0) ? read_nodes_4(p, format) : read_nodes_2(p);
+  auto const nnodes = LO(nodes.tags.size());
+  NodeTagMap const node_map(nodes.tags);
+  seek_line(p, "$Elements");
+  auto const elements = (format >= 4.0)
+                            ? read_elements_4(p, format, node_map)
+                            : read_elements_2(p, mesh, physical_names, node_map);
+  auto const family = elements.family;
+  auto const& ent_class_ids = elements.class_ids;
+  auto const& ent_nodes = elements.nodes;
   Int max_dim;
   if (ent_nodes[3].size()) {
     max_dim = 3;
@@ -486,14 +786,14 @@ void read_internal(std::istream& stream, Mesh* mesh) {
   for (LO i = 0; i < nnodes; ++i) {
     for (Int j = 0; j < max_dim; ++j) {
       host_coords[i * max_dim + j] =
-          node_coords[static_cast<std::size_t>(i)][j];
+          nodes.coords[static_cast<std::size_t>(i * 3 + j)];
     }
   }
   for (Int ent_dim = max_dim; ent_dim >= 0; --ent_dim) {
     Int neev = element_degree(family, ent_dim, VERT);
     LO ndim_ents = static_cast<LO>(ent_nodes[ent_dim].size()) / neev;
     HostWrite<LO> host_ev2v(ndim_ents * neev);
-    HostWrite<LO> host_class_id(ndim_ents);
+    HostWrite<ClassId> host_class_id(ndim_ents);
     for (LO i = 0; i < ndim_ents; ++i) {
       for (Int j = 0; j < neev; ++j) {
         host_ev2v[i * neev + j] =
@@ -511,12 +811,491 @@ void read_internal(std::istream& stream, Mesh* mesh) {
   finalize_classification(mesh);
 }
 
+/* the sliced reader has every rank parse one contiguous slice of the
+   nodes and one of the elements, so no rank ever holds the whole mesh.
+   all ranks read the block headers to find their slices: binary blocks
+   are skipped over directly, ASCII ones are scanned for line breaks,
+   which is still much cheaper than parsing them. */
+
+void skip_lines(Parser& p, GO n) {
+  if (n == 0) return;
+  skip_space(p);
+  for (GO i = 0; i < n; ++i) {
+    if (p.pos == p.end) fail_parse(p, "more lines");
+    skip_line(p);
+  }
+}
+
+void skip_binary(Parser& p, GO nbytes) {
+  if (p.end - p.pos < nbytes) fail_parse(p, "more binary data");
+  p.pos += nbytes;
+}
+
+template <typename T>
+Read<T> to_array(std::vector<T> const& v) {
+  HostWrite<T> h(LO(v.size()));
+  for (LO i = 0; i < h.size(); ++i) h[i] = v[std::size_t(i)];
+  return h.write();
+}
+
+struct Range {
+  GO begin;
+  GO end;
+};
+
+/* the part of a block of (n) items, the first of which is item (offset)
+   overall, that falls into the slice [slice_begin, slice_end) */
+Range overlap(GO offset, GO n, GO slice_begin, GO slice_end) {
+  Range range;
+  range.begin = std::min(std::max(slice_begin - offset, GO(0)), n);
+  range.end = std::min(std::max(slice_end - offset, GO(0)), n);
+  return range;
+}
+
+/* nodes [begin, begin + tags.size()) of a $Nodes section, in file order */
+struct NodeSlice {
+  GO nglobal;
+  GO begin;
+  std::vector<I64> tags;
+  std::vector<Real> coords;
+};
+
+void read_binary_coords(Parser& p, Int ncoords, LO n, Real* coords) {
+  if (ncoords == 3) {
+    read_binary_reals(p, std::size_t(n) * 3, coords);
+    return;
+  }
+  for (LO i = 0; i < n; ++i) {
+    read_binary_reals(p, 3, coords + i * 3);
+    for (Int j = 3; j < ncoords; ++j) read_binary<Real>(p);
+  }
+}
+
+NodeSlice read_node_slice(Parser& p, Real format, CommPtr comm) {
+  NodeSlice nodes;
+  auto const num_entity_blocks = read_size(p);
+  nodes.nglobal = read_size(p);
+  if (format >= 4.1) {
+    read_size(p);  // min tag
+    read_size(p);  // max tag
+  }
+  GO end;
+  suggest_slices(
+      nodes.nglobal, comm->size(), comm->rank(), &nodes.begin, &end);
+  nodes.tags.resize(std::size_t(end - nodes.begin));
+  nodes.coords.resize(nodes.tags.size() * 3);
+  GO offset = 0;
+  for (I64 entity_block = 0; entity_block < num_entity_blocks;
+       ++entity_block) {
+    Int class_dim;
+    if (format >= 4.1) {
+      class_dim = read_int(p);
+      read_int(p);  // class id
+    } else {
+      read_int(p);  // class id
+      class_dim = read_int(p);
+    }
+    auto const parametric = read_int(p);
+    auto const n = GO(read_size(p));
+    auto const ncoords = 3 + (parametric ? class_dim : 0);
+    auto const range = overlap(offset, n, nodes.begin, end);
+    auto const k = range.begin;
+    auto const m = LO(range.end - range.begin);
+    auto const rest = n - range.end;
+    auto const first = std::size_t(offset + k - nodes.begin);
+    auto const tags = nodes.tags.data() + (m ? first : 0);
+    auto const coords = nodes.coords.data() + (m ? first * 3 : 0);
+    auto const coord_bytes = GO(ncoords) * GO(sizeof(Real));
+    if (format >= 4.1 && p.is_binary) {
+      // all tags of the block come first, then all coordinates
+      skip_binary(p, k * p.tag_bytes);
+      read_binary_ints(p, p.tag_bytes, std::size_t(m), tags);
+      skip_binary(p, rest * p.tag_bytes + k * coord_bytes);
+      read_binary_coords(p, ncoords, m, coords);
+      skip_binary(p, rest * coord_bytes);
+    } else if (format >= 4.1) {
+      skip_lines(p, k);
+      parse_lines(p, m, [=](LO i, Parser& line) { tags[i] = parse_int(line); });
+      skip_lines(p, rest + k);
+      parse_lines(p, m, [=](LO i, Parser& line) {
+        for (Int j = 0; j < 3; ++j) coords[i * 3 + j] = parse_real(line);
+      });
+      skip_lines(p, rest);
+    } else if (p.is_binary) {
+      auto const node_bytes = p.tag_bytes + coord_bytes;
+      skip_binary(p, k * node_bytes);
+      for (LO i = 0; i < m; ++i) {
+        tags[i] = read_tag(p);
+        read_binary_coords(p, ncoords, 1, coords + i * 3);
+      }
+      skip_binary(p, rest * node_bytes);
+    } else {
+      skip_lines(p, k);
+      parse_lines(p, m, [=](LO i, Parser& line) {
+        tags[i] = parse_int(line);
+        for (Int j = 0; j < 3; ++j) coords[i * 3 + j] = parse_real(line);
+      });
+      skip_lines(p, rest);
+    }
+    offset += n;
+  }
+  OMEGA_H_CHECK(offset == nodes.nglobal);
+  return nodes;
+}
+
+struct ElementBlock {
+  Int dim;
+  ClassId class_id;
+  Int type;
+  GO nents;
+  char const* data;
+};
+
+std::vector<ElementBlock> read_element_blocks(Parser& p, Real format) {
+  auto const num_entity_blocks = read_size(p);
+  read_size(p);  // total number of elements
+  if (format >= 4.1) {
+    read_size(p);  // min tag
+    read_size(p);  // max tag
+  }
+  std::vector<ElementBlock> blocks;
+  blocks.reserve(std::size_t(num_entity_blocks));
+  for (I64 entity_block = 0; entity_block < num_entity_blocks;
+       ++entity_block) {
+    ElementBlock block;
+    Int class_dim;
+    if (format == 4.) {
+      block.class_id = read_int(p);
+      class_dim = read_int(p);
+    } else {
+      class_dim = read_int(p);
+      block.class_id = read_int(p);
+    }
+    block.type = read_int(p);
+    block.nents = GO(read_size(p));
+    block.dim = type_dim(block.type);
+    OMEGA_H_CHECK(block.dim == class_dim);
+    block.data = p.pos;
+    if (p.is_binary) {
+      // each element is its tag followed by its node tags
+      auto const stride =
+          element_degree(type_family(block.type), block.dim, VERT) + 1;
+      skip_binary(p, block.nents * stride * p.tag_bytes);
+    } else {
+      skip_lines(p, block.nents);
+    }
+    blocks.push_back(block);
+  }
+  return blocks;
+}
+
+/* appends the node tags of elements [range.begin, range.end) of (block) */
+void read_element_range(Parser p, ElementBlock const& block, Range range,
+    std::vector<I64>* node_tags) {
+  auto const nodes_per_ent =
+      element_degree(type_family(block.type), block.dim, VERT);
+  auto const n = LO(range.end - range.begin);
+  if (n == 0) return;
+  auto const first = node_tags->size();
+  node_tags->resize(first + std::size_t(n * nodes_per_ent));
+  auto const out = node_tags->data() + first;
+  p.pos = block.data;
+  if (p.is_binary) {
+    auto const stride = nodes_per_ent + 1;
+    skip_binary(p, range.begin * stride * p.tag_bytes);
+    std::vector<I64> in(std::size_t(n * stride));
+    read_binary_ints(p, p.tag_bytes, in.size(), in.data());
+    host_parallel_for(n, [&](LO i) {
+      for (Int j = 0; j < nodes_per_ent; ++j) {
+        out[i * nodes_per_ent + j] = in[std::size_t(i * stride + 1 + j)];
+      }
+    });
+  } else {
+    skip_lines(p, range.begin);
+    parse_lines(p, n, [&](LO i, Parser& line) {
+      parse_int(line);  // element tag
+      for (Int j = 0; j < nodes_per_ent; ++j) {
+        out[i * nodes_per_ent + j] = parse_int(line);
+      }
+    });
+  }
+}
+
+/* the global index of a node is its position in the file, since that is
+   how nodes are sliced. elements refer to nodes by tag, so the tags are
+   spread over the ranks by value and each rank looks up the ones
+   it needs there. unlike NodeTagMap, nothing here grows with
+   the range of the tags. */
+class NodeDirectory {
+ public:
+  NodeDirectory(CommPtr comm, NodeSlice const& nodes);
+  GOs operator()(std::vector<I64> const& tags) const;
+
+ private:
+  Dist to_directory(std::vector<I64> const& tags, GOs* keys) const;
+  CommPtr comm_;
+  I64 min_tag_;
+  I64 max_tag_;
+  /* (tag, global index) pairs of this rank, sorted by tag */
+  std::vector<std::pair<I64, GO>> entries_;
+};
+
+NodeDirectory::NodeDirectory(CommPtr comm, NodeSlice const& nodes)
+    : comm_(comm) {
+  auto min_tag = std::numeric_limits<I64>::max();
+  auto max_tag = std::numeric_limits<I64>::min();
+  for (auto tag : nodes.tags) {
+    min_tag = std::min(min_tag, tag);
+    max_tag = std::max(max_tag, tag);
+  }
+  min_tag_ = comm->allreduce(min_tag, OMEGA_H_MIN);
+  max_tag_ = comm->allreduce(max_tag, OMEGA_H_MAX);
+  GOs keys;
+  auto const dist = to_directory(nodes.tags, &keys);
+  auto const nslice = LO(nodes.tags.size());
+  auto const positions = GOs(nslice, nodes.begin, 1);
+  auto const dir_keys = HostRead<GO>(dist.exch(keys, 1));
+  auto const dir_positions = HostRead<GO>(dist.exch(positions, 1));
+  entries_.resize(std::size_t(dir_keys.size()));
+  for (LO i = 0; i < dir_keys.size(); ++i) {
+    entries_[std::size_t(i)] = {dir_keys[i] + min_tag_, dir_positions[i]};
+  }
+  std::sort(entries_.begin(), entries_.end());
+}
+
+/* each tag goes to the rank that owns (tag - min_tag) in a linear
+   partitioning of the tag range */
+Dist NodeDirectory::to_directory(
+    std::vector<I64> const& tags, GOs* keys) const {
+  auto const n = LO(tags.size());
+  HostWrite<GO> host_keys(n);
+  for (LO i = 0; i < n; ++i) {
+    auto const tag = tags[std::size_t(i)];
+    if (tag < min_tag_ || max_tag_ < tag) {
+      Omega_h_fail("gmsh: element refers to missing node %lld\n",
+          static_cast<long long>(tag));
+    }
+    host_keys[i] = tag - min_tag_;
+  }
+  *keys = GOs(host_keys.write());
+  auto const total = max_tag_ - min_tag_ + 1;
+  auto const owners = globals_to_linear_owners(comm_, *keys, total);
+  Dist dist;
+  dist.set_parent_comm(comm_);
+  dist.set_dest_ranks(owners.ranks);
+  return dist;
+}
+
+GOs NodeDirectory::operator()(std::vector<I64> const& tags) const {
+  GOs keys;
+  auto const dist = to_directory(tags, &keys);
+  auto const asked = HostRead<GO>(dist.exch(keys, 1));
+  HostWrite<GO> answers(asked.size());
+  for (LO i = 0; i < asked.size(); ++i) {
+    auto const tag = asked[i] + min_tag_;
+    auto const it = std::lower_bound(entries_.begin(), entries_.end(),
+        std::make_pair(tag, std::numeric_limits<GO>::min()));
+    if (it == entries_.end() || it->first != tag) {
+      Omega_h_fail("gmsh: element refers to missing node %lld\n",
+          static_cast<long long>(tag));
+    }
+    answers[i] = it->second;
+  }
+  return dist.invert().exch(GOs(answers.write()), 1);
+}
+
+/* the vertices of each entity in ascending order, which identifies
+   the entity whatever order they were given in */
+GOs sort_entity_verts(GOs ev2g, Int deg) {
+  Write<GO> out(ev2g.size());
+  auto f = OMEGA_H_LAMBDA(LO e) {
+    for (Int i = 0; i < deg; ++i) {
+      auto const g = ev2g[e * deg + i];
+      auto j = i;
+      for (; j > 0 && out[e * deg + j - 1] > g; --j) {
+        out[e * deg + j] = out[e * deg + j - 1];
+      }
+      out[e * deg + j] = g;
+    }
+  };
+  parallel_for(divide_no_remainder(ev2g.size(), deg), f, "sort_entity_verts");
+  return out;
+}
+
+/* sends each entity to the rank that owns its lowest vertex
+   in a linear partitioning of the vertices */
+Dist entities_to_lowest_verts(
+    CommPtr comm, GOs sorted_ev2g, Int deg, GO nglobal_verts) {
+  auto const lowest = get_component(sorted_ev2g, deg, 0);
+  auto const owners = globals_to_linear_owners(comm, lowest, nglobal_verts);
+  Dist dist;
+  dist.set_parent_comm(comm);
+  dist.set_dest_ranks(owners.ranks);
+  return dist;
+}
+
+/* the parallel counterpart of classify_equal_order(): the entities
+   of the file and those of the mesh meet at the owner of their
+   lowest vertex, where they are matched by their sorted vertices */
+void classify_sliced_equal_order(Mesh* mesh, Int ent_dim, GOs eqv2g,
+    Read<ClassId> eq_class_ids, GO nglobal_verts) {
+  auto const comm = mesh->comm();
+  auto const deg = element_degree(mesh->family(), ent_dim, VERT);
+  auto const eq_sorted = sort_entity_verts(eqv2g, deg);
+  auto const eq_dist =
+      entities_to_lowest_verts(comm, eq_sorted, deg, nglobal_verts);
+  auto const eq_verts = HostRead<GO>(eq_dist.exch(eq_sorted, deg));
+  auto const eq_ids = HostRead<ClassId>(eq_dist.exch(eq_class_ids, 1));
+  auto ev2g = mesh->globals(VERT);
+  if (ent_dim > VERT) ev2g = unmap(mesh->ask_verts_of(ent_dim), ev2g, 1);
+  auto const ents_sorted = sort_entity_verts(ev2g, deg);
+  auto const ents_dist =
+      entities_to_lowest_verts(comm, ents_sorted, deg, nglobal_verts);
+  auto const ents_verts = HostRead<GO>(ents_dist.exch(ents_sorted, deg));
+  auto const neq = eq_ids.size();
+  auto const nents = divide_no_remainder(ents_verts.size(), deg);
+  auto eq_less = [&](LO a, LO b) {
+    for (Int i = 0; i < deg; ++i) {
+      if (eq_verts[a * deg + i] != eq_verts[b * deg + i]) {
+        return eq_verts[a * deg + i] < eq_verts[b * deg + i];
+      }
+    }
+    return false;
+  };
+  std::vector<LO> order(static_cast<std::size_t>(neq));
+  for (LO i = 0; i < neq; ++i) order[std::size_t(i)] = i;
+  std::sort(order.begin(), order.end(), eq_less);
+  HostWrite<I8> host_class_dim(nents);
+  HostWrite<ClassId> host_class_id(nents);
+  for (LO e = 0; e < nents; ++e) {
+    auto ent_less = [&](LO eq, LO) {
+      for (Int i = 0; i < deg; ++i) {
+        if (eq_verts[eq * deg + i] != ents_verts[e * deg + i]) {
+          return eq_verts[eq * deg + i] < ents_verts[e * deg + i];
+        }
+      }
+      return false;
+    };
+    auto const it = std::lower_bound(order.begin(), order.end(), e, ent_less);
+    bool found = (it != order.end());
+    for (Int i = 0; found && i < deg; ++i) {
+      found = (eq_verts[*it * deg + i] == ents_verts[e * deg + i]);
+    }
+    host_class_dim[e] = I8(found ? ent_dim : mesh->dim());
+    host_class_id[e] = found ? eq_ids[*it] : -1;
+  }
+  auto const back = ents_dist.invert();
+  auto const class_dim = back.exch(Read<I8>(host_class_dim.write()), 1);
+  auto const class_id = back.exch(Read<ClassId>(host_class_id.write()), 1);
+  mesh->add_tag<I8>(ent_dim, "class_dim", 1, class_dim);
+  mesh->add_tag<ClassId>(ent_dim, "class_id", 1, class_id);
+}
+
+Mesh read_sliced_internal(FileBuffer const& buffer, CommPtr comm) {
+  Parser p{buffer.begin(), buffer.begin(), buffer.end(), false, false, 4};
+  auto const format = read_mesh_format(p);
+  if (format < 4.0) {
+    Omega_h_fail("gmsh: reading by slices needs format 4.0 or newer, not %g\n",
+        format);
+  }
+  Mesh mesh(comm->library());
+  // the physical groups are small, every rank reads them
+  std::vector<std::string> physical_names;
+  if (seek_optional_section(p, "$PhysicalNames")) {
+    physical_names = read_physical_names(p);
+  }
+  if (seek_optional_section(p, "$Entities")) {
+    read_entities_section(mesh, format, physical_names, p);
+  }
+  seek_line(p, "$Nodes");
+  auto const nodes = read_node_slice(p, format, comm);
+  seek_line(p, "$Elements");
+  auto const blocks = read_element_blocks(p, format);
+  Int dim = 0;
+  for (auto const& block : blocks) {
+    if (block.nents > 0) dim = std::max(dim, block.dim);
+  }
+  if (dim == 0) {
+    Omega_h_fail("There were no Elements of dimension higher than zero!\n");
+  }
+  /* elements of the mesh dimension are sliced over the ranks,
+     and so are the lower-dimensional ones which classify the rest */
+  GO nglobal_elems = 0;
+  GO nglobal_lower = 0;
+  auto family = OMEGA_H_SIMPLEX;
+  for (auto const& block : blocks) {
+    if (block.dim == dim) {
+      if (nglobal_elems == 0) family = type_family(block.type);
+      OMEGA_H_CHECK(type_family(block.type) == family);
+      nglobal_elems += block.nents;
+    } else {
+      nglobal_lower += block.nents;
+    }
+  }
+  GO elems_begin, elems_end, lower_begin, lower_end;
+  suggest_slices(
+      nglobal_elems, comm->size(), comm->rank(), &elems_begin, &elems_end);
+  suggest_slices(
+      nglobal_lower, comm->size(), comm->rank(), &lower_begin, &lower_end);
+  std::array<std::vector<I64>, 4> node_tags;
+  std::array<std::vector<ClassId>, 4> class_ids;
+  GO elems_offset = 0;
+  GO lower_offset = 0;
+  for (auto const& block : blocks) {
+    auto& offset = (block.dim == dim) ? elems_offset : lower_offset;
+    auto const range = (block.dim == dim)
+                           ? overlap(offset, block.nents, elems_begin, elems_end)
+                           : overlap(offset, block.nents, lower_begin, lower_end);
+    read_element_range(p, block, range, &node_tags[block.dim]);
+    auto& ids = class_ids[block.dim];
+    ids.resize(ids.size() + std::size_t(range.end - range.begin), block.class_id);
+    offset += block.nents;
+  }
+  NodeDirectory const node_directory(comm, nodes);
+  auto const slice_conn = node_directory(node_tags[dim]);
+  auto const nslice_nodes = LO(nodes.tags.size());
+  HostWrite<Real> host_coords(nslice_nodes * dim);
+  for (LO i = 0; i < nslice_nodes; ++i) {
+    for (Int j = 0; j < dim; ++j) {
+      host_coords[i * dim + j] = nodes.coords[std::size_t(i * 3 + j)];
+    }
+  }
+  auto const slice_coords = Reals(host_coords.write());
+  Dist slice_elems2elems;
+  Dist slice_verts2verts;
+  LOs conn;
+  assemble_slices(comm, family, dim, nglobal_elems, elems_begin, slice_conn,
+      nodes.nglobal, nodes.begin, slice_coords, &slice_elems2elems, &conn,
+      &slice_verts2verts);
+  auto const slice_node_globals = GOs(nslice_nodes, nodes.begin, 1);
+  auto const node_globals = slice_verts2verts.exch(slice_node_globals, 1);
+  build_from_elems2verts(&mesh, comm, family, dim, conn, node_globals);
+  auto const coords = slice_verts2verts.exch(slice_coords, dim);
+  mesh.add_tag(VERT, "coordinates", dim, coords);
+  auto const slice_class_ids = to_array(class_ids[dim]);
+  classify_elements(&mesh);
+  mesh.add_tag<ClassId>(dim, "class_id", 1,
+      slice_elems2elems.exch(slice_class_ids, 1));
+  for (Int ent_dim = dim - 1; ent_dim >= VERT; --ent_dim) {
+    auto const eqv2g = node_directory(node_tags[ent_dim]);
+    classify_sliced_equal_order(
+        &mesh, ent_dim, eqv2g, to_array(class_ids[ent_dim]), nodes.nglobal);
+  }
+  /* projecting the classification onto the remaining entities
+     needs all the elements around each of them */
+  mesh.set_parting(OMEGA_H_GHOSTED);
+  finalize_classification(&mesh);
+  mesh.set_parting(OMEGA_H_ELEM_BASED);
+  return mesh;
+}
+
 }  // end anonymous namespace
 
 Mesh read(std::istream& stream, CommPtr comm) {
   auto mesh = Mesh(comm->library());
   if (comm->rank() == 0) {
-    read_internal(stream, &mesh);
+    FileBuffer const buffer(stream);
+    read_internal(buffer, &mesh);
   }
   mesh.set_comm(comm);
   mesh.balance();
@@ -524,11 +1303,20 @@ Mesh read(std::istream& stream, CommPtr comm) {
 }
 
 Mesh read(filesystem::path const& filename, CommPtr comm) {
-  std::ifstream file(filename.c_str());
-  if (!file.is_open()) {
-    Omega_h_fail("couldn't open \"%s\"\n", filename.c_str());
+  auto mesh = Mesh(comm->library());
+  if (comm->rank() == 0) {
+    FileBuffer const buffer(filename);
+    read_internal(buffer, &mesh);
   }
-  return gmsh::read(file, comm);
+  mesh.set_comm(comm);
+  mesh.balance();
+  return mesh;
+}
+
+Mesh read_sliced(filesystem::path const& filename, CommPtr comm) {
+  ScopedTimer timer("gmsh::read_sliced");
+  FileBuffer const buffer(filename);
+  return read_sliced_internal(buffer, comm);
 }
 
 #ifdef OMEGA_H_USE_GMSH
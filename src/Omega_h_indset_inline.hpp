@@ -42,10 +42,38 @@ inline Read<I8> local_iteration(
   return new_state;
 }
 
+/* without ghost layers, each copy of an entity only sees the
+   neighbors it shares local elements with. since every element is
+   on some rank, every pair of neighbors meets on some rank, so an
+   entity is rejected if any copy rejects it and chosen only if
+   every copy chooses it */
+inline Read<I8> combine_copies(Mesh* mesh, Int dim, Read<I8> local_state) {
+  auto min_state = mesh->reduce_array(dim, local_state, 1, OMEGA_H_MIN);
+  auto max_state = mesh->reduce_array(dim, local_state, 1, OMEGA_H_MAX);
+  auto owned = mesh->owned(dim);
+  Write<I8> state(local_state.size());
+  auto f = OMEGA_H_LAMBDA(LO i) {
+    if (!owned[i]) {
+      state[i] = local_state[i];
+    } else if (min_state[i] == NOT_IN) {
+      state[i] = NOT_IN;
+    } else if (max_state[i] == IN) {
+      state[i] = IN;
+    } else {
+      state[i] = UNKNOWN;
+    }
+  };
+  parallel_for(state.size(), std::move(f));
+  return state;
+}
+
 template <class Compare>
 Read<I8> iteration(Mesh* mesh, Int dim, LOs xadj, LOs adj, Read<I8> old_state,
     Compare compare) {
   auto local_state = local_iteration(xadj, adj, old_state, compare);
+  if (!mesh->owners_have_all_upward(dim)) {
+    local_state = combine_copies(mesh, dim, local_state);
+  }
   auto synced_state = mesh->sync_array(dim, local_state, 1);
   return synced_state;
 }
@@ -21,6 +21,7 @@ LOs offset_scan(Read<T> a, std::string const& name) {
 
 template LOs offset_scan(Read<I8> a, std::string const& name);
 template LOs offset_scan(Read<I32> a, std::string const& name);
+template LOs offset_scan(Read<I64> a, std::string const& name);
 
 void fill_right(Write<LO> a) {
   OMEGA_H_TIME_FUNCTION;
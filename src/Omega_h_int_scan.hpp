@@ -10,6 +10,7 @@ LOs offset_scan(Read<T> a, std::string const& name = "");
 
 extern template LOs offset_scan(Read<I8> a, std::string const& name);
 extern template LOs offset_scan(Read<I32> a, std::string const& name);
+extern template LOs offset_scan(Read<I64> a, std::string const& name);
 
 /* given an array whose values are
    either non-negative or (-1), and whose
@@ -1,10 +1,18 @@
 #include <Omega_h_config.h>
+#include <Omega_h_arena.hpp>
+#include <Omega_h_array_ops.hpp>
 #include <Omega_h_cmdline.hpp>
 #include <Omega_h_library.hpp>
 #include <Omega_h_malloc.hpp>
+#include <Omega_h_mesh.hpp>
 #include <Omega_h_profile.hpp>
 #include <Omega_h_dbg.hpp>
 
+#ifdef OMEGA_H_USE_THREADS
+#include <Omega_h_threads.hpp>
+#include <thread>
+#endif
+
 #include <csignal>
 #include <cstdarg>
 #include <cstdlib>
@@ -94,8 +102,8 @@ void Library::initialize(char const* head_desc, int* argc, char*** argv
   self_ = CommPtr(new Comm(this, false, false));
 #endif
   Omega_h::CmdLine cmdline;
-  cmdline.add_flag(
-      "--osh-memory", "print amount and stacktrace of max memory use");
+  cmdline.add_flag("--osh-memory",
+      "print peak memory use of each profiled function and adapt phase");
   cmdline.add_flag(
       "--osh-time", "print amount of time spend in certain functions");
   cmdline.add_flag(
@@ -109,6 +117,25 @@ void Library::initialize(char const* head_desc, int* argc, char*** argv
   cmdline.add_flag("--osh-fpe", "enable floating-point exceptions");
   cmdline.add_flag("--osh-silent", "suppress all output");
   cmdline.add_flag("--osh-pool", "use memory pooling");
+  auto& pool_high_water_flag = cmdline.add_flag("--osh-pool-high-water",
+      "release pooled memory once more than this many megabytes are cached "
+      "(implies --osh-pool)");
+  pool_high_water_flag.add_arg<int>("megabytes");
+  cmdline.add_flag("--osh-pool-stats", "print memory pool statistics");
+  cmdline.add_flag(
+      "--osh-arena", "allocate adapt temporaries from reusable arenas");
+  cmdline.add_flag("--osh-repro",
+      "make global floating-point sums independent of thread and "
+      "rank counts");
+  auto& adj_budget_flag = cmdline.add_flag("--osh-adj-budget",
+      "drop least recently used derived adjacencies of a mesh "
+      "beyond this many megabytes");
+  adj_budget_flag.add_arg<int>("megabytes");
+#ifdef OMEGA_H_USE_THREADS
+  auto& threads_flag = cmdline.add_flag("--osh-threads",
+      "number of pool threads (default: $OMEGA_H_NUM_THREADS or all cores)");
+  threads_flag.add_arg<int>("nthreads");
+#endif
   auto& self_send_flag =
       cmdline.add_flag("--osh-self-send", "control self send threshold");
   self_send_flag.add_arg<int>("value");
@@ -131,6 +158,13 @@ void Library::initialize(char const* head_desc, int* argc, char*** argv
     Omega_h::profile::global_singleton_history =
       new Omega_h::profile::History(world_, true, chop, add_filename);
   }
+  if (cmdline.parsed("--osh-memory")) {
+    if (!Omega_h::profile::global_singleton_history) {
+      Omega_h::profile::global_singleton_history =
+        new Omega_h::profile::History(world_, false, chop, add_filename);
+    }
+    Omega_h::profile::global_singleton_history->track_memory = true;
+  }
   if (cmdline.parsed("--osh-fpe")) {
     enable_floating_point_exceptions();
   }
@@ -164,6 +198,16 @@ void Library::initialize(char const* head_desc, int* argc, char*** argv
     OMEGA_H_CHECK_OP(mpi_ranks_per_node, ==, ndevices_per_node);
     OMEGA_H_CHECK_OP(my_device, ==, local_mpi_rank);
   }
+#endif
+#ifdef OMEGA_H_USE_THREADS
+  int nthreads = int(std::thread::hardware_concurrency());
+  if (auto const env = std::getenv("OMEGA_H_NUM_THREADS")) {
+    nthreads = std::atoi(env);
+  }
+  if (cmdline.parsed("--osh-threads")) {
+    nthreads = cmdline.get<int>("--osh-threads", "nthreads");
+  }
+  threads::start((nthreads > 0) ? nthreads : 1);
 #endif
   if (cmdline.parsed("--osh-signal")) Omega_h::protect();
 #if defined(OMEGA_H_USE_CUDA) && (!defined(OMEGA_H_USE_KOKKOS))
@@ -171,12 +215,30 @@ void Library::initialize(char const* head_desc, int* argc, char*** argv
   // and prevent it from polluting later timings
   cudaFree(nullptr);
 #endif
-  if (cmdline.parsed("--osh-pool")) enable_pooling();
+  print_pool_stats_ = cmdline.parsed("--osh-pool-stats");
+  if (cmdline.parsed("--osh-pool") ||
+      cmdline.parsed("--osh-pool-high-water")) {
+    auto high_water_bytes = ~std::size_t(0);
+    if (cmdline.parsed("--osh-pool-high-water")) {
+      high_water_bytes = std::size_t(
+          cmdline.get<int>("--osh-pool-high-water", "megabytes")) *
+          1024 * 1024;
+    }
+    enable_pooling(high_water_bytes);
+  }
+  if (cmdline.parsed("--osh-arena")) enable_arenas();
+  if (cmdline.parsed("--osh-repro")) enable_repro_reductions();
+  if (cmdline.parsed("--osh-adj-budget")) {
+    set_default_adj_budget(
+        std::size_t(cmdline.get<int>("--osh-adj-budget", "megabytes")) * 1024 *
+        1024);
+  }
 }
 
 Library::Library(Library const& other)
     : world_(other.world_),
-      self_(other.self_)
+      self_(other.self_),
+      print_pool_stats_(other.print_pool_stats_)
 #ifdef OMEGA_H_USE_MPI
       ,
       we_called_mpi_init(other.we_called_mpi_init)
@@ -195,6 +257,10 @@ Library::~Library() {
       // FIXME - parallelize?
       Omega_h::profile::print_top_down_and_bottom_up(
           *Omega_h::profile::global_singleton_history, total_runtime);
+      if (Omega_h::profile::global_singleton_history->track_memory) {
+        Omega_h::profile::print_memory_timeline(
+            *Omega_h::profile::global_singleton_history);
+      }
     }
     Omega_h::profile::print_top_sorted(
           *Omega_h::profile::global_singleton_history, total_runtime);
@@ -202,9 +268,14 @@ Library::~Library() {
     Omega_h::profile::global_singleton_history = nullptr;
   }
   // need to destroy all Comm objects prior to MPI_Finalize()
+  if (print_pool_stats_ && world_->rank() == 0) print_pool_stats(std::cout);
   world_ = CommPtr();
   self_ = CommPtr();
+  disable_arenas();
   disable_pooling();
+#ifdef OMEGA_H_USE_THREADS
+  threads::stop();
+#endif
 #ifdef OMEGA_H_USE_KOKKOS
   if (we_called_kokkos_init) {
     Kokkos::finalize();
@@ -48,6 +48,7 @@ class Library {
   );
   CommPtr world_;
   CommPtr self_;
+  bool print_pool_stats_;
 #ifdef OMEGA_H_USE_MPI
   bool we_called_mpi_init;
 #endif
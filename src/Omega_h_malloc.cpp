@@ -3,6 +3,7 @@
 #include <Omega_h_pool.hpp>
 #include <Omega_h_profile.hpp>
 #include <cstdlib>
+#include <iostream>
 
 namespace Omega_h {
 
@@ -59,9 +60,9 @@ void host_free(void* ptr, std::size_t) {
 static Pool* device_pool = nullptr;
 static Pool* host_pool = nullptr;
 
-void enable_pooling() {
-  device_pool = new Pool(device_malloc, device_free);
-  host_pool = new Pool(host_malloc, host_free);
+void enable_pooling(std::size_t high_water_bytes) {
+  device_pool = new Pool(device_malloc, device_free, high_water_bytes);
+  host_pool = new Pool(host_malloc, host_free, high_water_bytes);
 }
 
 void disable_pooling() {
@@ -71,6 +72,17 @@ void disable_pooling() {
   host_pool = nullptr;
 }
 
+void print_pool_stats(std::ostream& stream) {
+  if (device_pool) {
+    stream << "device memory pool:\n";
+    print_stats(*device_pool, stream);
+  }
+  if (host_pool) {
+    stream << "host memory pool:\n";
+    print_stats(*host_pool, stream);
+  }
+}
+
 void* maybe_pooled_device_malloc(std::size_t size) {
   if (device_pool) return allocate(*device_pool, size);
   return device_malloc(size);
@@ -2,6 +2,7 @@
 #define OMEGA_H_MALLOC_HPP
 
 #include <cstddef>
+#include <iosfwd>
 
 namespace Omega_h {
 
@@ -10,8 +11,10 @@ void device_free(void* ptr, std::size_t size);
 void* host_malloc(std::size_t size);
 void host_free(void* ptr, std::size_t size);
 
-void enable_pooling();
+/* (high_water_bytes) bounds the free memory each pool may keep cached */
+void enable_pooling(std::size_t high_water_bytes = ~std::size_t(0));
 void disable_pooling();
+void print_pool_stats(std::ostream& stream);
 
 void* maybe_pooled_device_malloc(std::size_t size);
 void maybe_pooled_device_free(void* ptr, std::size_t size);
@@ -26,7 +26,7 @@ template <typename T>
 void map_into(Read<T> a_data, LOs a2b, Write<T> b_data, Int width) {
   OMEGA_H_TIME_FUNCTION;
   auto na = a2b.size();
-  OMEGA_H_CHECK_PRINTF(a_data.size() == na * width, "a_data.size= %d na= %d width= %d", a_data.size(), na, width);
+  OMEGA_H_CHECK_PRINTF(a_data.size() == na * width, "a_data.size= %ld na= %ld width= %d", long(a_data.size()), long(na), width);
   auto f = OMEGA_H_LAMBDA(LO a) {
     auto b = a2b[a];
     for (Int j = 0; j < width; ++j) {
@@ -106,8 +106,8 @@ void expand_into(Read<T> a_data, LOs a2b, Write<T> b_data, Int width) {
   OMEGA_H_TIME_FUNCTION;
   auto na = a2b.size() - 1;
   if(a_data.size() != na * width) printf("This error can happen when an array has been subsetted - check sync_array usage vs sync_subset_array:\n"
-                                         " a_data.size= %d na= %d width= %d", a_data.size(), na, width);
-  OMEGA_H_CHECK_PRINTF(a_data.size() == na * width, "a_data.size= %d na= %d width= %d", a_data.size(), na, width);
+                                         " a_data.size= %ld na= %ld width= %d", long(a_data.size()), long(na), width);
+  OMEGA_H_CHECK_PRINTF(a_data.size() == na * width, "a_data.size= %ld na= %ld width= %d", long(a_data.size()), long(na), width);
   auto f = OMEGA_H_LAMBDA(LO a) {
     for (auto b = a2b[a]; b < a2b[a + 1]; ++b) {
       for (Int j = 0; j < width; ++j) {
@@ -217,7 +217,7 @@ LOs invert_funnel(LOs ab2a, LO na) {
       a2ab[a_end + 1] = ab + 1;
     }
   };
-  parallel_for(max2(0, nab - 1), f, "invert_funnel");
+  parallel_for(max2(LO(0), nab - 1), f, "invert_funnel");
   if (nab) {
     LO a_end = ab2a.get(nab - 1);
     a2ab.set(a_end + 1, nab);
@@ -260,6 +260,87 @@ Graph invert_map_by_atomics(LOs const a2b, LO const nb,
   return Graph(b2ba, ba2a);
 }
 
+/* a stable counting sort of the (a) by their (b), one digit at a time.
+   the first digit is the block of (b), and each range of (a) counts
+   and then scatters its entries into the buckets of these blocks,
+   keeping their order. the second digit is (b) itself, and each bucket
+   is sorted serially, its counters and its part of the output
+   staying in cache because its (b) are few and consecutive. */
+Graph invert_map_by_blocks(LOs const a2b, LO const nb,
+    std::string const& b2ba_name, std::string const& ba2a_name) {
+  OMEGA_H_TIME_FUNCTION;
+  constexpr Int block_shift = 12;
+  constexpr LO block_size = LO(1) << block_shift;
+  constexpr LO min_range_size = 16 * 1024;
+  constexpr LO max_nranges = 256;
+  auto const na = a2b.size();
+  LO const nranges = max2(LO(1), min2(max_nranges, na / min_range_size));
+  LO const nblocks = (nb + block_size - 1) / block_size;
+  /* range-major, so each range counts into a contiguous row */
+  Write<LO> range_counts(nranges * nblocks, 0);
+  auto count = OMEGA_H_LAMBDA(LO range) {
+    auto const begin = LO((I64(na) * range) / nranges);
+    auto const end = LO((I64(na) * (range + 1)) / nranges);
+    for (LO a = begin; a < end; ++a) {
+      ++range_counts[range * nblocks + (a2b[a] >> block_shift)];
+    }
+  };
+  parallel_for(nranges, std::move(count), "invert_map_by_blocks(count)");
+  /* buckets go in block order, and within a bucket ranges go in order */
+  Write<LO> block_counts(nblocks * nranges);
+  auto transpose = OMEGA_H_LAMBDA(LO i) {
+    auto const range = i / nblocks;
+    auto const block = i % nblocks;
+    block_counts[block * nranges + range] = range_counts[i];
+  };
+  parallel_for(nranges * nblocks, std::move(transpose));
+  auto const block_starts = offset_scan(LOs(block_counts));
+  auto positions = range_counts;
+  auto init_positions = OMEGA_H_LAMBDA(LO i) {
+    auto const range = i / nblocks;
+    auto const block = i % nblocks;
+    positions[i] = block_starts[block * nranges + range];
+  };
+  parallel_for(nranges * nblocks, std::move(init_positions));
+  Write<LO> bucket_a(na);
+  Write<LO> bucket_b(na);
+  auto scatter = OMEGA_H_LAMBDA(LO range) {
+    auto const begin = LO((I64(na) * range) / nranges);
+    auto const end = LO((I64(na) * (range + 1)) / nranges);
+    for (LO a = begin; a < end; ++a) {
+      auto const b = a2b[a];
+      auto const i = positions[range * nblocks + (b >> block_shift)]++;
+      bucket_a[i] = a;
+      bucket_b[i] = b;
+    }
+  };
+  parallel_for(nranges, std::move(scatter), "invert_map_by_blocks(scatter)");
+  Write<LO> b2ba(nb + 1, b2ba_name);
+  Write<LO> ba2a(na, ba2a_name);
+  Write<LO> cursors(nb);
+  auto sort_bucket = OMEGA_H_LAMBDA(LO block) {
+    auto const bucket_begin = block_starts[block * nranges];
+    auto const bucket_end = block_starts[(block + 1) * nranges];
+    auto const first_b = block * block_size;
+    auto const end_b = min2(nb, first_b + block_size);
+    for (LO b = first_b; b < end_b; ++b) cursors[b] = 0;
+    for (LO i = bucket_begin; i < bucket_end; ++i) ++cursors[bucket_b[i]];
+    auto offset = bucket_begin;
+    for (LO b = first_b; b < end_b; ++b) {
+      auto const degree = cursors[b];
+      b2ba[b] = offset;
+      cursors[b] = offset;
+      offset += degree;
+    }
+    for (LO i = bucket_begin; i < bucket_end; ++i) {
+      ba2a[cursors[bucket_b[i]]++] = bucket_a[i];
+    }
+  };
+  parallel_for(nblocks, std::move(sort_bucket), "invert_map_by_blocks(sort)");
+  b2ba.set(nb, na);
+  return Graph(LOs(b2ba), LOs(ba2a));
+}
+
 LOs get_degrees(LOs offsets, std::string const& name) {
   Write<LO> degrees(offsets.size() - 1, name);
   auto f = OMEGA_H_LAMBDA(LO i) { degrees[i] = offsets[i + 1] - offsets[i]; };
@@ -60,6 +60,12 @@ Graph invert_map_by_sorting(LOs a2b, LO nb);
 Graph invert_map_by_atomics(LOs const a2b, LO const nb,
     std::string const& b2ba_name = "", std::string const& ba2a_name = "");
 
+/* like invert_map_by_atomics, but each list (b2ba) is in increasing
+   order of (a), with neither atomics nor sorting. (a2b) is split into
+   ranges that run in parallel, so this is for host backends */
+Graph invert_map_by_blocks(LOs const a2b, LO const nb,
+    std::string const& b2ba_name = "", std::string const& ba2a_name = "");
+
 LOs get_degrees(LOs offsets, std::string const& name = "");
 
 LOs invert_fan(LOs a2b);
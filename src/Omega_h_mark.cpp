@@ -111,14 +111,14 @@ Read<I8> get_eq_marks(
     Mesh* mesh, Int class_dim, std::vector<ClassId> const& class_ids) {
   auto sorted_class_ids = class_ids;
   std::sort(begin(sorted_class_ids), end(sorted_class_ids));
-  HostWrite<LO> h_sorted_class_ids(LO(sorted_class_ids.size()));
+  HostWrite<ClassId> h_sorted_class_ids(LO(sorted_class_ids.size()));
   for (size_t i = 0; i < sorted_class_ids.size(); ++i) {
     h_sorted_class_ids[LO(i)] = sorted_class_ids[i];
   }
   auto d_sorted_class_ids = Read<ClassId>(h_sorted_class_ids.write());
   auto nclass_ids = d_sorted_class_ids.size();
   auto eq_class_dims = mesh->get_array<I8>(class_dim, "class_dim");
-  auto eq_class_ids = mesh->get_array<LO>(class_dim, "class_id");
+  auto eq_class_ids = mesh->get_array<ClassId>(class_dim, "class_id");
   auto neq = mesh->nents(class_dim);
   Write<I8> eq_marks_w(neq);
   auto f = OMEGA_H_LAMBDA(LO eq) {
@@ -147,9 +147,9 @@ Read<I8> mark_class_closures(Mesh* mesh, Int class_dim,
   return marks;
 }
 
-static std::vector<LO> get_dim_class_ids(
+static std::vector<ClassId> get_dim_class_ids(
     Int class_dim, std::vector<ClassPair> const& class_pairs) {
-  std::vector<LO> dim_class_ids;
+  std::vector<ClassId> dim_class_ids;
   for (size_t i = 0; i < class_pairs.size(); ++i) {
     if (class_pairs[i].dim == class_dim) {
       dim_class_ids.push_back(class_pairs[i].id);
@@ -23,7 +23,7 @@ GO count_owned_marks(Mesh* mesh, Int ent_dim, Read<I8> marks);
 Read<I8> mark_sliver_layers(Mesh* mesh, Real qual_ceil, Int nlayers);
 Read<I8> mark_exposed_sides(Mesh* mesh);
 Read<I8> mark_class_closure(
-    Mesh* mesh, Int ent_dim, Int class_dim, LO class_id);
+    Mesh* mesh, Int ent_dim, Int class_dim, ClassId class_id);
 
 Read<I8> mark_class_closures(Mesh* mesh, Int ent_dim, Int class_dim,
     std::vector<ClassId> const& class_ids);
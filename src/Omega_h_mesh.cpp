@@ -15,6 +15,7 @@
 #include "Omega_h_mark.hpp"
 #include "Omega_h_migrate.hpp"
 #include "Omega_h_quality.hpp"
+#include "Omega_h_rebalance.hpp"
 #include "Omega_h_shape.hpp"
 #include "Omega_h_timer.hpp"
 #include "Omega_h_reduce.hpp"
@@ -23,13 +24,29 @@
 
 namespace Omega_h {
 
+static std::size_t default_adj_budget = ~std::size_t(0);
+
+void set_default_adj_budget(std::size_t bytes) { default_adj_budget = bytes; }
+
+std::size_t get_default_adj_budget() { return default_adj_budget; }
+
 Mesh::Mesh() {
   family_ = OMEGA_H_SIMPLEX;
   dim_ = -1;
   for (Int i = 0; i <= 3; ++i) nents_[i] = -1;
   parting_ = -1;
   nghost_layers_ = -1;
+  drop_ghosts_locally_ = false;
   library_ = nullptr;
+  adj_budget_ = default_adj_budget;
+  adj_clock_ = 0;
+  for (Int i = 0; i < DIMS; ++i) {
+    for (Int j = 0; j < DIMS; ++j) {
+      adj_last_use_[i][j] = 0;
+      adj_was_evicted_[i][j] = false;
+    }
+  }
+  adj_stats_ = AdjCacheStats{0, 0, 0, 0, 0, 0};
 }
 
 Mesh::Mesh(Library* library_in) : Mesh() { set_library(library_in); }
@@ -362,18 +379,89 @@ Adj Mesh::derive_adj(Int from, Int to) {
   OMEGA_H_NORETURN(Adj());
 }
 
+static bool is_derived_adj(Int from, Int to) { return to + 1 != from; }
+
+static std::size_t get_bytes(Adj const& adj) {
+  std::size_t bytes = 0;
+  if (adj.a2ab.exists()) bytes += std::size_t(adj.a2ab.size()) * sizeof(LO);
+  if (adj.ab2b.exists()) bytes += std::size_t(adj.ab2b.size()) * sizeof(LO);
+  if (adj.codes.exists()) bytes += std::size_t(adj.codes.size());
+  return bytes;
+}
+
 Adj Mesh::ask_adj(Int from, Int to) {
   OMEGA_H_TIME_FUNCTION;
   check_dim2(from);
   check_dim2(to);
   if (has_adj(from, to)) {
+    if (is_derived_adj(from, to)) {
+      ++adj_stats_.nhits;
+      adj_last_use_[from][to] = ++adj_clock_;
+    }
     return get_adj(from, to);
   }
   Adj derived = derive_adj(from, to);
+  ++adj_stats_.nmisses;
+  if (adj_was_evicted_[from][to]) ++adj_stats_.nrebuilds;
   adjs_[from][to] = std::make_shared<Adj>(derived);
+  adj_last_use_[from][to] = ++adj_clock_;
+  evict_adjs(from, to);
   return derived;
 }
 
+std::size_t Mesh::derived_adj_bytes() const {
+  std::size_t bytes = 0;
+  for (Int from = 0; from < DIMS; ++from) {
+    for (Int to = 0; to < DIMS; ++to) {
+      if (adjs_[from][to] && is_derived_adj(from, to)) {
+        bytes += get_bytes(*adjs_[from][to]);
+      }
+    }
+  }
+  return bytes;
+}
+
+/* drops the least recently asked for derived adjacencies other than
+   the one from (keep_from) to (keep_to) until the rest fit the budget.
+   arrays already handed out stay alive with their users */
+void Mesh::evict_adjs(Int keep_from, Int keep_to) {
+  auto bytes = derived_adj_bytes();
+  while (bytes > adj_budget_) {
+    Int lru_from = -1;
+    Int lru_to = -1;
+    for (Int from = 0; from < DIMS; ++from) {
+      for (Int to = 0; to < DIMS; ++to) {
+        if (!adjs_[from][to] || !is_derived_adj(from, to)) continue;
+        if (from == keep_from && to == keep_to) continue;
+        if (lru_from == -1 ||
+            adj_last_use_[from][to] < adj_last_use_[lru_from][lru_to]) {
+          lru_from = from;
+          lru_to = to;
+        }
+      }
+    }
+    if (lru_from == -1) break;
+    bytes -= get_bytes(*adjs_[lru_from][lru_to]);
+    adjs_[lru_from][lru_to].reset();
+    adj_was_evicted_[lru_from][lru_to] = true;
+    ++adj_stats_.nevictions;
+  }
+  adj_stats_.max_bytes = max2(adj_stats_.max_bytes, bytes);
+}
+
+void Mesh::set_adj_budget(std::size_t bytes) {
+  adj_budget_ = bytes;
+  evict_adjs(-1, -1);
+}
+
+std::size_t Mesh::adj_budget() const { return adj_budget_; }
+
+AdjCacheStats Mesh::adj_cache_stats() const {
+  auto stats = adj_stats_;
+  stats.bytes = derived_adj_bytes();
+  return stats;
+}
+
 void Mesh::add_coords(Reals array) {
   add_tag<Real>(0, "coordinates", dim(), array);
 }
@@ -528,7 +616,13 @@ void Mesh::set_parting(Omega_h_Parting parting_in, Int nlayers, bool verbose) {
   }
   if (parting_in == OMEGA_H_ELEM_BASED) {
     OMEGA_H_CHECK(nlayers == 0);
-    if (comm_->size() > 1) partition_by_elems(this, verbose);
+    if (comm_->size() > 1) {
+      if (drop_ghosts_locally_) {
+        drop_ghosts(this, verbose);
+      } else {
+        partition_by_elems(this, verbose);
+      }
+    }
   } else if (parting_in == OMEGA_H_GHOSTED) {
     if (parting_ != OMEGA_H_GHOSTED || nlayers < nghost_layers_) {
       set_parting(OMEGA_H_ELEM_BASED, 0, false);
@@ -549,28 +643,44 @@ void Mesh::set_parting(Omega_h_Parting parting_in, bool verbose) {
     set_parting(parting_in, 1, verbose);
 }
 
+void Mesh::set_drop_ghosts_locally(bool locally) {
+  drop_ghosts_locally_ = locally;
+}
+
+bool Mesh::drops_ghosts_locally() const { return drop_ghosts_locally_; }
+
+/* per-element weights used for load balancing.
+   with (predictive), this is the average between the current
+   weight (1.0) and the number of elements the metric implies */
+static Reals get_balance_masses(Mesh* mesh, bool predictive) {
+  if (!predictive) return Reals(mesh->nelems(), 1);
+  auto masses =
+      get_complexity_per_elem(mesh, mesh->get_array<Real>(VERT, "metric"));
+  masses = add_to_each(masses, 1.);
+  return multiply_each_by(masses, 1. / 2.);
+}
+
 /* this is a member function mainly because it
    modifies the RIB hints */
 void Mesh::balance(bool predictive) {
-  OMEGA_H_TIME_FUNCTION;
+  OMEGA_H_TIME_PHASE;
   if (comm_->size() == 1) return;
+  balance_rib(predictive);
+}
+
+/* returns the number of bytes this rank sent during migration */
+GO Mesh::balance_rib(bool predictive) {
   set_parting(OMEGA_H_ELEM_BASED);
   inertia::Rib hints;
   if (rib_hints_) hints = *rib_hints_;
   auto ecoords =
       average_field(this, dim(), LOs(nelems(), 0, 1), dim(), coords());
   if (dim() < 3) ecoords = resize_vectors(ecoords, dim(), 3);
-  Reals masses;
+  auto masses = get_balance_masses(this, predictive);
   Real abs_tol;
   if (predictive) {
-    masses = get_complexity_per_elem(this, get_array<Real>(VERT, "metric"));
-    /* average between input mesh weight (1.0)
-       and predicted output mesh weight */
-    masses = add_to_each(masses, 1.);
-    masses = multiply_each_by(masses, 1. / 2.);
     abs_tol = max2(0.0, get_max(comm_, masses));
   } else {
-    masses = Reals(nelems(), 1);
     abs_tol = 1.0;
   }
   abs_tol *= 2.0;  // fudge factor ?
@@ -582,7 +692,47 @@ void Mesh::balance(bool predictive) {
   auto owner_globals = this->globals(dim());
   owners2new.set_dest_globals(owner_globals);
   auto sorted_new2owners = owners2new.invert();
-  migrate_mesh(this, sorted_new2owners, OMEGA_H_ELEM_BASED, false);
+  return migrate_mesh(this, sorted_new2owners, OMEGA_H_ELEM_BASED, false);
+}
+
+/* rather than recomputing a partition from scratch, shift
+   only the excess load across existing partition boundaries.
+   the RIB hints are kept as they are, so a later full balance()
+   (including the fallback below) still reuses them */
+GO Mesh::balance_incremental(Real tolerance, bool predictive, bool verbose) {
+  OMEGA_H_TIME_PHASE;
+  if (comm_->size() == 1) return 0;
+  set_parting(OMEGA_H_ELEM_BASED);
+  constexpr Int max_rounds = 4;
+  GO nbytes = 0;
+  for (Int round = 0; round < max_rounds; ++round) {
+    auto masses = get_balance_masses(this, predictive);
+    auto load = get_sum(masses);
+    auto max_load = comm_->allreduce(load, OMEGA_H_MAX);
+    auto avg_load = comm_->allreduce(load, OMEGA_H_SUM) / comm_->size();
+    if (max_load <= tolerance * avg_load) break;
+    Read<I32> dest_ranks;
+    if (!diffuse_elem_dest_ranks(
+            this, masses, tolerance, &dest_ranks, verbose)) {
+      if (verbose && comm_->rank() == 0) {
+        std::cout << "falling back to full RIB balance\n";
+      }
+      nbytes += balance_rib(predictive);
+      break;
+    }
+    Dist old2new;
+    old2new.set_parent_comm(comm_);
+    old2new.set_dest_ranks(dest_ranks);
+    old2new.set_roots2items(LOs(nelems() + 1, 0, 1));
+    old2new.set_dest_globals(this->globals(dim()));
+    auto new2old = old2new.invert();
+    nbytes += migrate_mesh(this, new2old, OMEGA_H_ELEM_BASED, verbose);
+  }
+  nbytes = comm_->allreduce(nbytes, OMEGA_H_SUM);
+  if (verbose && comm_->rank() == 0) {
+    std::cout << "incremental balance migrated " << nbytes << " bytes\n";
+  }
+  return nbytes;
 }
 
 Graph Mesh::ask_graph(Int from, Int to) {
@@ -744,8 +894,10 @@ Mesh Mesh::copy_meta() const {
   m.comm_ = this->comm_;
   m.parting_ = this->parting_;
   m.nghost_layers_ = this->nghost_layers_;
+  m.drop_ghosts_locally_ = this->drop_ghosts_locally_;
   m.rib_hints_ = this->rib_hints_;
   m.class_sets = this->class_sets;
+  m.adj_budget_ = this->adj_budget_;
   return m;
 }
 
@@ -806,6 +958,17 @@ std::string Mesh::string(int verbose) {
       << "\n    max ghosted_ratio(dim)      = " << gre_max
       << "\n    max ghosted_ratio(0)        = " << gr0_max;
 
+  auto const adj_stats = adj_cache_stats();
+  oss << "\n    adj cache bytes             = " << adj_stats.bytes
+      << "\n    adj cache max bytes         = " << adj_stats.max_bytes;
+  if (adj_budget_ != ~std::size_t(0)) {
+    oss << "\n    adj cache budget            = " << adj_budget_;
+  }
+  oss << "\n    adj cache hits              = " << adj_stats.nhits
+      << "\n    adj cache misses            = " << adj_stats.nmisses
+      << "\n    adj cache rebuilds          = " << adj_stats.nrebuilds
+      << "\n    adj cache evictions         = " << adj_stats.nevictions;
+
   if (verbose) {
     oss 
       << "\n    globals(dim)                =\n" << globals(dim())
@@ -33,6 +33,22 @@ struct ClassPair {
 
 using ClassSets = std::map<std::string, std::vector<ClassPair>>;
 
+/* counts for the cache of derived adjacencies of a Mesh.
+   a rebuild is a miss for an adjacency that was evicted before */
+struct AdjCacheStats {
+  I64 nhits;
+  I64 nmisses;
+  I64 nrebuilds;
+  I64 nevictions;
+  std::size_t bytes;
+  std::size_t max_bytes;
+};
+
+/* the adjacency budget of meshes created from now on,
+   see Mesh::set_adj_budget. set by --osh-adj-budget */
+void set_default_adj_budget(std::size_t bytes);
+std::size_t get_default_adj_budget();
+
 class Mesh {
  public:
   Mesh();
@@ -85,6 +101,14 @@ class Mesh {
   Adj ask_up(Int from, Int to);
   Graph ask_star(Int dim);
   Graph ask_dual();
+  /* derived adjacencies, which are all but the downward ones from each
+     dimension to the one below it, are cached after they are asked for.
+     once they use more than (bytes), the least recently asked for are
+     dropped, and derived again if they are asked for again.
+     the budget is unlimited by default */
+  void set_adj_budget(std::size_t bytes);
+  std::size_t adj_budget() const;
+  AdjCacheStats adj_cache_stats() const;
 
  public:
   typedef std::shared_ptr<TagBase> TagPtr;
@@ -105,15 +129,24 @@ class Mesh {
   void add_adj(Int from, Int to, Adj adj);
   Adj derive_adj(Int from, Int to);
   Adj ask_adj(Int from, Int to);
+  std::size_t derived_adj_bytes() const;
+  void evict_adjs(Int keep_from, Int keep_to);
   void react_to_set_tag(Int dim, std::string const& name);
+  GO balance_rib(bool predictive);
   Omega_h_Family family_;
   Int dim_;
   CommPtr comm_;
   Int parting_;
   Int nghost_layers_;
+  bool drop_ghosts_locally_;
   LO nents_[DIMS];
   TagVector tags_[DIMS];
   AdjPtr adjs_[DIMS][DIMS];
+  std::size_t adj_budget_;
+  I64 adj_clock_;
+  I64 adj_last_use_[DIMS][DIMS];
+  bool adj_was_evicted_[DIMS][DIMS];
+  AdjCacheStats adj_stats_;
   Remotes owners_[DIMS];
   DistPtr dists_[DIMS];
   RibPtr rib_hints_;
@@ -141,7 +174,14 @@ class Mesh {
   Int nghost_layers() const;
   void set_parting(Omega_h_Parting parting_in, Int nlayers, bool verbose);
   void set_parting(Omega_h_Parting parting_in, bool verbose = false);
+  /* with (locally), going back to element-based partitioning calls
+     drop_ghosts() instead of migrating the mesh. it is off by default
+     and carried over by copy_meta(), so adapt operators keep it */
+  void set_drop_ghosts_locally(bool locally);
+  bool drops_ghosts_locally() const;
   void balance(bool predictive = false);
+  GO balance_incremental(
+      Real tolerance = 1.05, bool predictive = false, bool verbose = false);
   Graph ask_graph(Int from, Int to);
   template <typename T>
   Read<T> sync_array(Int ent_dim, Read<T> a, Int width);
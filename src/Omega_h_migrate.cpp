@@ -1,6 +1,8 @@
 #include "Omega_h_migrate.hpp"
 
+#include <algorithm>
 #include <iostream>
+#include <vector>
 
 #include "Omega_h_array_ops.hpp"
 #include "Omega_h_element.hpp"
@@ -122,35 +124,195 @@ void push_down(Mesh* old_mesh, Int ent_dim, Int low_dim,
   }
 }
 
-void push_tags(Mesh const* old_mesh, Mesh* new_mesh, Int ent_dim,
-    Dist old_owners2new_ents) {
+template <typename T>
+static void pack_tag(Write<I8> packed, Read<T> array, LO nents, Int ncomps,
+    Int width, Int offset) {
+  auto nbytes = Int(sizeof(T)) * ncomps;
+  auto f = OMEGA_H_LAMBDA(LO i) {
+    auto src = reinterpret_cast<unsigned char const*>(array.data() + i * ncomps);
+    auto dst = reinterpret_cast<unsigned char*>(packed.data() + i * width + offset);
+    for (Int j = 0; j < nbytes; ++j) dst[j] = src[j];
+  };
+  parallel_for(nents, f, "pack_tag");
+}
+
+template <typename T>
+static Read<T> unpack_tag(
+    Read<I8> packed, LO nents, Int ncomps, Int width, Int offset) {
+  auto nbytes = Int(sizeof(T)) * ncomps;
+  Write<T> array(nents * ncomps);
+  auto f = OMEGA_H_LAMBDA(LO i) {
+    auto src = reinterpret_cast<unsigned char const*>(packed.data() + i * width + offset);
+    auto dst = reinterpret_cast<unsigned char*>(array.data() + i * ncomps);
+    for (Int j = 0; j < nbytes; ++j) dst[j] = src[j];
+  };
+  parallel_for(nents, f, "unpack_tag");
+  return array;
+}
+
+static Int get_type_size(Omega_h_Type type) {
+  switch (type) {
+    case OMEGA_H_I8:
+      return Int(sizeof(I8));
+    case OMEGA_H_I32:
+      return Int(sizeof(I32));
+    case OMEGA_H_I64:
+      return Int(sizeof(I64));
+    case OMEGA_H_F64:
+      return Int(sizeof(Real));
+  }
+  OMEGA_H_NORETURN(0);
+}
+
+/* the number of bytes all tags of one entity occupy when packed */
+static Int get_packed_tags_width(Mesh const* mesh, Int ent_dim) {
+  Int width = 0;
+  for (Int i = 0; i < mesh->ntags(ent_dim); ++i) {
+    auto tag = mesh->get_tag(ent_dim, i);
+    width += tag->ncomps() * get_type_size(tag->type());
+  }
+  return width;
+}
+
+/* splits the tags of (ent_dim) into groups of consecutive tags, each
+   packed and exchanged on its own. the arrays an exchange creates hold
+   (group width) bytes for each root, item or received item on a rank,
+   so a group is only as wide as keeps the largest of those within LO.
+   every rank must exchange the same groups, so the largest count is
+   taken over the whole communicator */
+static std::vector<Int> group_packed_tags(Mesh const* old_mesh, Int ent_dim,
+    Dist old_owners2new_ents, Int max_group_width) {
+  I64 nmax = std::max(old_owners2new_ents.nroots(),
+      std::max(old_owners2new_ents.nitems(),
+          old_owners2new_ents.invert().nitems()));
+  nmax = old_mesh->comm()->allreduce(nmax, OMEGA_H_MAX);
+  I64 fit_width = I64(ArithTraits<LO>::max()) / std::max(nmax, I64(1));
+  if (max_group_width > 0) fit_width = std::min(fit_width, I64(max_group_width));
+  std::vector<Int> group_tags(1, 0);
+  I64 group_width = 0;
+  for (Int i = 0; i < old_mesh->ntags(ent_dim); ++i) {
+    auto tag = old_mesh->get_tag(ent_dim, i);
+    I64 tag_width = tag->ncomps() * get_type_size(tag->type());
+    if (I64(nmax) * tag_width > I64(ArithTraits<LO>::max())) {
+      Omega_h_fail(
+          "migrating tag \"%s\" of dimension %d needs %lld bytes in one "
+          "array on some rank, past the LO range of this build\n",
+          tag->name().c_str(), ent_dim, (long long)(nmax * tag_width));
+    }
+    if (group_width > 0 && group_width + tag_width > fit_width) {
+      group_tags.push_back(i);
+      group_width = 0;
+    }
+    group_width += tag_width;
+  }
+  group_tags.push_back(old_mesh->ntags(ent_dim));
+  return group_tags;
+}
+
+static Int get_group_width(
+    Mesh const* old_mesh, Int ent_dim, Int first_tag, Int end_tag) {
+  Int width = 0;
+  for (Int i = first_tag; i < end_tag; ++i) {
+    auto tag = old_mesh->get_tag(ent_dim, i);
+    width += tag->ncomps() * get_type_size(tag->type());
+  }
+  return width;
+}
+
+static Future<I8> ipush_tag_group(Mesh const* old_mesh, Int ent_dim,
+    Dist old_owners2new_ents, Int first_tag, Int end_tag) {
+  auto width = get_group_width(old_mesh, ent_dim, first_tag, end_tag);
+  auto nents = old_mesh->nents(ent_dim);
+  Write<I8> packed(nents * width);
+  Int offset = 0;
+  for (Int i = first_tag; i < end_tag; ++i) {
+    auto tag = old_mesh->get_tag(ent_dim, i);
+    auto ncomps = tag->ncomps();
+    switch (tag->type()) {
+      case OMEGA_H_I8:
+        pack_tag(packed, as<I8>(tag)->array(), nents, ncomps, width, offset);
+        break;
+      case OMEGA_H_I32:
+        pack_tag(packed, as<I32>(tag)->array(), nents, ncomps, width, offset);
+        break;
+      case OMEGA_H_I64:
+        pack_tag(packed, as<I64>(tag)->array(), nents, ncomps, width, offset);
+        break;
+      case OMEGA_H_F64:
+        pack_tag(packed, as<Real>(tag)->array(), nents, ncomps, width, offset);
+        break;
+    }
+    offset += ncomps * get_type_size(tag->type());
+  }
+  return old_owners2new_ents.iexch(Read<I8>(packed), width);
+}
+
+PushedTags ipush_tags(Mesh const* old_mesh, Int ent_dim,
+    Dist old_owners2new_ents, Int max_group_width) {
   OMEGA_H_TIME_FUNCTION;
   OMEGA_H_CHECK(old_owners2new_ents.nroots() == old_mesh->nents(ent_dim));
-  for (Int i = 0; i < old_mesh->ntags(ent_dim); ++i) {
+  PushedTags pushed;
+  if (get_packed_tags_width(old_mesh, ent_dim) == 0) return pushed;
+  pushed.group_tags = group_packed_tags(
+      old_mesh, ent_dim, old_owners2new_ents, max_group_width);
+  for (std::size_t g = 0; g + 1 < pushed.group_tags.size(); ++g) {
+    pushed.packs.push_back(ipush_tag_group(old_mesh, ent_dim,
+        old_owners2new_ents, pushed.group_tags[g], pushed.group_tags[g + 1]));
+  }
+  return pushed;
+}
+
+static void add_pushed_tag_group(Mesh const* old_mesh, Mesh* new_mesh,
+    Int ent_dim, Int first_tag, Int end_tag, Read<I8> packed) {
+  auto width = get_group_width(old_mesh, ent_dim, first_tag, end_tag);
+  auto nents = new_mesh->nents(ent_dim);
+  OMEGA_H_CHECK(packed.size() == nents * width);
+  Int offset = 0;
+  for (Int i = first_tag; i < end_tag; ++i) {
     auto tag = old_mesh->get_tag(ent_dim, i);
-    if (is<I8>(tag)) {
-      auto array = as<I8>(tag)->array();
-      array = old_owners2new_ents.exch(array, tag->ncomps());
-      new_mesh->add_tag<I8>(ent_dim, tag->name(), tag->ncomps(), array, true);
-    } else if (is<I32>(tag)) {
-      auto array = as<I32>(tag)->array();
-      array = old_owners2new_ents.exch(array, tag->ncomps());
-      new_mesh->add_tag<I32>(ent_dim, tag->name(), tag->ncomps(), array, true);
-    } else if (is<I64>(tag)) {
-      auto array = as<I64>(tag)->array();
-      array = old_owners2new_ents.exch(array, tag->ncomps());
-      new_mesh->add_tag<I64>(ent_dim, tag->name(), tag->ncomps(), array, true);
-    } else if (is<Real>(tag)) {
-      auto array = as<Real>(tag)->array();
-      array = old_owners2new_ents.exch(array, tag->ncomps());
-      new_mesh->add_tag<Real>(ent_dim, tag->name(), tag->ncomps(), array, true);
+    auto ncomps = tag->ncomps();
+    auto const& name = tag->name();
+    switch (tag->type()) {
+      case OMEGA_H_I8:
+        new_mesh->add_tag<I8>(ent_dim, name, ncomps,
+            unpack_tag<I8>(packed, nents, ncomps, width, offset), true);
+        break;
+      case OMEGA_H_I32:
+        new_mesh->add_tag<I32>(ent_dim, name, ncomps,
+            unpack_tag<I32>(packed, nents, ncomps, width, offset), true);
+        break;
+      case OMEGA_H_I64:
+        new_mesh->add_tag<I64>(ent_dim, name, ncomps,
+            unpack_tag<I64>(packed, nents, ncomps, width, offset), true);
+        break;
+      case OMEGA_H_F64:
+        new_mesh->add_tag<Real>(ent_dim, name, ncomps,
+            unpack_tag<Real>(packed, nents, ncomps, width, offset), true);
+        break;
     }
+    offset += ncomps * get_type_size(tag->type());
   }
 }
 
-void push_ents(Mesh* old_mesh, Mesh* new_mesh, Int ent_dim,
+void add_pushed_tags(
+    Mesh const* old_mesh, Mesh* new_mesh, Int ent_dim, PushedTags& pushed) {
+  OMEGA_H_TIME_FUNCTION;
+  for (std::size_t g = 0; g < pushed.packs.size(); ++g) {
+    add_pushed_tag_group(old_mesh, new_mesh, ent_dim, pushed.group_tags[g],
+        pushed.group_tags[g + 1], pushed.packs[g].get());
+  }
+}
+
+void push_tags(Mesh const* old_mesh, Mesh* new_mesh, Int ent_dim,
+    Dist old_owners2new_ents, Int max_group_width) {
+  OMEGA_H_TIME_FUNCTION;
+  auto pushed =
+      ipush_tags(old_mesh, ent_dim, old_owners2new_ents, max_group_width);
+  add_pushed_tags(old_mesh, new_mesh, ent_dim, pushed);
+}
+
+void push_owners(Mesh* old_mesh, Mesh* new_mesh, Int ent_dim,
     Dist new_ents2old_owners, Dist old_owners2new_ents, Omega_h_Parting mode) {
-  push_tags(old_mesh, new_mesh, ent_dim, old_owners2new_ents);
   Read<I32> own_ranks;
   /* if we are ghosting, each entity should remain owned by the
    * same rank that owned it before ghosting, as this is the only
@@ -168,6 +330,30 @@ void push_ents(Mesh* old_mesh, Mesh* new_mesh, Int ent_dim,
   new_mesh->set_owners(ent_dim, owners);
 }
 
+void push_ents(Mesh* old_mesh, Mesh* new_mesh, Int ent_dim,
+    Dist new_ents2old_owners, Dist old_owners2new_ents, Omega_h_Parting mode) {
+  push_tags(old_mesh, new_mesh, ent_dim, old_owners2new_ents);
+  push_owners(
+      old_mesh, new_mesh, ent_dim, new_ents2old_owners, old_owners2new_ents, mode);
+}
+
+namespace {
+struct PendingTags {
+  Int ent_dim;
+  PushedTags pushed;
+};
+}  // end anonymous namespace
+
+/* add the tags of all pending dimensions at or above (min_dim) */
+static void finish_pending_tags(Mesh const* old_mesh, Mesh* new_mesh,
+    std::vector<PendingTags>& pending, Int min_dim) {
+  while (!pending.empty() && pending.front().ent_dim >= min_dim) {
+    auto ent_dim = pending.front().ent_dim;
+    add_pushed_tags(old_mesh, new_mesh, ent_dim, pending.front().pushed);
+    pending.erase(pending.begin());
+  }
+}
+
 static void print_migrate_stats(CommPtr comm, Dist new_elems2old_owners) {
   auto msgs2ranks = new_elems2old_owners.msgs2ranks();
   auto msgs2content = new_elems2old_owners.msgs2content();
@@ -190,7 +376,23 @@ static void print_migrate_stats(CommPtr comm, Dist new_elems2old_owners) {
   }
 }
 
-void migrate_mesh(
+/* the number of bytes of tag and connectivity payload
+   this rank sends to other ranks for entities of one dimension */
+static GO count_sent_bytes(
+    Mesh const* old_mesh, Int ent_dim, Dist old_owners2new_ents) {
+  auto comm = old_owners2new_ents.parent_comm();
+  auto items2ranks = old_owners2new_ents.items2ranks();
+  auto nsent = get_sum(each_neq_to(items2ranks, comm->rank()));
+  GO bytes_per_ent = get_packed_tags_width(old_mesh, ent_dim);
+  if (ent_dim > VERT) {
+    auto nlows_per_high =
+        element_degree(old_mesh->family(), ent_dim, ent_dim - 1);
+    bytes_per_ent += nlows_per_high * GO(sizeof(I32) + sizeof(LO));
+  }
+  return GO(nsent) * bytes_per_ent;
+}
+
+GO migrate_mesh(
     Mesh* mesh, Dist new_elems2old_owners, Omega_h_Parting mode, bool verbose) {
   OMEGA_H_TIME_FUNCTION;
   for (Int d = 0; d <= mesh->dim(); ++d) {
@@ -202,26 +404,39 @@ void migrate_mesh(
   if (verbose) print_migrate_stats(comm, new_elems2old_owners);
   Dist new_ents2old_owners = new_elems2old_owners;
   auto old_owners2new_ents = new_ents2old_owners.invert();
+  GO nbytes = 0;
+  /* the packed tags of each dimension are sent as soon as we know
+     where its entities go, and are only waited for after the
+     connectivity of the next lower dimension has been pushed down,
+     so that the two overlap */
+  std::vector<PendingTags> pending;
   for (Int d = dim; d > VERT; --d) {
+    nbytes += count_sent_bytes(mesh, d, old_owners2new_ents);
+    pending.push_back({d, ipush_tags(mesh, d, old_owners2new_ents)});
     Adj high2low;
     Dist old_low_owners2new_lows;
     push_down(
         mesh, d, d - 1, old_owners2new_ents, high2low, old_low_owners2new_lows);
     new_mesh.set_ents(d, high2low);
+    finish_pending_tags(mesh, &new_mesh, pending, d + 1);
     new_ents2old_owners = old_owners2new_ents.invert();
-    push_ents(
+    push_owners(
         mesh, &new_mesh, d, new_ents2old_owners, old_owners2new_ents, mode);
     old_owners2new_ents = old_low_owners2new_lows;
   }
   auto new_verts2old_owners = old_owners2new_ents.invert();
   auto nnew_verts = new_verts2old_owners.nitems();
   new_mesh.set_verts(nnew_verts);
-  push_ents(
+  nbytes += count_sent_bytes(mesh, VERT, old_owners2new_ents);
+  pending.push_back({VERT, ipush_tags(mesh, VERT, old_owners2new_ents)});
+  push_owners(
       mesh, &new_mesh, VERT, new_verts2old_owners, old_owners2new_ents, mode);
+  finish_pending_tags(mesh, &new_mesh, pending, VERT);
   *mesh = new_mesh;
   for (Int d = 0; d <= mesh->dim(); ++d) {
     OMEGA_H_CHECK(mesh->has_tag(d, "global"));
   }
+  return nbytes;
 }
 
 }  // end namespace Omega_h
@@ -42,13 +42,39 @@ void push_down(Mesh* old_mesh, Int ent_dim, Int low_dim,
     Dist old_owners2new_ents, Adj& new_ents2new_lows,
     Dist& old_low_owners2new_lows);
 
+/* the tags of (ent_dim) entities are packed into byte arrays,
+   so that migrating them is a single message per neighbor rank.
+   tags go into one array as long as its size stays within LO;
+   past that they are split into groups of consecutive tags,
+   each packed and exchanged on its own.
+   (max_group_width), if positive, further limits the bytes per
+   entity of a group, which the tests use to force the split */
+struct PushedTags {
+  /* group g holds tags [group_tags[g], group_tags[g + 1]) */
+  std::vector<Int> group_tags;
+  std::vector<Future<I8>> packs;
+};
+
+/* ipush_tags() starts the exchange and returns without waiting for it,
+   add_pushed_tags() unpacks the received arrays into (new_mesh),
+   whose (ent_dim) entities must exist by then */
+PushedTags ipush_tags(Mesh const* old_mesh, Int ent_dim,
+    Dist old_owners2new_ents, Int max_group_width = 0);
+void add_pushed_tags(
+    Mesh const* old_mesh, Mesh* new_mesh, Int ent_dim, PushedTags& pushed);
+
 void push_tags(Mesh const* old_mesh, Mesh* new_mesh, Int ent_dim,
-    Dist old_owners2new_ents);
+    Dist old_owners2new_ents, Int max_group_width = 0);
+
+void push_owners(Mesh* old_mesh, Mesh* new_mesh, Int ent_dim,
+    Dist new_ents2old_owners, Dist old_owners2new_ents, Omega_h_Parting mode);
 
 void push_ents(Mesh* old_mesh, Mesh* new_mesh, Int ent_dim,
     Dist new_ents2old_owners, Dist old_owners2new_ents, Omega_h_Parting mode);
 
-void migrate_mesh(
+/* returns the number of bytes of entity payload (tags and
+   connectivity) that this rank sent to other ranks */
+GO migrate_mesh(
     Mesh* mesh, Dist new_elems2old_owners, Omega_h_Parting mode, bool verbose);
 
 }  // end namespace Omega_h
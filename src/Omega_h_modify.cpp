@@ -96,7 +96,7 @@ static Remotes get_prod_owners_shared(Mesh* mesh, Few<LOs, 4> mods2mds,
     auto mod_ranks = read(unmap(mods2mds[mod_dim], md_ranks, 1));
     auto mod_prod_idxs = unmap_range(prod_begin, prod_end, prods2new_ents, 1);
     mod_prod_idxs = mesh->sync_subset_array(
-        mod_dim, mod_prod_idxs, mods2mds[mod_dim], -1, nprods_per_mod);
+        mod_dim, mod_prod_idxs, mods2mds[mod_dim], LO(-1), nprods_per_mod);
     map_into_range(mod_prod_idxs, prod_begin, prod_end, prod_own_idxs, 1);
     expand_into(mod_ranks, mods2prods[mod_dim], prod_own_ranks, 1);
   }
@@ -496,7 +496,8 @@ void modify_ents(Mesh* old_mesh, Mesh* new_mesh, Int ent_dim,
       p_prods2new_ents, keep_mods);
   auto nold_ents = old_mesh->nents(ent_dim);
   *p_old_ents2new_ents =
-      map_onto(*p_same_ents2new_ents, *p_same_ents2old_ents, nold_ents, -1, 1);
+      map_onto(
+      *p_same_ents2new_ents, *p_same_ents2old_ents, nold_ents, LO(-1), 1);
   if (ent_dim == VERT) {
     new_mesh->set_verts(nnew_ents);
   } else {
@@ -39,6 +39,9 @@ Overlay::Overlay(
     set_vector(new_coords, i, x);
   }
   mesh.set_coords(new_coords);
+  /* the queries below read these adjacencies one entity at a time,
+     so they must stay cached whatever --osh-adj-budget says */
+  mesh.set_adj_budget(~std::size_t(0));
   mesh.ask_down(FACE, VERT);
   mesh.ask_down(REGION, VERT);
   mesh.ask_down(REGION, FACE);
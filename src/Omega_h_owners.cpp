@@ -18,7 +18,7 @@ Remotes update_ownership(Dist copies2old_owners, Read<I32> own_ranks) {
   auto old_owners2serv_copies = old_owners2copies.roots2items();
   auto clients2ranks = old_owners2copies.msgs2ranks();
   Write<LO> old_owners2own_idxs(nold_owners);
-  Read<LO> copies2own_ranks;
+  Read<I32> copies2own_ranks;
   if (own_ranks.exists()) {
     auto serv_copies2own_ranks = copies2old_owners.exch(own_ranks, 1);
     auto f = OMEGA_H_LAMBDA(LO old_owner) {
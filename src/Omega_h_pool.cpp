@@ -1,76 +1,217 @@
 #include <Omega_h_fail.hpp>
 #include <Omega_h_pool.hpp>
-#include <Omega_h_profile.hpp>
 #include <algorithm>
+#include <iostream>
+#include <thread>
 
 namespace Omega_h {
 
+static std::size_t get_shift(std::size_t size) {
+  std::size_t shift;
+  for (shift = 0; ((std::size_t(1) << shift) < size); ++shift)
+    ;
+  return shift;
+}
+
+static std::size_t get_class_size(std::size_t shift) {
+  return std::size_t(1) << shift;
+}
+
+/* each thread is given a slot the first time it touches any pool,
+   and keeps it for its lifetime. threads beyond the number of caches
+   share caches, which is still correct thanks to the per-cache mutex */
+static std::size_t get_thread_slot() {
+  static std::atomic<std::size_t> next_slot(0);
+  thread_local std::size_t const slot = next_slot++;
+  return slot;
+}
+
+static PoolCache& get_thread_cache(Pool& pool) {
+  return *(pool.thread_caches[get_thread_slot() % pool.thread_caches.size()]);
+}
+
 static void call_underlying_frees(Pool& pool, BlockList list[]) {
   for (std::size_t i = 0; i < 64; ++i) {
     for (auto block : list[i]) {
-      pool.underlying_free(block, (std::size_t(1) << i));
+      pool.underlying_free(block, get_class_size(i));
     }
+    pool.nunderlying_frees += list[i].size();
     list[i].clear();
   }
 }
 
+/* move up to (n) blocks from the back of one list to another */
+static void transfer_blocks(BlockList& from, BlockList& to, std::size_t n) {
+  auto const nmoved = std::min(n, from.size());
+  to.insert(to.end(), from.end() - std::ptrdiff_t(nmoved), from.end());
+  from.resize(from.size() - nmoved);
+}
+
+static void update_max(std::atomic<std::size_t>& max, std::size_t value) {
+  auto old = max.load();
+  while (old < value && !max.compare_exchange_weak(old, value))
+    ;
+}
+
 Pool::Pool(MallocFunc malloc_in, FreeFunc free_in)
-    : underlying_malloc(malloc_in), underlying_free(free_in) {}
+    : Pool(malloc_in, free_in, ~std::size_t(0)) {}
+
+Pool::Pool(MallocFunc malloc_in, FreeFunc free_in,
+    std::size_t high_water_bytes_in)
+    : batch_size(16),
+      high_water_bytes(high_water_bytes_in),
+      nallocs(0),
+      nthread_hits(0),
+      ncentral_hits(0),
+      nunderlying_mallocs(0),
+      nunderlying_frees(0),
+      ntrims(0),
+      bytes_in_use(0),
+      max_bytes_in_use(0),
+      bytes_cached(0),
+      underlying_malloc(malloc_in),
+      underlying_free(free_in) {
+  auto nthreads = std::size_t(std::thread::hardware_concurrency());
+  if (nthreads < 1) nthreads = 1;
+  for (std::size_t i = 0; i < nthreads; ++i) {
+    thread_caches.emplace_back(new PoolCache());
+  }
+  for (std::size_t i = 0; i < 64; ++i) nused_blocks[i] = 0;
+}
 
 Pool::~Pool() {
-  call_underlying_frees(*this, used_blocks);
-  call_underlying_frees(*this, free_blocks);
+  for (auto& cache : thread_caches) {
+    call_underlying_frees(*this, cache->free_blocks);
+  }
+  call_underlying_frees(*this, central.free_blocks);
 }
 
-static std::size_t underlying_total_size(Pool& pool) {
-  std::size_t total_size = 0;
-  for (std::size_t i = 0; i < 64; ++i) {
-    total_size += (std::size_t(1) << i) * pool.used_blocks[i].size();
-    total_size += (std::size_t(1) << i) * pool.free_blocks[i].size();
+void trim(Pool& pool, std::size_t max_cached_bytes) {
+  ++pool.ntrims;
+  /* always lock a thread cache before the central cache */
+  for (auto& cache : pool.thread_caches) {
+    std::lock_guard<std::mutex> lock(cache->mutex);
+    std::lock_guard<std::mutex> central_lock(pool.central.mutex);
+    for (std::size_t i = 0; i < 64; ++i) {
+      transfer_blocks(cache->free_blocks[i], pool.central.free_blocks[i],
+          cache->free_blocks[i].size());
+    }
+  }
+  /* release the largest blocks first, they are the most
+     likely to be holding on to memory nobody needs anymore */
+  std::lock_guard<std::mutex> central_lock(pool.central.mutex);
+  for (std::size_t i = 64; i-- > 0;) {
+    auto& list = pool.central.free_blocks[i];
+    while (!list.empty() && pool.bytes_cached > max_cached_bytes) {
+      pool.underlying_free(list.back(), get_class_size(i));
+      list.pop_back();
+      ++pool.nunderlying_frees;
+      pool.bytes_cached -= get_class_size(i);
+    }
   }
-  return total_size;
 }
 
-void* allocate(Pool& pool, std::size_t size) {
-  ScopedTimer timer("pool allocate");
-  std::size_t shift;
-  for (shift = 0; ((std::size_t(1) << shift) < size); ++shift)
-    ;
-  if (!pool.free_blocks[shift].empty()) {
-    auto const data = pool.free_blocks[shift].back();
-    pool.used_blocks[shift].push_back(data);
-    pool.free_blocks[shift].pop_back();
-    return data;
+static void* allocate_cached(Pool& pool, std::size_t shift) {
+  auto& cache = get_thread_cache(pool);
+  std::lock_guard<std::mutex> lock(cache.mutex);
+  auto& local = cache.free_blocks[shift];
+  if (local.empty()) {
+    std::lock_guard<std::mutex> central_lock(pool.central.mutex);
+    auto& central = pool.central.free_blocks[shift];
+    if (central.empty()) return nullptr;
+    transfer_blocks(central, local, pool.batch_size);
+    ++pool.ncentral_hits;
+  } else {
+    ++pool.nthread_hits;
   }
-  auto const size_to_alloc = (std::size_t(1) << shift);
-  auto data = pool.underlying_malloc(size_to_alloc);
+  auto const data = local.back();
+  local.pop_back();
+  pool.bytes_cached -= get_class_size(shift);
+  return data;
+}
+
+void* allocate(Pool& pool, std::size_t size) {
+  auto const shift = get_shift(size);
+  auto const size_to_alloc = get_class_size(shift);
+  ++pool.nallocs;
+  auto data = allocate_cached(pool, shift);
   if (data == nullptr) {
-    call_underlying_frees(pool, pool.free_blocks);
     data = pool.underlying_malloc(size_to_alloc);
+    if (data == nullptr) {
+      trim(pool, 0);
+      data = pool.underlying_malloc(size_to_alloc);
+    }
+    if (data == nullptr) {
+      Omega_h_fail(
+          "Pool failed to allocate %zu bytes, %zu bytes already allocated\n",
+          size_to_alloc, std::size_t(pool.bytes_in_use));
+    }
+    ++pool.nunderlying_mallocs;
   }
-  if (data == nullptr) {
-    Omega_h_fail(
-        "Pool failed to allocate %zu bytes, %zu bytes already allocated\n",
-        size_to_alloc, underlying_total_size(pool));
-  }
-  pool.used_blocks[shift].push_back(data);
+  ++pool.nused_blocks[shift];
+  update_max(pool.max_bytes_in_use, pool.bytes_in_use += size_to_alloc);
   return data;
 }
 
 void deallocate(Pool& pool, void* data, std::size_t size) {
-  ScopedTimer timer("pool deallocate");
-  std::size_t shift;
-  for (shift = 0; ((std::size_t(1) << shift) < size); ++shift)
-    ;
-  auto const end = pool.used_blocks[shift].end();
-  auto const it = std::find_if(pool.used_blocks[shift].begin(), end,
-      [=](VoidPtr b) -> bool { return b == data; });
-  if (it == end) {
-    Omega_h_fail(
-        "Tried to deallocate %p from pool, but pool didn't allocate it\n",
-        data);
+  auto const shift = get_shift(size);
+  auto nused = pool.nused_blocks[shift].load();
+  do {
+    if (nused == 0) {
+      Omega_h_fail(
+          "Tried to deallocate %p from pool, but pool didn't allocate it\n",
+          data);
+    }
+  } while (!pool.nused_blocks[shift].compare_exchange_weak(nused, nused - 1));
+  pool.bytes_in_use -= get_class_size(shift);
+  pool.bytes_cached += get_class_size(shift);
+  {
+    auto& cache = get_thread_cache(pool);
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    auto& local = cache.free_blocks[shift];
+    local.push_back(data);
+    /* keep the most recently freed blocks (whose pages are likely
+       still in this thread's cache and NUMA domain) and return
+       the older ones to the central cache */
+    if (local.size() > 2 * pool.batch_size) {
+      std::lock_guard<std::mutex> central_lock(pool.central.mutex);
+      BlockList oldest(local.begin(),
+          local.begin() + std::ptrdiff_t(pool.batch_size));
+      local.erase(
+          local.begin(), local.begin() + std::ptrdiff_t(pool.batch_size));
+      auto& central = pool.central.free_blocks[shift];
+      central.insert(central.end(), oldest.begin(), oldest.end());
+    }
   }
-  pool.free_blocks[shift].push_back(*it);
-  pool.used_blocks[shift].erase(it);
+  if (pool.bytes_cached > pool.high_water_bytes) {
+    trim(pool, pool.high_water_bytes / 2);
+  }
+}
+
+PoolStats get_stats(Pool const& pool) {
+  PoolStats stats;
+  stats.nallocs = pool.nallocs;
+  stats.nthread_hits = pool.nthread_hits;
+  stats.ncentral_hits = pool.ncentral_hits;
+  stats.nunderlying_mallocs = pool.nunderlying_mallocs;
+  stats.nunderlying_frees = pool.nunderlying_frees;
+  stats.ntrims = pool.ntrims;
+  stats.bytes_in_use = pool.bytes_in_use;
+  stats.max_bytes_in_use = pool.max_bytes_in_use;
+  stats.bytes_cached = pool.bytes_cached;
+  return stats;
+}
+
+void print_stats(Pool const& pool, std::ostream& stream) {
+  auto const stats = get_stats(pool);
+  stream << "allocations: " << stats.nallocs << '\n';
+  stream << "thread cache hits: " << stats.nthread_hits << '\n';
+  stream << "central cache hits: " << stats.ncentral_hits << '\n';
+  stream << "underlying mallocs: " << stats.nunderlying_mallocs << '\n';
+  stream << "underlying frees: " << stats.nunderlying_frees << '\n';
+  stream << "trims: " << stats.ntrims << '\n';
+  stream << "bytes in use: " << stats.bytes_in_use << '\n';
+  stream << "max bytes in use: " << stats.max_bytes_in_use << '\n';
+  stream << "bytes cached: " << stats.bytes_cached << '\n';
 }
 }  // namespace Omega_h
@@ -1,7 +1,12 @@
 #ifndef OMEGA_H_POOL_HPP
 #define OMEGA_H_POOL_HPP
 
+#include <atomic>
+#include <cstddef>
 #include <functional>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
 #include <vector>
 
 namespace Omega_h {
@@ -11,21 +16,66 @@ using BlockList = std::vector<VoidPtr>;
 using MallocFunc = std::function<VoidPtr(std::size_t)>;
 using FreeFunc = std::function<void(VoidPtr, std::size_t)>;
 
+/* free blocks, one list per power-of-two size class */
+struct PoolCache {
+  std::mutex mutex;
+  BlockList free_blocks[64];
+};
+
+struct PoolStats {
+  std::size_t nallocs;
+  std::size_t nthread_hits;
+  std::size_t ncentral_hits;
+  std::size_t nunderlying_mallocs;
+  std::size_t nunderlying_frees;
+  std::size_t ntrims;
+  std::size_t bytes_in_use;
+  std::size_t max_bytes_in_use;
+  std::size_t bytes_cached;
+};
+
+/* a size-class memory pool which is safe to use from several threads.
+   each thread allocates from and frees into its own cache,
+   which exchanges blocks with the central cache (batch_size) at a time.
+   the pool never touches the memory it hands out, and blocks
+   freed by a thread are handed back to that same thread first,
+   so pages stay on the NUMA domain of the thread that first
+   touched them.
+   whenever the free blocks cached by the pool exceed (high_water_bytes),
+   they are released to the underlying allocator until only half
+   of that remains cached. */
 struct Pool {
   Pool(MallocFunc, FreeFunc);
+  Pool(MallocFunc, FreeFunc, std::size_t high_water_bytes_in);
   ~Pool();
   Pool(Pool const&) = delete;
   Pool(Pool&&) = delete;
   Pool& operator=(Pool const&) = delete;
   Pool& operator=(Pool&&) = delete;
-  BlockList used_blocks[64];
-  BlockList free_blocks[64];
+  std::vector<std::unique_ptr<PoolCache>> thread_caches;
+  PoolCache central;
+  std::size_t batch_size;
+  std::size_t high_water_bytes;
+  std::atomic<std::size_t> nused_blocks[64];
+  std::atomic<std::size_t> nallocs;
+  std::atomic<std::size_t> nthread_hits;
+  std::atomic<std::size_t> ncentral_hits;
+  std::atomic<std::size_t> nunderlying_mallocs;
+  std::atomic<std::size_t> nunderlying_frees;
+  std::atomic<std::size_t> ntrims;
+  std::atomic<std::size_t> bytes_in_use;
+  std::atomic<std::size_t> max_bytes_in_use;
+  std::atomic<std::size_t> bytes_cached;
   MallocFunc underlying_malloc;
   FreeFunc underlying_free;
 };
 
 void* allocate(Pool&, std::size_t);
 void deallocate(Pool&, void*, std::size_t);
+/* release cached free blocks until at most (max_cached_bytes) remain */
+void trim(Pool&, std::size_t max_cached_bytes);
+PoolStats get_stats(Pool const&);
+void print_stats(Pool const&, std::ostream&);
 }  // namespace Omega_h
 
 #endif
@@ -18,13 +18,17 @@ OMEGA_H_DLL History* global_singleton_history = nullptr;
 
 History::History(CommPtr comm_in, bool dopercent, double chop_in, bool add_filename_in) : 
   current_frame(invalid), last_root(invalid), start_time(now()), 
-  do_percent(dopercent), chop(chop_in), add_filename(add_filename_in), comm(comm_in) {}
+  do_percent(dopercent), chop(chop_in), add_filename(add_filename_in),
+  track_memory(false), live_bytes(0), total_allocs(0), comm(comm_in) {}
 
 History::History(const History& h) {
   start_time = h.start_time;
   do_percent = h.do_percent;
   chop = h.chop;
   add_filename = h.add_filename;
+  track_memory = h.track_memory;
+  live_bytes = 0;
+  total_allocs = 0;
   comm = h.comm;
 }
 
@@ -68,6 +72,14 @@ std::size_t History::calls(std::size_t frame) const {
   return frames[frame].number_of_calls;
 }
 
+std::size_t History::allocs(std::size_t frame) const {
+  return frames[frame].number_of_allocs;
+}
+
+std::size_t History::peak_bytes(std::size_t frame) const {
+  return frames[frame].peak_bytes;
+}
+
 struct PreOrderIterator {
   using reference = std::size_t;
   PreOrderIterator& operator++() {
@@ -131,8 +143,11 @@ History invert(History const& h) {
     q.pop();
     auto self_time = h.time(node);
     auto calls = h.calls(node);
+    auto allocs = h.allocs(node);
+    auto peak = h.peak_bytes(node);
     for (auto child = h.first(node); child != invalid; child = h.next(child)) {
       self_time -= h.time(child);
+      allocs -= h.allocs(child);
       q.push(child);
     }
     self_time = std::max(self_time,
@@ -143,6 +158,9 @@ History invert(History const& h) {
       inv_node = invh.find_or_create_child_of(inv_node, name);
       invh.frames[inv_node].total_runtime += self_time;
       invh.frames[inv_node].number_of_calls += calls;
+      invh.frames[inv_node].number_of_allocs += allocs;
+      invh.frames[inv_node].peak_bytes =
+          std::max(invh.frames[inv_node].peak_bytes, peak);
     }
   }
   return invh;
@@ -168,7 +186,12 @@ static void print_time_sorted_recursive(History const& h, std::size_t frame,
     if (h.time(child)*100.0/total_runtime >= h.chop) {
       for (std::size_t i = 0; i < depth; ++i) std::cout << "|  ";
       std::cout << h.get_name(child) << ' ' << h.time(child)*scale << percent 
-                << h.calls(child) << '\n';
+                << h.calls(child);
+      if (h.track_memory) {
+        std::cout << " allocs= " << h.allocs(child)
+                  << " peak_bytes= " << h.peak_bytes(child);
+      }
+      std::cout << '\n';
     }
     print_time_sorted_recursive(h, child, depths, total_runtime);
   }
@@ -333,5 +356,29 @@ void print_top_sorted(History const& h_in, double total_runtime) {
   }
 }
 
+void print_memory_timeline(History const& h) {
+  std::cout << "\n";
+  std::cout << "MEMORY TIMELINE (bytes):\n";
+  std::cout << "================\n";
+  std::cout << std::right << std::setw(12) << "Time" << std::setw(16) << "Peak"
+            << std::setw(16) << "End" << "   Phase\n";
+  std::size_t highest = invalid;
+  for (std::size_t i = 0; i < h.phases.size(); ++i) {
+    auto& rec = h.phases[i];
+    std::cout << std::right << std::setw(12) << rec.end_time << std::setw(16)
+              << rec.peak_bytes << std::setw(16) << rec.end_bytes << "   "
+              << h.names.get(rec.name_ptr) << '\n';
+    if (highest == invalid || rec.peak_bytes > h.phases[highest].peak_bytes) {
+      highest = i;
+    }
+  }
+  if (highest != invalid) {
+    auto& rec = h.phases[highest];
+    std::cout << "peak of " << rec.peak_bytes << " bytes was set by "
+              << h.names.get(rec.name_ptr) << " ending at " << rec.end_time
+              << " [s]\n";
+  }
+}
+
 }  // namespace profile
 }  // namespace Omega_h
@@ -3,9 +3,11 @@
 
 #include <Omega_h_timer.hpp>
 #include <Omega_h_filesystem.hpp>
+#include <algorithm>
 #include <cstring>
 #include <vector>
 #include <memory>
+#include <mutex>
 #ifdef OMEGA_H_USE_KOKKOS
 #include <Omega_h_kokkos.hpp>
 #endif
@@ -42,6 +44,22 @@ struct Frame {
   Now start_time;
   double total_runtime;
   std::size_t number_of_calls;
+  /* allocations made during all calls, including callees */
+  std::size_t number_of_allocs;
+  std::size_t call_start_allocs;
+  /* highest live bytes seen during any call, including callees */
+  std::size_t peak_bytes;
+  /* highest live bytes seen during the current call */
+  std::size_t call_peak_bytes;
+};
+
+/* one entry of the memory timeline, recorded as each
+   adapt phase (refine, coarsen, swap, balance) ends */
+struct PhaseRecord {
+  std::size_t name_ptr;
+  double end_time;
+  std::size_t peak_bytes;
+  std::size_t end_bytes;
 };
 
 struct History {
@@ -53,6 +71,14 @@ struct History {
   bool do_percent;
   double chop;
   bool add_filename;
+  /* when set, array allocations are counted and attributed to frames.
+     arrays may be allocated and freed by worker threads, so the counts
+     and the frames they touch are then guarded by memory_mutex */
+  bool track_memory;
+  std::size_t live_bytes;
+  std::size_t total_allocs;
+  std::mutex memory_mutex;
+  std::vector<PhaseRecord> phases;
   CommPtr comm;
   History(CommPtr comm = nullptr, bool dopercent=false, double chop=0.0, bool add_filename=false);
   History(const History& h);
@@ -91,6 +117,10 @@ struct History {
     frame.name_ptr = names.save(name);
     frame.total_runtime = 0.0;
     frame.number_of_calls = 0;
+    frame.number_of_allocs = 0;
+    frame.call_start_allocs = 0;
+    frame.peak_bytes = 0;
+    frame.call_peak_bytes = 0;
     return index;
   }
   inline std::size_t create_child_of_current(char const* name) {
@@ -121,6 +151,10 @@ struct History {
     frame.name_ptr = names.save(name);
     frame.total_runtime = 0.0;
     frame.number_of_calls = 0;
+    frame.number_of_allocs = 0;
+    frame.call_start_allocs = 0;
+    frame.peak_bytes = 0;
+    frame.call_peak_bytes = 0;
     return index;
   }
   inline std::size_t find(char const* name) {
@@ -145,8 +179,12 @@ struct History {
   }
   inline void pop() { current_frame = frames[current_frame].parent; }
   inline void start(char const* const name) {
+    std::unique_lock<std::mutex> lock(memory_mutex, std::defer_lock);
+    if (track_memory) lock.lock();
     auto id = push(name);
     frames[id].number_of_calls += 1;
+    frames[id].call_peak_bytes = live_bytes;
+    frames[id].call_start_allocs = total_allocs;
     frames[id].start_time = now();
   }
   inline double measure_runtime() { 
@@ -158,15 +196,52 @@ struct History {
     return frames[current_frame].total_runtime + measure_runtime();
   }
   inline void stop() {
-    frames[current_frame].total_runtime = measure_total_runtime();
+    std::unique_lock<std::mutex> lock(memory_mutex, std::defer_lock);
+    if (track_memory) lock.lock();
+    auto& frame = frames[current_frame];
+    frame.total_runtime = measure_total_runtime();
+    frame.number_of_allocs += total_allocs - frame.call_start_allocs;
+    frame.peak_bytes = std::max(frame.peak_bytes, frame.call_peak_bytes);
+    if (frame.parent != invalid) {
+      auto& parent_frame = frames[frame.parent];
+      parent_frame.call_peak_bytes =
+          std::max(parent_frame.call_peak_bytes, frame.call_peak_bytes);
+    }
     pop();
   }
+  inline void stop_phase() {
+    {
+      std::unique_lock<std::mutex> lock(memory_mutex, std::defer_lock);
+      if (track_memory) lock.lock();
+      auto& frame = frames[current_frame];
+      phases.push_back({frame.name_ptr, now() - start_time,
+          frame.call_peak_bytes, live_bytes});
+    }
+    stop();
+  }
+  inline void record_alloc(std::size_t size) {
+    if (!track_memory) return;
+    std::lock_guard<std::mutex> lock(memory_mutex);
+    live_bytes += size;
+    total_allocs += 1;
+    if (current_frame == invalid) return;
+    auto& frame = frames[current_frame];
+    frame.call_peak_bytes = std::max(frame.call_peak_bytes, live_bytes);
+  }
+  inline void record_free(std::size_t size) {
+    if (!track_memory) return;
+    std::lock_guard<std::mutex> lock(memory_mutex);
+    /* arrays allocated before profiling began may be freed during it */
+    live_bytes -= std::min(size, live_bytes);
+  }
   std::size_t first(std::size_t parent) const;
   std::size_t next(std::size_t sibling) const;
   std::size_t parent(std::size_t child) const;
   std::size_t pre_order_next(std::size_t frame) const;
   double time(std::size_t frame) const;
   std::size_t calls(std::size_t frame) const;
+  std::size_t allocs(std::size_t frame) const;
+  std::size_t peak_bytes(std::size_t frame) const;
 };
 
 OMEGA_H_DLL extern History* global_singleton_history;
@@ -176,6 +251,7 @@ History invert(History const& h);
 void print_time_sorted(History const& h);
 void print_top_down_and_bottom_up(History const& h, double total_runtime);
 void print_top_sorted(History const& h, double total_runtime);
+void print_memory_timeline(History const& h);
 
 }  // namespace profile
 }  // namespace Omega_h
@@ -216,6 +292,27 @@ inline void end_code() {
   }
 }
 
+inline void end_phase() {
+#ifdef OMEGA_H_USE_KOKKOS
+  Kokkos::Profiling::popRegion();
+#endif
+  if (profile::global_singleton_history) {
+    profile::global_singleton_history->stop_phase();
+  }
+}
+
+inline void record_alloc(std::size_t size) {
+  if (profile::global_singleton_history) {
+    profile::global_singleton_history->record_alloc(size);
+  }
+}
+
+inline void record_free(std::size_t size) {
+  if (profile::global_singleton_history) {
+    profile::global_singleton_history->record_free(size);
+  }
+}
+
 struct ScopedTimer {
   ScopedTimer(char const* name, char const *file=0) { begin_code(name, file); }
   ~ScopedTimer() { end_code(); }
@@ -226,9 +323,24 @@ struct ScopedTimer {
   inline double total_runtime() { return get_runtime(); }
 };
 
+/* like ScopedTimer, but also adds an entry to the memory timeline */
+struct ScopedPhase {
+  ScopedPhase(char const* name, char const* file = 0) {
+    begin_code(name, file);
+  }
+  ~ScopedPhase() { end_phase(); }
+  ScopedPhase(ScopedPhase const&) = delete;
+  ScopedPhase(ScopedPhase&&) = delete;
+  ScopedPhase& operator=(ScopedPhase const&) = delete;
+  ScopedPhase& operator=(ScopedPhase&&) = delete;
+};
+
 }  // namespace Omega_h
 
 #define OMEGA_H_TIME_FUNCTION                                                  \
   ::Omega_h::ScopedTimer omega_h_scoped_function_timer(__FUNCTION__, (std::string(__FILE__)+":"+std::to_string(__LINE__)).c_str())
 
+#define OMEGA_H_TIME_PHASE                                                     \
+  ::Omega_h::ScopedPhase omega_h_scoped_phase_timer(__FUNCTION__, (std::string(__FILE__)+":"+std::to_string(__LINE__)).c_str())
+
 #endif
@@ -2,6 +2,7 @@
 #define OMEGA_H_QUALITY_HPP
 
 #include <Omega_h_shape.hpp>
+#include <Omega_h_simd.hpp>
 
 namespace Omega_h {
 
@@ -35,6 +36,60 @@ OMEGA_H_INLINE Real metric_element_quality(
   return mean_ratio<dim>(s, msl);
 }
 
+#ifdef OMEGA_H_SIMD_BATCHES
+
+namespace simd {
+
+inline Pack simplex_size_from_basis(Few<Vector<2>, 2> b) {
+  return cross(b[0], b[1]) / 2.0;
+}
+
+inline Pack simplex_size_from_basis(Few<Vector<3>, 3> b) {
+  return inner_product(cross(b[0], b[1]), b[2]) / 6.0;
+}
+
+inline Few<Vector<2>, 3> element_edge_vectors(
+    Few<Vector<2>, 3> p, Few<Vector<2>, 2> b) {
+  Few<Vector<2>, 3> ev;
+  ev[0] = b[0];
+  ev[1] = p[2] - p[1];
+  ev[2] = p[0] - p[2];
+  return ev;
+}
+
+inline Few<Vector<3>, 6> element_edge_vectors(
+    Few<Vector<3>, 4> p, Few<Vector<3>, 3> b) {
+  Few<Vector<3>, 6> ev;
+  ev[0] = b[0];
+  ev[1] = p[2] - p[1];
+  ev[2] = p[0] - p[2];
+  ev[3] = b[2];
+  ev[4] = p[3] - p[1];
+  ev[5] = p[3] - p[2];
+  return ev;
+}
+
+template <Int dim, Int metric_dim>
+inline Pack metric_element_quality(
+    Few<Vector<dim>, dim + 1> p, Symm<metric_dim> metric) {
+  Few<Vector<dim>, dim> b;
+  for (Int i = 0; i < dim; ++i) b[i] = p[i + 1] - p[0];
+  auto rs = simplex_size_from_basis(b);
+  auto s = rs * power<dim, 2 * metric_dim>(determinant(metric));
+  auto ev = element_edge_vectors(p, b);
+  auto msl = metric_product(metric, ev[0]);
+  for (Int i = 1; i < ev.size(); ++i) {
+    msl = msl + metric_product(metric, ev[i]);
+  }
+  msl = msl / Real(ev.size());
+  auto mr = power<2, dim>(s / equilateral_simplex_size(dim)) / msl;
+  return map(s, mr, [](Real sl, Real mrl) { return (sl < 0) ? sl : mrl; });
+}
+
+}  // end namespace simd
+
+#endif
+
 template <Int space_dim, Int metric_dim>
 struct MetricElementQualities {
   Reals coords;
@@ -49,6 +104,14 @@ struct MetricElementQualities {
     auto m = maxdet_metric(ms);
     return metric_element_quality(p, m);
   }
+#ifdef OMEGA_H_SIMD_BATCHES
+  simd::Pack measure(simd::Verts<space_dim + 1> const& v) const {
+    auto p = simd::gather_vectors<space_dim + 1, space_dim>(coords, v);
+    auto ms = simd::gather_symms<space_dim + 1, metric_dim>(metrics, v);
+    auto m = simd::maxdet_metric(ms);
+    return simd::metric_element_quality<space_dim, metric_dim>(p, m);
+  }
+#endif
 };
 
 Reals measure_qualities(Mesh* mesh, LOs a2e, Reals metrics);
@@ -0,0 +1,223 @@
+#include "Omega_h_rebalance.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+#include "Omega_h_array_ops.hpp"
+#include "Omega_h_for.hpp"
+#include "Omega_h_mark.hpp"
+#include "Omega_h_mesh.hpp"
+#include "Omega_h_vector.hpp"
+
+namespace Omega_h {
+
+Read<I32> get_vert_neighbor_ranks(Mesh* mesh) {
+  auto rank = mesh->comm()->rank();
+  auto copies2owners = mesh->ask_dist(VERT);
+  auto owner_ranks = HostRead<I32>(copies2owners.msgs2ranks());
+  auto copy_ranks = HostRead<I32>(copies2owners.invert().msgs2ranks());
+  std::vector<I32> ranks;
+  for (LO i = 0; i < owner_ranks.size(); ++i) ranks.push_back(owner_ranks[i]);
+  for (LO i = 0; i < copy_ranks.size(); ++i) ranks.push_back(copy_ranks[i]);
+  std::sort(ranks.begin(), ranks.end());
+  ranks.erase(std::unique(ranks.begin(), ranks.end()), ranks.end());
+  ranks.erase(std::remove(ranks.begin(), ranks.end(), rank), ranks.end());
+  HostWrite<I32> out(LO(ranks.size()));
+  for (LO i = 0; i < out.size(); ++i) out[i] = ranks[std::size_t(i)];
+  return out.write();
+}
+
+namespace {
+
+/* first-order diffusion on the rank graph, using the
+   per-edge coefficients 1/(max(deg_i, deg_j) + 1) which guarantee
+   convergence on arbitrary graphs.
+   the flow along each edge is the accumulated difference,
+   which is antisymmetric between the two endpoints by construction. */
+bool solve_diffusion_flows(CommPtr comm, CommPtr nbr_comm, Real load,
+    Real target, std::vector<Real>& flows, Int* p_niters) {
+  constexpr Int max_iters = 1000;
+  auto nnbrs = nbr_comm->destinations().size();
+  auto nbr_degrees = HostRead<I32>(nbr_comm->allgather(I32(nnbrs)));
+  auto coeffs = std::vector<Real>(std::size_t(nnbrs));
+  for (LO k = 0; k < nnbrs; ++k) {
+    coeffs[std::size_t(k)] = 1.0 / Real(max2(I32(nnbrs), nbr_degrees[k]) + 1);
+  }
+  flows.assign(std::size_t(nnbrs), 0.0);
+  auto x = load;
+  for (Int iter = 0; iter < max_iters; ++iter) {
+    if (comm->allreduce(x, OMEGA_H_MAX) <= target) {
+      *p_niters = iter;
+      return true;
+    }
+    auto nbr_x = HostRead<Real>(nbr_comm->allgather(x));
+    Real dx = 0.0;
+    for (LO k = 0; k < nnbrs; ++k) {
+      auto df = coeffs[std::size_t(k)] * (x - nbr_x[k]);
+      flows[std::size_t(k)] += df;
+      dx -= df;
+    }
+    x += dx;
+  }
+  return false;
+}
+
+Real get_marked_mass(Reals masses, Read<I8> marked) {
+  auto n = masses.size();
+  Write<Real> weighted(n);
+  auto f = OMEGA_H_LAMBDA(LO i) {
+    weighted[i] = (Real(marked[i]) * masses[i]);
+  };
+  parallel_for(n, f, "get_marked_mass");
+  return get_sum(Reals(weighted));
+}
+
+Vector<3> get_local_center(Reals coords, Reals masses, Real total_mass) {
+  auto n = masses.size();
+  Write<Real> weighted_coords(n * 3);
+  auto f = OMEGA_H_LAMBDA(LO i) {
+    set_vector<3>(weighted_coords, i, masses[i] * get_vector<3>(coords, i));
+  };
+  parallel_for(n, f, "get_local_center");
+  Vector<3> result;
+  for (Int j = 0; j < 3; ++j) {
+    result[j] = get_sum(get_component(Reals(weighted_coords), 3, j));
+  }
+  if (total_mass > 0.0) result = result / total_mass;
+  return result;
+}
+
+Read<I8> mark_verts_shared_with(
+    Read<I32> verts2owner_ranks, Dist owners2copies, I32 nbr_rank) {
+  auto verts2copies = owners2copies.roots2items();
+  auto copies2ranks = owners2copies.items2ranks();
+  auto nverts = verts2owner_ranks.size();
+  Write<I8> marked(nverts);
+  auto f = OMEGA_H_LAMBDA(LO v) {
+    I8 m = (verts2owner_ranks[v] == nbr_rank);
+    for (auto c = verts2copies[v]; c < verts2copies[v + 1]; ++c) {
+      if (copies2ranks[c] == nbr_rank) m = 1;
+    }
+    marked[v] = m;
+  };
+  parallel_for(nverts, f, "mark_verts_shared_with");
+  return marked;
+}
+
+/* among the marked elements, choose those furthest along (keys)
+   whose total mass does not exceed (flow).
+   this is a local version of the RIB cutting plane search */
+Read<I8> mark_furthest(
+    Reals keys, Reals masses, Read<I8> candidates, Real flow) {
+  if (get_marked_mass(masses, candidates) <= flow) return candidates;
+  auto lo = get_min(keys) - 1.0;
+  auto hi = get_max(keys);
+  auto n = keys.size();
+  auto mark_beyond = [=](Real cut) {
+    Write<I8> marked(n);
+    auto f = OMEGA_H_LAMBDA(LO i) {
+      marked[i] = (candidates[i] && keys[i] > cut);
+    };
+    parallel_for(n, f, "mark_beyond");
+    return Read<I8>(marked);
+  };
+  for (Int i = 0; i < MANTISSA_BITS; ++i) {
+    auto mid = (lo + hi) / 2.0;
+    if (get_marked_mass(masses, mark_beyond(mid)) > flow) {
+      lo = mid;
+    } else {
+      hi = mid;
+    }
+  }
+  return mark_beyond(hi);
+}
+
+}  // end anonymous namespace
+
+bool diffuse_elem_dest_ranks(Mesh* mesh, Reals masses, Real tolerance,
+    Read<I32>* p_dest_ranks, bool verbose) {
+  OMEGA_H_TIME_FUNCTION;
+  auto comm = mesh->comm();
+  auto rank = comm->rank();
+  auto dim = mesh->dim();
+  auto nelems = mesh->nelems();
+  OMEGA_H_CHECK(mesh->parting() == OMEGA_H_ELEM_BASED);
+  OMEGA_H_CHECK(masses.size() == nelems);
+  auto load = get_sum(masses);
+  auto avg = comm->allreduce(load, OMEGA_H_SUM) / Real(comm->size());
+  /* aim halfway between perfect balance and the tolerance,
+     which leaves room for the granularity of whole elements */
+  auto target = avg * (1.0 + (tolerance - 1.0) / 2.0);
+  auto nbrs = get_vert_neighbor_ranks(mesh);
+  auto nbr_comm = comm->graph_adjacent(nbrs, nbrs);
+  std::vector<Real> flows;
+  Int niters = 0;
+  if (!solve_diffusion_flows(comm, nbr_comm, load, target, flows, &niters)) {
+    if (verbose && rank == 0) {
+      std::cout << "load diffusion did not converge\n";
+    }
+    return false;
+  }
+  if (verbose && rank == 0) {
+    std::cout << "load diffusion converged in " << niters << " iterations\n";
+  }
+  /* we can only send elements we have right now; if this rank is
+     meant to relay load further along then that will be
+     finished by a subsequent round */
+  Real total_out = 0.0;
+  for (auto flow : flows) total_out += max2(flow, 0.0);
+  if (total_out > load) {
+    for (auto& flow : flows) flow *= load / total_out;
+  }
+  auto ecoords =
+      average_field(mesh, dim, LOs(nelems, 0, 1), dim, mesh->coords());
+  if (dim < 3) ecoords = resize_vectors(ecoords, dim, 3);
+  auto center = get_local_center(ecoords, masses, load);
+  HostRead<Real> nbr_centers[3];
+  for (Int j = 0; j < 3; ++j) {
+    nbr_centers[j] = HostRead<Real>(nbr_comm->allgather(center[j]));
+  }
+  auto nbrs_h = HostRead<I32>(nbrs);
+  auto verts2owner_ranks = mesh->ask_owners(VERT).ranks;
+  auto owners2copies = mesh->ask_dist(VERT).invert();
+  auto verts2elems = mesh->ask_up(VERT, dim);
+  Write<I32> dest_ranks(nelems, rank);
+  for (LO k = 0; k < nbrs_h.size(); ++k) {
+    auto flow = flows[std::size_t(k)];
+    if (!(flow > 0.0)) continue;
+    auto nbr_rank = nbrs_h[k];
+    auto are_free = each_eq_to(Read<I32>(dest_ranks), rank);
+    auto vert_marks =
+        mark_verts_shared_with(verts2owner_ranks, owners2copies, nbr_rank);
+    auto candidates = land_each(mark_up(mesh, VERT, dim, vert_marks), are_free);
+    /* grow the boundary layer inwards until it can carry the flow */
+    auto candidate_mass = get_marked_mass(masses, candidates);
+    while (candidate_mass < flow) {
+      vert_marks = mark_down(verts2elems, candidates);
+      auto grown =
+          land_each(mark_up(mesh, VERT, dim, vert_marks), are_free);
+      auto grown_mass = get_marked_mass(masses, grown);
+      if (!(grown_mass > candidate_mass)) break;
+      candidates = grown;
+      candidate_mass = grown_mass;
+    }
+    Vector<3> nbr_center;
+    for (Int j = 0; j < 3; ++j) nbr_center[j] = nbr_centers[j][k];
+    auto axis = nbr_center - center;
+    Write<Real> keys(nelems);
+    auto f = OMEGA_H_LAMBDA(LO e) {
+      keys[e] = (get_vector<3>(ecoords, e) - center) * axis;
+    };
+    parallel_for(nelems, f, "diffusion_keys");
+    auto selected = mark_furthest(keys, masses, candidates, flow);
+    auto g = OMEGA_H_LAMBDA(LO e) {
+      if (selected[e]) dest_ranks[e] = nbr_rank;
+    };
+    parallel_for(nelems, g, "diffusion_dest_ranks");
+  }
+  *p_dest_ranks = dest_ranks;
+  return true;
+}
+
+}  // end namespace Omega_h
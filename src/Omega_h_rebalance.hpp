@@ -0,0 +1,34 @@
+#ifndef OMEGA_H_REBALANCE_HPP
+#define OMEGA_H_REBALANCE_HPP
+
+#include <Omega_h_array.hpp>
+
+namespace Omega_h {
+
+class Mesh;
+
+/* the ranks which share at least one vertex with this rank,
+   as seen through vertex ownership (each copy knows its owner
+   and each owner knows its copies).
+   this relation is symmetric, so it can be used directly
+   as both the sources and destinations of a graph communicator */
+Read<I32> get_vert_neighbor_ranks(Mesh* mesh);
+
+/* diffusive (incremental) load balancing.
+   given per-element masses on an element-based partitioning,
+   solve for the load that has to flow across each edge of the
+   rank graph (ranks sharing vertices) in order to bring
+   the maximum load under (tolerance) times the average,
+   then select just enough elements along each partition
+   boundary to realize those flows.
+   the output is the destination rank of each element, which
+   is this rank for all elements that stay put.
+   returns false if the flow problem could not be solved,
+   for example because the rank graph is disconnected, in which
+   case the caller should fall back to a full repartitioning. */
+bool diffuse_elem_dest_ranks(Mesh* mesh, Reals masses, Real tolerance,
+    Read<I32>* p_dest_ranks, bool verbose);
+
+}  // end namespace Omega_h
+
+#endif
@@ -19,6 +19,9 @@
 #ifdef __GNUC__
 #pragma GCC diagnostic pop
 #endif
+#elif defined(OMEGA_H_USE_THREADS)
+#include <Omega_h_threads.hpp>
+#include <vector>
 #endif
 
 namespace Omega_h {
@@ -160,6 +163,38 @@ Result transform_reduce(Iterator first, Iterator last, Result init,
   return init;
 }
 
+#elif defined(OMEGA_H_USE_THREADS)
+
+/* each thread folds the chunks it runs into a partial result of its own,
+   then the partial results are folded in thread order */
+template <class Iterator, class Tranform, class Result, class Op>
+Result transform_reduce(
+    Iterator first, Iterator last, Result init, Op op, Tranform&& transform) {
+  LO const n = LO(last - first);
+  Omega_h::entering_parallel = true;
+  auto const transform_local = std::move(transform);
+  Omega_h::entering_parallel = false;
+  struct Partial {
+    Result value;
+    bool is_set;
+    char padding[64];
+  };
+  std::vector<Partial> partials(std::size_t(threads::num_threads()));
+  threads::for_each_range(n, [&](LO begin, LO end, Int thread) {
+    Result value = transform_local(first[begin]);
+    for (LO i = begin + 1; i < end; ++i) {
+      value = op(std::move(value), transform_local(first[i]));
+    }
+    auto& partial = partials[std::size_t(thread)];
+    partial.value = partial.is_set ? op(std::move(partial.value), value) : value;
+    partial.is_set = true;
+  });
+  for (auto& partial : partials) {
+    if (partial.is_set) init = op(std::move(init), partial.value);
+  }
+  return init;
+}
+
 #else
 
 template <class Iterator, class Tranform, class Result, class Op>
@@ -2,10 +2,13 @@
 
 #include <iostream>
 
+#include "Omega_h_arena.hpp"
 #include "Omega_h_array_ops.hpp"
+#include "Omega_h_for.hpp"
 #include "Omega_h_indset.hpp"
 #include "Omega_h_map.hpp"
 #include "Omega_h_mesh.hpp"
+#include "Omega_h_migrate.hpp"
 #include "Omega_h_modify.hpp"
 #include "Omega_h_profile.hpp"
 #include "Omega_h_refine_qualities.hpp"
@@ -40,6 +43,116 @@ static bool refine_ghosted(Mesh* mesh, AdaptOpts const& opts) {
   return true;
 }
 
+/* on an element-based mesh the owner of a vertex doesn't see all the
+   key edges it represents, so the owner of each key edge sends the
+   edge's global number to the owner of its first vertex, which orders
+   the key edges it represents by global number.
+   gives the same numbers on all copies, like get_rep2md_order_adapt() */
+static LOs get_rep_vertex2md_order_by_globals(
+    Mesh* mesh, Read<I8> edges_are_keys) {
+  auto const nedges = mesh->nedges();
+  auto const owned_keys2edges =
+      collect_marked(land_each(edges_are_keys, mesh->owned(EDGE)));
+  auto const nkeys = owned_keys2edges.size();
+  auto const ev2v = mesh->ask_verts_of(EDGE);
+  auto const vert_owners = mesh->ask_owners(VERT);
+  auto const edge_globals = mesh->globals(EDGE);
+  Write<I32> rep_ranks(nkeys);
+  Write<LO> rep_idxs(nkeys);
+  Write<GO> key_globals(nkeys);
+  auto f = OMEGA_H_LAMBDA(LO key) {
+    auto const edge = owned_keys2edges[key];
+    auto const rep = ev2v[edge * 2 + 0];
+    rep_ranks[key] = vert_owners.ranks[rep];
+    rep_idxs[key] = vert_owners.idxs[rep];
+    key_globals[key] = edge_globals[edge];
+  };
+  parallel_for(nkeys, f, "get_rep_vertex2md_order(send)");
+  auto const keys2reps = Dist(mesh->comm(),
+      Remotes(Read<I32>(rep_ranks), LOs(rep_idxs)), mesh->nverts());
+  auto reps2keys = keys2reps.invert();
+  auto const reps2rep_keys = reps2keys.roots2items();
+  /* the orders are sent back per key, not per representative */
+  reps2keys.set_roots2items(LOs());
+  auto const rep_key_globals = keys2reps.exch(Read<GO>(key_globals), 1);
+  Write<LO> rep_key_orders(rep_key_globals.size());
+  auto g = OMEGA_H_LAMBDA(LO rep) {
+    auto const begin = reps2rep_keys[rep];
+    auto const end = reps2rep_keys[rep + 1];
+    for (auto rep_key = begin; rep_key < end; ++rep_key) {
+      LO order = 0;
+      for (auto other = begin; other < end; ++other) {
+        if (rep_key_globals[other] < rep_key_globals[rep_key]) ++order;
+      }
+      rep_key_orders[rep_key] = order;
+    }
+  };
+  parallel_for(mesh->nverts(), g, "get_rep_vertex2md_order(order)");
+  auto const key_orders = reps2keys.exch(LOs(rep_key_orders), 1);
+  auto const orders =
+      map_onto(key_orders, owned_keys2edges, nedges, LO(-1), 1);
+  return mesh->sync_array(EDGE, orders, 1);
+}
+
+/* sends the elements around each key edge to the owner of the edge,
+   so each cavity is on one rank. only the elements around keys on
+   partition boundaries move, and nothing migrates if there are none */
+static void gather_key_cavities(Mesh* mesh, Read<I8> edges_are_keys) {
+  auto const comm = mesh->comm();
+  auto const dim = mesh->dim();
+  if (dim == 1 || comm->size() == 1) return;
+  auto const keys2edges = collect_marked(edges_are_keys);
+  auto const edges2elems = mesh->ask_up(EDGE, dim);
+  auto const edges2edge_elems = edges2elems.a2ab;
+  auto const edge_elems2elems = edges2elems.ab2b;
+  auto const edge_ranks = mesh->ask_owners(EDGE).ranks;
+  auto const nelems = mesh->nelems();
+  Write<I32> dest_ranks(nelems, comm->rank());
+  auto f = OMEGA_H_LAMBDA(LO key) {
+    auto const edge = keys2edges[key];
+    for (auto edge_elem = edges2edge_elems[edge];
+         edge_elem < edges2edge_elems[edge + 1]; ++edge_elem) {
+      dest_ranks[edge_elems2elems[edge_elem]] = edge_ranks[edge];
+    }
+  };
+  parallel_for(keys2edges.size(), f, "gather_key_cavities");
+  auto const elems_move = each_neq_to(Read<I32>(dest_ranks), comm->rank());
+  if (get_max(comm, elems_move) != 1) return;
+  Dist old2new;
+  old2new.set_parent_comm(comm);
+  old2new.set_dest_ranks(dest_ranks);
+  old2new.set_roots2items(LOs(nelems + 1, 0, 1));
+  old2new.set_dest_globals(mesh->globals(dim));
+  migrate_mesh(mesh, old2new.invert(), OMEGA_H_ELEM_BASED, false);
+}
+
+/* the element-based counterpart of refine_ghosted().
+   each copy of an edge sees part of its cavity, so qualities are
+   reduced over the copies and the independent set combines their
+   decisions (see indset::iteration()) */
+static bool refine_without_ghosts(Mesh* mesh, AdaptOpts const& opts) {
+  auto comm = mesh->comm();
+  auto edges_are_cands = mesh->get_array<I8>(EDGE, "candidate");
+  mesh->remove_tag(EDGE, "candidate");
+  auto cands2edges = collect_marked(edges_are_cands);
+  auto cand_quals = refine_qualities(mesh, cands2edges);
+  auto nedges = mesh->nedges();
+  auto edge_quals = map_onto(cand_quals, cands2edges, nedges, 0.0, 1);
+  edge_quals = mesh->reduce_array(EDGE, edge_quals, 1, OMEGA_H_MIN);
+  edge_quals = mesh->sync_array(EDGE, edge_quals, 1);
+  auto edges_are_initial = land_each(
+      edges_are_cands, each_geq_to(edge_quals, opts.min_quality_allowed));
+  if (get_max(comm, edges_are_initial) != 1) return false;
+  /* the other overload requires the owners to see the whole star */
+  auto edges_are_keys = find_indset(
+      mesh, EDGE, mesh->ask_star(EDGE), edge_quals, edges_are_initial);
+  mesh->add_tag(EDGE, "key", 1, edges_are_keys);
+  mesh->add_tag(EDGE, "rep_vertex2md_order", 1,
+      get_rep_vertex2md_order_by_globals(mesh, edges_are_keys));
+  gather_key_cavities(mesh, edges_are_keys);
+  return true;
+}
+
 static void refine_element_based(Mesh* mesh, AdaptOpts const& opts) {
   auto comm = mesh->comm();
   auto edges_are_keys = mesh->get_array<I8>(EDGE, "key");
@@ -82,15 +195,21 @@ static void refine_element_based(Mesh* mesh, AdaptOpts const& opts) {
 }
 
 static bool refine(Mesh* mesh, AdaptOpts const& opts) {
-  mesh->set_parting(OMEGA_H_GHOSTED);
-  if (!refine_ghosted(mesh, opts)) return false;
-  mesh->set_parting(OMEGA_H_ELEM_BASED);
+  if (opts.should_refine_without_ghosts &&
+      mesh->parting() == OMEGA_H_ELEM_BASED) {
+    if (!refine_without_ghosts(mesh, opts)) return false;
+  } else {
+    mesh->set_parting(OMEGA_H_GHOSTED);
+    if (!refine_ghosted(mesh, opts)) return false;
+    mesh->set_parting(OMEGA_H_ELEM_BASED);
+  }
   refine_element_based(mesh, opts);
   return true;
 }
 
 bool refine_by_size(Mesh* mesh, AdaptOpts const& opts) {
-  OMEGA_H_TIME_FUNCTION;
+  OMEGA_H_TIME_PHASE;
+  ScopedArena arena;
   auto comm = mesh->comm();
   auto lengths = mesh->ask_lengths();
   auto edge_is_cand = each_gt(lengths, opts.max_length_desired);
@@ -276,8 +276,8 @@ OMEGA_H_INLINE bool are_close(
   return rel_diff_with_floor(a, b, floor) <= tol;
 }
 
-template <typename T>
-T divide_no_remainder(T a, T b) {
+template <typename T, typename U>
+T divide_no_remainder(T a, U b) {
   OMEGA_H_CHECK(b != 0);
   OMEGA_H_CHECK(a % b == 0);
   return a / b;
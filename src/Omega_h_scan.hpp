@@ -36,6 +36,11 @@ namespace cub = thrust::cuda_cub::cub;
 
 #include <omp.h>
 
+#elif defined(OMEGA_H_USE_THREADS)
+
+#include <Omega_h_threads.hpp>
+#include <vector>
+
 #endif
 
 namespace Omega_h {
@@ -190,6 +195,78 @@ OutputIterator transform_inclusive_scan(InputIterator first, InputIterator last,
   return result + n;
 }
 
+#elif defined(OMEGA_H_USE_THREADS)
+
+/* the input is cut into a few blocks per thread. the blocks are summed
+   in parallel, the block sums are scanned serially, then the blocks
+   are scanned in parallel starting from the sum of the blocks before */
+template <typename InputIterator, typename OutputIterator, typename Transform,
+    typename Op>
+OutputIterator transform_inclusive_scan(InputIterator first, InputIterator last,
+    OutputIterator result, Op op, Transform&& transform) {
+  LO const n = LO(last - first);
+  if (n <= 0) return result;
+  Omega_h::entering_parallel = true;
+  auto const transform_local = std::move(transform);
+  Omega_h::entering_parallel = false;
+  using T_const_ref = decltype(transform_local(*first));
+  using T_const = typename std::remove_reference<T_const_ref>::type;
+  using T = typename std::remove_const<T_const>::type;
+  constexpr LO min_block_size = 1024;
+  LO const nblocks =
+      (n < 4 * min_block_size)
+          ? 1
+          : min2(n / min_block_size, LO(4 * threads::num_threads()));
+  auto block_begin = [=](LO block) { return LO((I64(n) * block) / nblocks); };
+  std::vector<T> block_sums(static_cast<std::size_t>(nblocks));
+  threads::for_each_range(nblocks - 1,
+      [&](LO first_block, LO end_block, Int) {
+        for (auto block = first_block; block < end_block; ++block) {
+          auto const end = block_begin(block + 1);
+          auto i = block_begin(block);
+          T sum = transform_local(first[i]);
+          for (++i; i < end; ++i) {
+            sum = op(std::move(sum), transform_local(first[i]));
+          }
+          block_sums[std::size_t(block)] = std::move(sum);
+        }
+      },
+      1);
+  for (LO block = 1; block + 1 < nblocks; ++block) {
+    block_sums[std::size_t(block)] = op(block_sums[std::size_t(block - 1)],
+        std::move(block_sums[std::size_t(block)]));
+  }
+  threads::for_each_range(nblocks,
+      [&](LO first_block, LO end_block, Int) {
+        for (auto block = first_block; block < end_block; ++block) {
+          auto const end = block_begin(block + 1);
+          auto i = block_begin(block);
+          T value = transform_local(first[i]);
+          if (block) {
+            value = op(block_sums[std::size_t(block - 1)], std::move(value));
+          }
+          result[i] = value;
+          for (++i; i < end; ++i) {
+            value = op(std::move(value), transform_local(first[i]));
+            result[i] = value;
+          }
+        }
+      },
+      1);
+  return result + n;
+}
+
+template <typename InputIterator, typename OutputIterator>
+OutputIterator inclusive_scan(
+    InputIterator first, InputIterator last, OutputIterator result) {
+  using T_const_ref = decltype(*first);
+  using T_const = typename std::remove_reference<T_const_ref>::type;
+  using T = typename std::remove_const<T_const>::type;
+  return transform_inclusive_scan(
+      first, last, result, [](T const& a, T const& b) { return T(a + b); },
+      [](T const& a) { return a; });
+}
+
 #else
 
 template <typename InputIterator, typename OutputIterator>
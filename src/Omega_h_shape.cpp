@@ -10,12 +10,24 @@ Reals measure_edges_metric_tmpl(Mesh* mesh, LOs a2e, Reals metrics) {
   auto ev2v = mesh->ask_verts_of(EDGE);
   auto na = a2e.size();
   Write<Real> lengths(na);
+#ifdef OMEGA_H_SIMD_BATCHES
+  auto ntiles = (na + simd::width - 1) / simd::width;
+  auto f = OMEGA_H_LAMBDA(LO tile) {
+    auto begin = tile * simd::width;
+    auto n = min2(LO(simd::width), na - begin);
+    auto v = simd::gather_verts<2>(ev2v, a2e, begin, n);
+    auto tile_lengths = measurer.measure(v);
+    for (Int i = 0; i < n; ++i) lengths[begin + i] = tile_lengths[i];
+  };
+  parallel_for(ntiles, f, "measure_edges");
+#else
   auto f = OMEGA_H_LAMBDA(LO a) {
     auto e = a2e[a];
     auto v = gather_verts<2>(ev2v, e);
     lengths[a] = measurer.measure(v);
   };
   parallel_for(na, f, "measure_edges");
+#endif
   return lengths;
 }
 
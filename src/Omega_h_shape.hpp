@@ -6,6 +6,7 @@
 #include <Omega_h_mesh.hpp>
 #include <Omega_h_metric.hpp>
 #include <Omega_h_qr.hpp>
+#include <Omega_h_simd.hpp>
 #include <Omega_h_simplex.hpp>
 
 namespace Omega_h {
@@ -122,6 +123,23 @@ OMEGA_H_DEVICE Real metric_edge_length(
   return metric_edge_length<space_dim, metric_dim>(p, ms);
 }
 
+#ifdef OMEGA_H_SIMD_BATCHES
+
+namespace simd {
+
+template <Int space_dim, Int metric_dim>
+inline Pack metric_edge_length(
+    Few<Vector<space_dim>, 2> p, Few<Symm<metric_dim>, 2> ms) {
+  auto v = p[1] - p[0];
+  auto l_a = sqrt(metric_product(ms[0], v));
+  auto l_b = sqrt(metric_product(ms[1], v));
+  return map(l_a, l_b, anisotropic_edge_length);
+}
+
+}  // end namespace simd
+
+#endif
+
 template <Int space_dim>
 struct RealEdgeLengths {
   Reals coords;
@@ -143,6 +161,13 @@ struct MetricEdgeLengths {
   OMEGA_H_DEVICE Real measure(Few<LO, 2> v) const {
     return metric_edge_length<space_dim, metric_dim>(v, coords, metrics);
   }
+#ifdef OMEGA_H_SIMD_BATCHES
+  simd::Pack measure(simd::Verts<2> const& v) const {
+    auto p = simd::gather_vectors<2, space_dim>(coords, v);
+    auto ms = simd::gather_symms<2, metric_dim>(metrics, v);
+    return simd::metric_edge_length<space_dim, metric_dim>(p, ms);
+  }
+#endif
 };
 
 Reals measure_edges_real(Mesh* mesh, LOs a2e);
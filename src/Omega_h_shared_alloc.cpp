@@ -1,3 +1,4 @@
+#include <Omega_h_arena.hpp>
 #include <Omega_h_fail.hpp>
 #include <Omega_h_library.hpp>
 #include <Omega_h_malloc.hpp>
@@ -55,8 +56,29 @@ Alloc::Alloc(std::size_t size_in, std::string&& name_in)
   init();
 }
 
+/* adopted memory is not tracked, it was never allocated here */
+Alloc::Alloc(std::size_t size_in, std::string const& name_in, void* ptr_in,
+    std::function<void()> release_in)
+    : size(size_in),
+      name(name_in),
+      ptr(ptr_in),
+      chunk(nullptr),
+      release(std::move(release_in)),
+      use_count(1),
+      prev(nullptr),
+      next(nullptr) {}
+
 OMEGA_H_DLL Alloc::~Alloc() {
-  ::Omega_h::maybe_pooled_device_free(ptr, size);
+  if (release) {
+    release();
+    return;
+  }
+  if (chunk) {
+    ::Omega_h::arena_deallocate(chunk);
+  } else {
+    ::Omega_h::maybe_pooled_device_free(ptr, size);
+  }
+  record_free(size);
   auto ga = global_allocs;
   if (ga) {
     if (next == nullptr) {
@@ -74,7 +96,8 @@ OMEGA_H_DLL Alloc::~Alloc() {
 }
 
 void Alloc::init() {
-  ptr = ::Omega_h::maybe_pooled_device_malloc(size);
+  ptr = ::Omega_h::arena_allocate(size, &chunk);
+  if (!chunk) ptr = ::Omega_h::maybe_pooled_device_malloc(size);
   use_count = 1;
   auto ga = global_allocs;
   if (size && (ptr == nullptr)) {
@@ -90,6 +113,7 @@ void Alloc::init() {
     auto s = ss.str();
     Omega_h_fail("%s\n", s.c_str());
   }
+  record_alloc(size);
   if (ga) {
     auto old_last = ga->last;
     this->prev = old_last;
@@ -124,6 +148,12 @@ SharedAlloc::SharedAlloc(std::size_t size_in, std::string&& name_in) {
 
 SharedAlloc::SharedAlloc(std::size_t size_in) : SharedAlloc(size_in, "") {}
 
+SharedAlloc::SharedAlloc(std::size_t size_in, std::string const& name_in,
+    void* ptr_in, std::function<void()> release_in) {
+  alloc = new Alloc(size_in, name_in, ptr_in, std::move(release_in));
+  direct_ptr = alloc->ptr;
+}
+
 SharedAlloc SharedAlloc::identity(std::size_t size_in) {
   SharedAlloc out;
   out.direct_ptr = nullptr;
@@ -3,12 +3,14 @@
 
 #include <Omega_h_macros.h>
 #include <cstddef>
+#include <functional>
 #include <string>
 #include <vector>
 
 namespace Omega_h {
 
 class Library;
+struct ArenaChunk;
 
 struct Allocs;
 
@@ -22,11 +24,18 @@ struct Alloc {
   std::size_t size;
   std::string name;
   void* ptr;
+  /* non-null if (ptr) was carved out of an arena chunk */
+  ArenaChunk* chunk;
+  /* set if (ptr) belongs to someone else, who gets
+     it back through this instead of it being freed */
+  std::function<void()> release;
   int use_count;
   Alloc* prev;
   Alloc* next;
   Alloc(std::size_t size_in, std::string const& name_in);
   Alloc(std::size_t size_in, std::string&& name_in);
+  Alloc(std::size_t size_in, std::string const& name_in, void* ptr_in,
+      std::function<void()> release_in);
   OMEGA_H_DLL ~Alloc();
   Alloc(Alloc const&) = delete;
   Alloc(Alloc&&) = delete;
@@ -55,6 +64,9 @@ struct SharedAlloc {
   SharedAlloc(std::size_t size_in, std::string const& name_in);
   SharedAlloc(std::size_t size_in, std::string&& name_in);
   SharedAlloc(std::size_t size_in);
+  /* adopts memory owned by someone else, see Alloc::release */
+  SharedAlloc(std::size_t size_in, std::string const& name_in, void* ptr_in,
+      std::function<void()> release_in);
   enum : std::uintptr_t {
     FREE_BIT1 = 0x1,
     FREE_BIT2 = 0x2,
@@ -0,0 +1,261 @@
+#ifndef OMEGA_H_SIMD_HPP
+#define OMEGA_H_SIMD_HPP
+
+#include <Omega_h_array.hpp>
+#include <Omega_h_few.hpp>
+#include <Omega_h_matrix.hpp>
+
+/* batched kernels evaluate (simd::width) simplices per call.
+ * the vertex data of all of them is gathered into structure-of-arrays
+ * form, where each simd::Pack holds one value for every simplex,
+ * so each arithmetic operation is one SIMD instruction for all of them.
+ *
+ * with GCC-compatible compilers a Pack is a vector extension type,
+ * which the compiler lowers to whatever SIMD instructions the target
+ * has (two doubles with SSE2 or NEON, four with AVX, eight with AVX-512).
+ * elsewhere it is a plain array and the same code runs lane by lane.
+ *
+ * the operations below follow the same formulas as their scalar
+ * counterparts in Omega_h_matrix.hpp and friends, and non-arithmetic
+ * functions (roots, logarithms) apply the scalar versions lane by lane.
+ * the compiler may still contract or reorder the two paths differently
+ * (fused multiply-adds, for one), so batched and scalar kernels agree
+ * only to rounding and are not bitwise reproducible against each other.
+ *
+ * batched kernels run on the host only, so they are only used by the
+ * serial and OpenMP backends (OMEGA_H_SIMD_BATCHES).
+ */
+
+#if !defined(OMEGA_H_USE_KOKKOS) && !defined(OMEGA_H_USE_CUDA)
+#define OMEGA_H_SIMD_BATCHES
+#endif
+
+#if defined(__GNUC__) && !defined(__CUDACC__)
+#define OMEGA_H_SIMD_VECTOR_EXTENSIONS
+#endif
+
+namespace Omega_h {
+
+namespace simd {
+
+#ifdef OMEGA_H_SIMD_VECTOR_EXTENSIONS
+
+/* the natural vector length of the target, so that Packs
+   are passed around in registers */
+#if defined(__AVX512F__)
+enum : Int { width = 8 };
+#elif defined(__AVX__)
+enum : Int { width = 4 };
+#else
+enum : Int { width = 2 };
+#endif
+
+typedef Real Pack __attribute__((vector_size(width * sizeof(Real))));
+
+#else
+
+enum : Int { width = 4 };
+
+struct Pack {
+  Real lanes[width];
+  inline Real& operator[](Int i) { return lanes[i]; }
+  inline Real const& operator[](Int i) const { return lanes[i]; }
+};
+
+#define OMEGA_H_SIMD_BINARY_OP(op)                                             \
+  inline Pack operator op(Pack a, Pack b) {                                    \
+    Pack c;                                                                    \
+    for (Int i = 0; i < width; ++i) c[i] = a[i] op b[i];                       \
+    return c;                                                                  \
+  }                                                                            \
+  inline Pack operator op(Pack a, Real b) {                                    \
+    Pack c;                                                                    \
+    for (Int i = 0; i < width; ++i) c[i] = a[i] op b;                          \
+    return c;                                                                  \
+  }                                                                            \
+  inline Pack operator op(Real a, Pack b) {                                    \
+    Pack c;                                                                    \
+    for (Int i = 0; i < width; ++i) c[i] = a op b[i];                          \
+    return c;                                                                  \
+  }
+OMEGA_H_SIMD_BINARY_OP(+)
+OMEGA_H_SIMD_BINARY_OP(-)
+OMEGA_H_SIMD_BINARY_OP(*)
+OMEGA_H_SIMD_BINARY_OP(/)
+#undef OMEGA_H_SIMD_BINARY_OP
+
+inline Pack operator-(Pack a) {
+  Pack c;
+  for (Int i = 0; i < width; ++i) c[i] = -a[i];
+  return c;
+}
+
+#endif
+
+template <typename F>
+inline Pack map(Pack a, F const& f) {
+  Pack c;
+  for (Int i = 0; i < width; ++i) c[i] = f(a[i]);
+  return c;
+}
+
+template <typename F>
+inline Pack map(Pack a, Pack b, F const& f) {
+  Pack c;
+  for (Int i = 0; i < width; ++i) c[i] = f(a[i], b[i]);
+  return c;
+}
+
+template <Int np, Int dp>
+inline Pack power(Pack a) {
+  return map(a, [](Real x) { return Omega_h::power<np, dp>(x); });
+}
+
+inline Pack sqrt(Pack a) {
+  return map(a, [](Real x) { return std::sqrt(x); });
+}
+
+/* the vertex indices of (width) simplices, one Few per simplex.
+   callers with fewer simplices than that repeat one of them */
+template <Int nverts>
+using Verts = Few<Few<LO, nverts>, width>;
+
+/* the vertices of entities a2e[begin .. begin + n) for (n <= width),
+   padded with copies of the last one */
+template <Int nverts>
+inline Verts<nverts> gather_verts(
+    LOs const& ev2v, LOs const& a2e, LO begin, Int n) {
+  Verts<nverts> v;
+  for (Int lane = 0; lane < width; ++lane) {
+    auto e = a2e[begin + ((lane < n) ? lane : (n - 1))];
+    for (Int i = 0; i < nverts; ++i) v[lane][i] = ev2v[e * nverts + i];
+  }
+  return v;
+}
+
+template <Int n>
+using Vector = Few<Pack, n>;
+
+/* a symmetric tensor, in the packed order of symm2vector() */
+template <Int dim>
+using Symm = Few<Pack, symm_ncomps(dim)>;
+
+template <Int n>
+inline Vector<n> operator-(Vector<n> a, Vector<n> b) {
+  Vector<n> c;
+  for (Int i = 0; i < n; ++i) c[i] = a[i] - b[i];
+  return c;
+}
+
+template <Int nverts, Int dim>
+inline Few<Vector<dim>, nverts> gather_vectors(
+    Reals const& a, Verts<nverts> const& v) {
+  Few<Vector<dim>, nverts> x;
+  for (Int i = 0; i < nverts; ++i) {
+    for (Int j = 0; j < dim; ++j) {
+      for (Int lane = 0; lane < width; ++lane) {
+        x[i][j][lane] = a[v[lane][i] * dim + j];
+      }
+    }
+  }
+  return x;
+}
+
+template <Int nverts, Int dim>
+inline Few<Symm<dim>, nverts> gather_symms(
+    Reals const& a, Verts<nverts> const& v) {
+  return gather_vectors<nverts, symm_ncomps(dim)>(a, v);
+}
+
+inline Pack cross(Vector<2> a, Vector<2> b) {
+  return (a[0] * b[1] - a[1] * b[0]);
+}
+
+inline Vector<3> cross(Vector<3> a, Vector<3> b) {
+  Vector<3> c;
+  c[0] = a[1] * b[2] - a[2] * b[1];
+  c[1] = a[2] * b[0] - a[0] * b[2];
+  c[2] = a[0] * b[1] - a[1] * b[0];
+  return c;
+}
+
+inline Pack determinant(Symm<1> m) { return m[0]; }
+
+inline Pack determinant(Symm<2> m) {
+  auto a = m[0];
+  auto b = m[2];
+  auto c = m[2];
+  auto d = m[1];
+  return a * d - b * c;
+}
+
+inline Pack determinant(Symm<3> m) {
+  auto a = m[0];
+  auto b = m[3];
+  auto c = m[5];
+  auto d = m[3];
+  auto e = m[1];
+  auto f = m[4];
+  auto g = m[5];
+  auto h = m[4];
+  auto i = m[2];
+  return (a * e * i) + (b * f * g) + (c * d * h) - (c * e * g) - (b * d * i) -
+         (a * f * h);
+}
+
+/* the rows of a symmetric tensor, in the packed order of symm2vector() */
+inline Vector<2> symm_times(Symm<2> m, Vector<2> v) {
+  Vector<2> c;
+  c[0] = m[0] * v[0] + m[2] * v[1];
+  c[1] = m[2] * v[0] + m[1] * v[1];
+  return c;
+}
+
+inline Vector<3> symm_times(Symm<3> m, Vector<3> v) {
+  Vector<3> c;
+  c[0] = m[0] * v[0] + m[3] * v[1] + m[5] * v[2];
+  c[1] = m[3] * v[0] + m[1] * v[1] + m[4] * v[2];
+  c[2] = m[5] * v[0] + m[4] * v[1] + m[2] * v[2];
+  return c;
+}
+
+template <Int dim>
+inline Pack metric_product(Symm<dim> m, Vector<dim> v) {
+  return inner_product(v, symm_times(m, v));
+}
+
+/* an isotropic metric applied to a vector of any dimension */
+template <Int dim>
+inline Pack metric_product(Symm<1> m, Vector<dim> v) {
+  Vector<dim> mv;
+  for (Int i = 0; i < dim; ++i) mv[i] = v[i] * m[0];
+  return inner_product(v, mv);
+}
+
+inline Pack metric_product(Symm<1> m, Vector<1> v) {
+  Vector<1> mv;
+  mv[0] = m[0] * v[0];
+  return inner_product(v, mv);
+}
+
+template <typename T, Int n>
+inline T maxdet_metric(Few<T, n> ms) {
+  auto m = ms[0];
+  auto maxdet = determinant(m);
+  for (Int i = 1; i < n; ++i) {
+    auto det = determinant(ms[i]);
+    for (Int lane = 0; lane < width; ++lane) {
+      if (det[lane] > maxdet[lane]) {
+        for (Int j = 0; j < m.size(); ++j) m[j][lane] = ms[i][j][lane];
+        maxdet[lane] = det[lane];
+      }
+    }
+  }
+  return m;
+}
+
+}  // end namespace simd
+
+}  // end namespace Omega_h
+
+#endif
@@ -30,6 +30,10 @@ inline __host__ __device__ void va_printf(const char*, Args...) {
 #include <pss/parallel_stable_sort.hpp>
 #include <pss/pss_common.hpp>
 
+#elif defined(OMEGA_H_USE_THREADS)
+
+#include <Omega_h_threads.hpp>
+
 #endif
 
 #include "Omega_h_array_ops.hpp"
@@ -39,6 +43,39 @@ inline __host__ __device__ void va_printf(const char*, Args...) {
 
 namespace Omega_h {
 
+#if defined(OMEGA_H_USE_THREADS)
+/* sorts blocks of the range in parallel, then merges neighboring
+   blocks pairwise, a round at a time. merging a left block
+   into the one to its right keeps the sort stable */
+template <typename T, typename Comp>
+static void threads_stable_sort(T* b, T* e, Comp c) {
+  LO const n = LO(e - b);
+  LO nblocks = 1;
+  while (nblocks < threads::num_threads() && n / (2 * nblocks) >= 4096) {
+    nblocks *= 2;
+  }
+  auto block_begin = [=](LO block) { return b + (I64(n) * block) / nblocks; };
+  threads::for_each_range(nblocks,
+      [&](LO first_block, LO end_block, Int) {
+        for (auto block = first_block; block < end_block; ++block) {
+          std::stable_sort(block_begin(block), block_begin(block + 1), c);
+        }
+      },
+      1);
+  for (LO width = 1; width < nblocks; width *= 2) {
+    threads::for_each_range(nblocks / (2 * width),
+        [&](LO first_pair, LO end_pair, Int) {
+          for (auto pair = first_pair; pair < end_pair; ++pair) {
+            auto const block = pair * 2 * width;
+            std::inplace_merge(block_begin(block), block_begin(block + width),
+                block_begin(block + 2 * width), c);
+          }
+        },
+        1);
+  }
+}
+#endif
+
 template <typename T, typename Comp>
 static void parallel_sort(T* b, T* e, Comp c) {
   begin_code("parallel_sort");
@@ -48,6 +85,8 @@ static void parallel_sort(T* b, T* e, Comp c) {
   thrust::stable_sort(bptr, eptr, c);
 #elif defined(OMEGA_H_USE_OPENMP)
   pss::parallel_stable_sort(b, e, c);
+#elif defined(OMEGA_H_USE_THREADS)
+  threads_stable_sort(b, e, c);
 #else
   std::stable_sort(b, e, c);
 #endif
@@ -92,7 +131,9 @@ LOs sort_by_keys(Read<T> keys, Int width) {
 }
 
 #define INST(T) template LOs sort_by_keys(Read<T> keys, Int width);
+#ifndef OMEGA_H_LO_64
 INST(LO)
+#endif
 INST(GO)
 #undef INST
 
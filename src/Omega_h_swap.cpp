@@ -1,5 +1,6 @@
 #include "Omega_h_swap.hpp"
 
+#include "Omega_h_arena.hpp"
 #include "Omega_h_array_ops.hpp"
 #include "Omega_h_map.hpp"
 #include "Omega_h_mesh.hpp"
@@ -43,7 +44,8 @@ Read<I8> filter_swap_improve(Mesh* mesh, LOs cands2edges, Reals cand_quals) {
 }
 
 bool swap_edges(Mesh* mesh, AdaptOpts const& opts) {
-  OMEGA_H_TIME_FUNCTION;
+  OMEGA_H_TIME_PHASE;
+  ScopedArena arena;
   bool ret = false;
   if (mesh->dim() == 3)
     ret = swap_edges_3d(mesh, opts);
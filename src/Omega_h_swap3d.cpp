@@ -17,10 +17,10 @@ static bool swap3d_ghosted(Mesh* mesh, AdaptOpts const& opts) {
   mesh->remove_tag(EDGE, "candidate");
   auto cands2edges = collect_marked(edges_are_cands);
   auto cand_quals = Reals();
-  auto cand_configs = Read<I8>();
+  auto cand_configs = Read<I32>();
   swap3d_qualities(mesh, opts, cands2edges, &cand_quals, &cand_configs);
   auto edge_configs =
-      map_onto(cand_configs, cands2edges, mesh->nedges(), I8(-1), 1);
+      map_onto(cand_configs, cands2edges, mesh->nedges(), I32(-1), 1);
   auto keep_cands = filter_swap_improve(mesh, cands2edges, cand_quals);
   filter_swap(keep_cands, &cands2edges, &cand_quals);
   if (comm->reduce_and(cands2edges.size() == 0)) return false;
@@ -40,7 +40,7 @@ static void swap3d_element_based(Mesh* mesh, AdaptOpts const& opts) {
   auto comm = mesh->comm();
   auto edges_are_keys = mesh->get_array<I8>(EDGE, "key");
   mesh->remove_tag(EDGE, "key");
-  auto edges_configs = mesh->get_array<I8>(EDGE, "config");
+  auto edges_configs = mesh->get_array<I32>(EDGE, "config");
   mesh->remove_tag(EDGE, "config");
   auto keys2edges = collect_marked(edges_are_keys);
   if (opts.verbosity >= EACH_REBUILD) {
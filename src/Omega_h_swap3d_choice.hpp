@@ -7,95 +7,148 @@ namespace Omega_h {
 
 namespace swap3d {
 
+/* a swap configuration is a triangulation of the loop polygon.
+   such a triangulation is a binary tree: the sub-polygon between
+   loop vertices (i) and (j) is split by one triangle (i, k, j)
+   into the sub-polygons (i..k) and (k..j).
+   we encode it as the sequence of choices (k - i - 1), each in
+   [0, j - i - 2], in pre-order and mixed radix, least significant
+   first. for loops of up to 12 vertices the largest code is below 10!,
+   so it fits easily in an I32. */
+
 struct Choice {
-  Int mesh;
+  I32 mesh;
   Real quality;
 };
 
+struct Triangulation {
+  Int ntris;
+  Int nedges;
+  /* each triangle is (i, k, j) with i < k < j, which has the
+     same orientation as the loop itself */
+  Few<Few<Int, 3>, MAX_EDGE_SWAP - 2> tris;
+  /* the interior edges (diagonals), as (i, j) with i < j */
+  Few<Few<Int, 2>, MAX_EDGE_SWAP - 3> edges;
+};
+
+struct SubPolygon {
+  Int i;
+  Int j;
+};
+
+OMEGA_H_INLINE I32 encode_triangulation(
+    Int loop_size, Int const apexes[MAX_EDGE_SWAP][MAX_EDGE_SWAP]) {
+  SubPolygon stack[MAX_EDGE_SWAP];
+  Int nstack = 0;
+  stack[nstack++] = {0, loop_size - 1};
+  I32 code = 0;
+  I32 place = 1;
+  while (nstack) {
+    auto sub = stack[--nstack];
+    if (sub.j - sub.i < 2) continue;
+    auto k = apexes[sub.i][sub.j];
+    code += place * (k - sub.i - 1);
+    place *= (sub.j - sub.i - 1);
+    stack[nstack++] = {k, sub.j};
+    stack[nstack++] = {sub.i, k};
+  }
+  return code;
+}
+
+OMEGA_H_INLINE Triangulation decode_triangulation(Int loop_size, I32 code) {
+  Triangulation out;
+  out.ntris = 0;
+  out.nedges = 0;
+  SubPolygon stack[MAX_EDGE_SWAP];
+  Int nstack = 0;
+  stack[nstack++] = {0, loop_size - 1};
+  while (nstack) {
+    auto sub = stack[--nstack];
+    if (sub.j - sub.i < 2) continue;
+    if (!(sub.i == 0 && sub.j == loop_size - 1)) {
+      out.edges[out.nedges][0] = sub.i;
+      out.edges[out.nedges][1] = sub.j;
+      ++out.nedges;
+    }
+    auto radix = sub.j - sub.i - 1;
+    auto k = sub.i + 1 + code % radix;
+    code /= radix;
+    out.tris[out.ntris][0] = sub.i;
+    out.tris[out.ntris][1] = k;
+    out.tris[out.ntris][2] = sub.j;
+    ++out.ntris;
+    stack[nstack++] = {k, sub.j};
+    stack[nstack++] = {sub.i, k};
+  }
+  return out;
+}
+
+/* finds the triangulation of the loop polygon which maximizes the
+   minimum quality of the tets it creates, without creating edges
+   longer than (max_length_allowed).
+   this is the dynamic program of Klincsek for optimal polygon
+   triangulations: since the objective is a minimum over triangles,
+   the best triangulation of the sub-polygon (i..j) is the best
+   over k of the triangle (i, k, j) combined with the best
+   triangulations of (i..k) and (k..j).
+   each triangle and each diagonal is visited exactly once,
+   so their qualities and lengths need no further caching,
+   and the cost is O(n^3) per loop. */
 template <typename QualityMeasure, typename LengthMeasure>
 OMEGA_H_DEVICE Choice choose(Loop loop, QualityMeasure const& quality_measure,
     LengthMeasure const& length_measure, Real max_length_allowed) {
-  auto nmeshes = swap_mesh_counts[loop.size];
-  auto nmesh_tris = swap_mesh_sizes[loop.size];
-  auto uniq_tris2loop_verts = swap_triangles[loop.size];
-  bool uniq_tris_cached[MAX_UNIQUE_TRIS] = {false};
-  Real uniq_tri_quals[MAX_UNIQUE_TRIS] = {0};
-  bool uniq_edgs_cached[MAX_UNIQUE_EDGES] = {false};
-  Real uniq_edg_lens[MAX_UNIQUE_EDGES] = {0};
-  Choice choice;
-  choice.mesh = -1;
-  choice.quality = 0.0;
-  for (Int mesh = 0; mesh < nmeshes; ++mesh) {
-    Real mesh_minqual = 1.0;
-    auto mesh_tris2uniq_tris = &swap_meshes[loop.size][mesh * nmesh_tris];
-    for (Int mesh_tri = 0; mesh_tri < nmesh_tris; ++mesh_tri) {
-      auto uniq_tri = mesh_tris2uniq_tris[mesh_tri];
-      if (!uniq_tris_cached[uniq_tri]) {
-        auto tri_verts2loop_verts = uniq_tris2loop_verts[uniq_tri];
-        /* the first three tet vertices are
-           the same as the bottom triangle,
-           curling into the tet. we fill these
-           in from the triangle table for the current
-           2D mesh being explored */
-        Few<LO, 4> tet_verts2verts;
-        for (Int tri_vert = 0; tri_vert < 3; ++tri_vert) {
-          auto loop_vert = tri_verts2loop_verts[tri_vert];
-          auto vert = loop.loop_verts2verts[loop_vert];
-          tet_verts2verts[tri_vert] = vert;
+  auto n = loop.size;
+  /* a sub-polygon without a valid triangulation has quality zero,
+     since only configurations of positive quality are acceptable */
+  Real best[MAX_EDGE_SWAP][MAX_EDGE_SWAP];
+  Int apexes[MAX_EDGE_SWAP][MAX_EDGE_SWAP];
+  for (Int i = 0; i + 1 < n; ++i) best[i][i + 1] = 1.0;
+  for (Int len = 2; len < n; ++len) {
+    for (Int i = 0; i + len < n; ++i) {
+      auto j = i + len;
+      best[i][j] = 0.0;
+      apexes[i][j] = -1;
+      /* (0, n - 1) is a side of the loop, all others are new edges */
+      if (len < n - 1) {
+        Few<LO, 2> edge_verts2verts;
+        edge_verts2verts[0] = loop.loop_verts2verts[i];
+        edge_verts2verts[1] = loop.loop_verts2verts[j];
+        if (length_measure.measure(edge_verts2verts) > max_length_allowed) {
+          continue;
         }
-        /* each triangle will support two tets,
-           one above and one below. this loop
-           forms those tets, swapping vertices
-           in between to maintain proper orientation.
-           (mfr means Region of Face of Mesh) */
-        Real tri_minqual = 1.0;
+      }
+      for (Int k = i + 1; k < j; ++k) {
+        auto sub_quality = min2(best[i][k], best[k][j]);
+        /* the triangle can't improve on what we have */
+        if (!(sub_quality > best[i][j])) continue;
+        /* the first three tet vertices are the triangle,
+           the fourth is one of the edge vertices.
+           between the two tets we swap two triangle vertices
+           to maintain proper orientation. */
+        Few<LO, 4> tet_verts2verts;
+        tet_verts2verts[0] = loop.loop_verts2verts[i];
+        tet_verts2verts[1] = loop.loop_verts2verts[k];
+        tet_verts2verts[2] = loop.loop_verts2verts[j];
+        auto quality = sub_quality;
         for (Int tri_tet = 0; tri_tet < 2; ++tri_tet) {
           tet_verts2verts[3] = loop.eev2v[1 - tri_tet];
-          auto tet_qual = quality_measure.measure(tet_verts2verts);
-          tri_minqual = min2(tri_minqual, tet_qual);
+          quality = min2(quality, quality_measure.measure(tet_verts2verts));
           swap2(tet_verts2verts[1], tet_verts2verts[2]);
         }
-        uniq_tris_cached[uniq_tri] = true;
-        uniq_tri_quals[uniq_tri] = tri_minqual;
-      }
-      auto tri_minqual = uniq_tri_quals[uniq_tri];
-      mesh_minqual = min2(mesh_minqual, tri_minqual);
-      /* if we know this swap configuration will make
-         negative tets, don't bother computing the rest of it. */
-      if (mesh_minqual < 0.0) break;
-    }
-    if (mesh_minqual > choice.quality) {
-      /* now that we have a configuration which is a candidate
-         for being the new best, we will go ahead and check for
-         edge length overshooting.
-         the idea is to minimize the cost of this check.
-         We'll use the same caching as we did for triangles above. */
-      bool does_overshoot = false;
-      for (Int mesh_edge = 0; mesh_edge < nedges[loop.size]; ++mesh_edge) {
-        auto uniq_edge = edges2unique[loop.size][mesh][mesh_edge];
-        if (!uniq_edgs_cached[uniq_edge]) {
-          Few<LO, 2> edge_verts2verts;
-          for (Int edge_vert = 0; edge_vert < 2; ++edge_vert) {
-            auto loop_vert = unique_edges[loop.size][uniq_edge][edge_vert];
-            auto vert = loop.loop_verts2verts[loop_vert];
-            edge_verts2verts[edge_vert] = vert;
-          }
-          auto edge_length = length_measure.measure(edge_verts2verts);
-          uniq_edg_lens[uniq_edge] = edge_length;
-          uniq_edgs_cached[uniq_edge] = true;
+        if (quality > best[i][j]) {
+          best[i][j] = quality;
+          apexes[i][j] = k;
         }
-        auto edge_length = uniq_edg_lens[uniq_edge];
-        if (edge_length > max_length_allowed) {
-          does_overshoot = true;
-          break;
-        }
-      }
-      if (!does_overshoot) {
-        choice.mesh = mesh;
-        choice.quality = mesh_minqual;
       }
     }
   }
+  Choice choice;
+  choice.mesh = -1;
+  choice.quality = 0.0;
+  if (best[0][n - 1] > 0.0) {
+    choice.mesh = encode_triangulation(n, apexes);
+    choice.quality = best[0][n - 1];
+  }
   return choice;
 }
 
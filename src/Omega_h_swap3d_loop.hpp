@@ -1,8 +1,6 @@
 #ifndef SWAP3D_LOOP_HPP
 #define SWAP3D_LOOP_HPP
 
-#include "Omega_h_swap3d_tables.hpp"
-
 #include "Omega_h_align.hpp"
 #include "Omega_h_few.hpp"
 #include "Omega_h_simplex.hpp"
@@ -11,6 +9,10 @@ namespace Omega_h {
 
 namespace swap3d {
 
+/* the largest loop (number of tets around an edge)
+   for which we will consider swapping that edge */
+enum { MAX_EDGE_SWAP = 12 };
+
 /* by definition, the loop vertices curl
    around the edge by the right-hand rule,
    i.e. counterclockwise when looking from
@@ -62,7 +64,7 @@ OMEGA_H_DEVICE Loop find_loop(LOs const& edges2edge_tets,
    * The following code uses insertion sort to
    * order the edges around the loop by matching their
    * endpoints.
-   * Remember, there are at most 7 edges to sort. */
+   * Remember, there are at most MAX_EDGE_SWAP edges to sort. */
   for (Int i = 0; i < loop.size - 1; ++i) {
     Int j;
     for (j = i + 1; j < loop.size; ++j) {
@@ -9,7 +9,7 @@ namespace Omega_h {
 
 template <Int metric_dim>
 void swap3d_qualities_tmpl(Mesh* mesh, AdaptOpts const& opts,
-    LOs cands2edges, Reals* cand_quals, Read<I8>* cand_configs) {
+    LOs cands2edges, Reals* cand_quals, Read<I32>* cand_configs) {
   auto edges2tets = mesh->ask_up(EDGE, REGION);
   auto edges2edge_tets = edges2tets.a2ab;
   auto edge_tets2tets = edges2tets.ab2b;
@@ -22,7 +22,7 @@ void swap3d_qualities_tmpl(Mesh* mesh, AdaptOpts const& opts,
   auto max_length = opts.max_length_allowed;
   auto ncands = cands2edges.size();
   auto cand_quals_w = Write<Real>(ncands);
-  auto cand_configs_w = Write<I8>(ncands);
+  auto cand_configs_w = Write<I32>(ncands);
   auto f = OMEGA_H_LAMBDA(LO cand) {
     auto edge = cands2edges[cand];
     /* non-owned edges will have incomplete cavities
@@ -43,9 +43,7 @@ void swap3d_qualities_tmpl(Mesh* mesh, AdaptOpts const& opts,
     }
     auto choice =
         swap3d::choose(loop, quality_measure, length_measure, max_length);
-    static_assert(swap3d::MAX_CONFIGS <= INT8_MAX,
-        "int8_t must be able to represent all swap configurations");
-    cand_configs_w[cand] = static_cast<I8>(choice.mesh);
+    cand_configs_w[cand] = choice.mesh;
     cand_quals_w[cand] = choice.quality;
   };
   parallel_for(ncands, f, "swap3d_qualities");
@@ -54,11 +52,11 @@ void swap3d_qualities_tmpl(Mesh* mesh, AdaptOpts const& opts,
   *cand_quals =
       mesh->sync_subset_array(EDGE, *cand_quals, cands2edges, -1.0, 1);
   *cand_configs =
-      mesh->sync_subset_array(EDGE, *cand_configs, cands2edges, I8(-1), 1);
+      mesh->sync_subset_array(EDGE, *cand_configs, cands2edges, I32(-1), 1);
 }
 
 void swap3d_qualities(Mesh* mesh, AdaptOpts const& opts, LOs cands2edges,
-    Reals* cand_quals, Read<I8>* cand_configs) {
+    Reals* cand_quals, Read<I32>* cand_configs) {
   OMEGA_H_CHECK(mesh->parting() == OMEGA_H_GHOSTED);
   OMEGA_H_CHECK(mesh->dim() == 3);
   auto metrics = mesh->get_array<Real>(VERT, "metric");
@@ -4,8 +4,7 @@
 #include "Omega_h_int_scan.hpp"
 #include "Omega_h_map.hpp"
 #include "Omega_h_mesh.hpp"
-#include "Omega_h_swap3d_loop.hpp"
-#include "Omega_h_swap3d_tables.hpp"
+#include "Omega_h_swap3d_choice.hpp"
 
 namespace Omega_h {
 
@@ -21,8 +20,8 @@ HostFew<LOs, 4> swap3d_keys_to_prods(Mesh* mesh, LOs keys2edges) {
   auto f = OMEGA_H_LAMBDA(LO key) {
     auto edge = keys2edges[key];
     auto loop_size = edges2ntets[edge];
-    auto nplane_tris = swap3d::swap_mesh_sizes[loop_size];
-    auto nplane_edges = swap3d::nedges[loop_size];
+    auto nplane_tris = loop_size - 2;
+    auto nplane_edges = loop_size - 3;
     auto nprod_edges = nplane_edges;
     auto nprod_tris = nplane_tris + 2 * nplane_edges;
     auto nprod_tets = 2 * nplane_tris;
@@ -39,7 +38,7 @@ HostFew<LOs, 4> swap3d_keys_to_prods(Mesh* mesh, LOs keys2edges) {
 }
 
 HostFew<LOs, 4> swap3d_topology(Mesh* mesh, LOs keys2edges,
-    Read<I8> edge_configs, HostFew<LOs, 4> keys2prods) {
+    Read<I32> edge_configs, HostFew<LOs, 4> keys2prods) {
   auto edges2tets = mesh->ask_up(EDGE, REGION);
   auto edges2edge_tets = edges2tets.a2ab;
   auto edge_tets2tets = edges2tets.ab2b;
@@ -57,13 +56,11 @@ HostFew<LOs, 4> swap3d_topology(Mesh* mesh, LOs keys2edges,
     auto config = edge_configs[edge];
     auto loop = swap3d::find_loop(edges2edge_tets, edge_tets2tets,
         edge_tet_codes, edge_verts2verts, tet_verts2verts, edge);
-    auto nplane_tris = swap3d::swap_mesh_sizes[loop.size];
-    auto nplane_edges = swap3d::nedges[loop.size];
-    for (Int plane_edge = 0; plane_edge < nplane_edges; ++plane_edge) {
-      auto unique_edge = swap3d::edges2unique[loop.size][config][plane_edge];
+    auto plane = swap3d::decode_triangulation(loop.size, config);
+    for (Int plane_edge = 0; plane_edge < plane.nedges; ++plane_edge) {
       Few<LO, 2> plane_edge_verts;
       for (Int pev = 0; pev < 2; ++pev) {
-        auto loop_vert = swap3d::unique_edges[loop.size][unique_edge][pev];
+        auto loop_vert = plane.edges[plane_edge][pev];
         auto vert = loop.loop_verts2verts[loop_vert];
         plane_edge_verts[pev] = vert;
       }
@@ -83,16 +80,14 @@ HostFew<LOs, 4> swap3d_topology(Mesh* mesh, LOs keys2edges,
         }
       }
     }
-    for (Int plane_tri = 0; plane_tri < nplane_tris; ++plane_tri) {
-      auto uniq_tri =
-          swap3d::swap_meshes[loop.size][config * nplane_tris + plane_tri];
+    for (Int plane_tri = 0; plane_tri < plane.ntris; ++plane_tri) {
       Few<LO, 3> plane_tri_verts;
       for (Int pfv = 0; pfv < 3; ++pfv) {
-        auto loop_vert = swap3d::swap_triangles[loop.size][uniq_tri][pfv];
+        auto loop_vert = plane.tris[plane_tri][pfv];
         auto vert = loop.loop_verts2verts[loop_vert];
         plane_tri_verts[pfv] = vert;
       }
-      auto prod_tri = keys2prods[FACE][key] + 2 * nplane_edges + plane_tri;
+      auto prod_tri = keys2prods[FACE][key] + 2 * plane.nedges + plane_tri;
       for (Int pfv = 0; pfv < 3; ++pfv) {
         prod_verts2verts_w[FACE][prod_tri * 3 + pfv] = plane_tri_verts[pfv];
       }
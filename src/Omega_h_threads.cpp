@@ -0,0 +1,250 @@
+#include <Omega_h_fail.hpp>
+#include <Omega_h_scalar.hpp>
+#include <Omega_h_threads.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Omega_h {
+
+namespace threads {
+
+/* loops shorter than this cost less than waking the pool */
+static constexpr LO serial_threshold = 256;
+
+/* with an automatic grain, each thread's part
+   is cut into at least this many chunks */
+static constexpr LO chunks_per_thread = 16;
+
+/* the part of a loop one thread has left, [begin, end).
+   the owner takes chunks from the front, thieves take halves
+   from the back. the spin lock is only held to move the bounds. */
+struct Part {
+  std::atomic_flag lock;
+  LO begin;
+  LO end;
+  I64 nchunks;
+  I64 nsteals;
+  /* keeps the parts of different threads on different cache lines */
+  char padding[64];
+  Part() : begin(0), end(0), nchunks(0), nsteals(0) { lock.clear(); }
+};
+
+struct Pool {
+  Int nthreads = 1;
+  std::vector<std::thread> workers;
+  std::unique_ptr<Part[]> parts;
+  std::mutex mutex;
+  std::condition_variable wake;
+  std::atomic<I64> generation{0};
+  std::atomic<Int> nbusy{0};
+  std::atomic<bool> stopping{false};
+  /* only one thread at a time hands loops to the pool */
+  std::mutex run_mutex;
+  /* the current loop */
+  LO grain = 1;
+  void const* closure = nullptr;
+  RangeFunction f = nullptr;
+  std::mutex error_mutex;
+  std::exception_ptr error;
+  Stats stats = {0, 0, 0, 0};
+  std::atomic<I64> nserial_runs{0};
+  /* also called at exit, in case a Library was never destroyed */
+  ~Pool() { stop_workers(); }
+  void stop_workers() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stopping.store(true);
+    }
+    wake.notify_all();
+    for (auto& worker : workers) worker.join();
+    workers.clear();
+  }
+};
+
+static Pool pool;
+
+/* set on pool threads, and on the calling thread during a loop */
+static thread_local bool in_pool = false;
+
+namespace {
+
+class PartLock {
+ public:
+  PartLock(Part& part) : part_(part) {
+    while (part_.lock.test_and_set(std::memory_order_acquire))
+      ;
+  }
+  ~PartLock() { part_.lock.clear(std::memory_order_release); }
+
+ private:
+  Part& part_;
+};
+
+}  // end anonymous namespace
+
+static bool take_chunk(Part& part, LO grain, LO* begin, LO* end) {
+  PartLock lock(part);
+  auto const remaining = part.end - part.begin;
+  if (remaining <= 0) return false;
+  auto const size = min2(remaining, max2(grain, remaining / 8));
+  *begin = part.begin;
+  *end = part.begin + size;
+  part.begin = *end;
+  return true;
+}
+
+/* takes the back half of what some other thread has left
+   and makes it the part of (thread) */
+static bool steal(Int thread) {
+  auto const nthreads = pool.nthreads;
+  for (Int i = 1; i < nthreads; ++i) {
+    auto& victim = pool.parts[(thread + i) % nthreads];
+    LO begin, end;
+    {
+      PartLock lock(victim);
+      auto const remaining = victim.end - victim.begin;
+      if (remaining <= 0) continue;
+      begin = victim.begin + remaining / 2;
+      end = victim.end;
+      victim.end = begin;
+    }
+    auto& own = pool.parts[thread];
+    PartLock lock(own);
+    own.begin = begin;
+    own.end = end;
+    ++own.nsteals;
+    return true;
+  }
+  return false;
+}
+
+static void work(Int thread) {
+  auto& own = pool.parts[thread];
+  try {
+    do {
+      LO begin, end;
+      while (take_chunk(own, pool.grain, &begin, &end)) {
+        pool.f(pool.closure, begin, end, thread);
+        ++own.nchunks;
+      }
+    } while (steal(thread));
+  } catch (...) {
+    std::lock_guard<std::mutex> lock(pool.error_mutex);
+    if (!pool.error) pool.error = std::current_exception();
+    /* give up the rest of this part, the other threads
+       will finish theirs and the loop ends with the error */
+    PartLock lock2(own);
+    own.begin = own.end;
+  }
+}
+
+static void worker_main(Int thread) {
+  in_pool = true;
+  I64 seen = 0;
+  while (true) {
+    /* spin briefly, loops often come in quick succession */
+    for (int i = 0; i < 4096; ++i) {
+      if (pool.generation.load(std::memory_order_acquire) != seen) break;
+      if (pool.stopping.load(std::memory_order_acquire)) return;
+      std::this_thread::yield();
+    }
+    {
+      std::unique_lock<std::mutex> lock(pool.mutex);
+      pool.wake.wait(lock, [&]() {
+        return pool.stopping.load() || pool.generation.load() != seen;
+      });
+    }
+    if (pool.stopping.load()) return;
+    seen = pool.generation.load(std::memory_order_acquire);
+    work(thread);
+    pool.nbusy.fetch_sub(1, std::memory_order_acq_rel);
+  }
+}
+
+void start(Int nthreads) {
+  OMEGA_H_CHECK(nthreads >= 1);
+  stop();
+  pool.nthreads = nthreads;
+  pool.parts.reset(new Part[std::size_t(nthreads)]);
+  pool.stopping.store(false);
+  for (Int thread = 1; thread < nthreads; ++thread) {
+    pool.workers.emplace_back(worker_main, thread);
+  }
+}
+
+void stop() {
+  pool.stop_workers();
+  pool.parts.reset();
+  pool.nthreads = 1;
+}
+
+Int num_threads() { return pool.nthreads; }
+
+void run(LO n, LO grain, void const* closure, RangeFunction f) {
+  if (n <= 0) return;
+  auto const nthreads = pool.nthreads;
+  if (grain <= 0) {
+    grain = max2(LO(1), n / (LO(nthreads) * chunks_per_thread));
+    if (n < serial_threshold) grain = n;
+  }
+  std::unique_lock<std::mutex> run_lock(pool.run_mutex, std::defer_lock);
+  if (nthreads == 1 || in_pool || n <= grain || !run_lock.try_lock()) {
+    if (!in_pool) pool.nserial_runs.fetch_add(1, std::memory_order_relaxed);
+    f(closure, 0, n, 0);
+    return;
+  }
+  for (Int thread = 0; thread < nthreads; ++thread) {
+    auto& part = pool.parts[thread];
+    part.begin = LO((I64(n) * thread) / nthreads);
+    part.end = LO((I64(n) * (thread + 1)) / nthreads);
+    part.nchunks = 0;
+    part.nsteals = 0;
+  }
+  pool.grain = grain;
+  pool.closure = closure;
+  pool.f = f;
+  pool.error = nullptr;
+  pool.nbusy.store(nthreads - 1, std::memory_order_release);
+  {
+    std::lock_guard<std::mutex> lock(pool.mutex);
+    pool.generation.fetch_add(1);
+  }
+  pool.wake.notify_all();
+  in_pool = true;
+  work(0);
+  in_pool = false;
+  while (pool.nbusy.load(std::memory_order_acquire) != 0) {
+    std::this_thread::yield();
+  }
+  ++pool.stats.nruns;
+  for (Int thread = 0; thread < nthreads; ++thread) {
+    pool.stats.nchunks += pool.parts[thread].nchunks;
+    pool.stats.nsteals += pool.parts[thread].nsteals;
+  }
+  if (pool.error) {
+    auto error = pool.error;
+    pool.error = nullptr;
+    std::rethrow_exception(error);
+  }
+}
+
+Stats get_stats() {
+  auto stats = pool.stats;
+  stats.nserial_runs = pool.nserial_runs.load();
+  return stats;
+}
+
+void reset_stats() {
+  pool.stats = Stats{0, 0, 0, 0};
+  pool.nserial_runs.store(0);
+}
+
+}  // namespace threads
+
+}  // namespace Omega_h
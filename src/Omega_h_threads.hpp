@@ -0,0 +1,65 @@
+#ifndef OMEGA_H_THREADS_HPP
+#define OMEGA_H_THREADS_HPP
+
+#include <Omega_h_defines.hpp>
+
+namespace Omega_h {
+
+namespace threads {
+
+/* the parallel backend used when Omega_h_USE_THREADS is on,
+   in place of OpenMP.
+   a pool of persistent threads runs each loop over [0, n).
+   the loop starts split evenly among the threads, each thread runs its
+   own part in chunks that shrink as the part does, and a thread that runs
+   out takes the back half of what another thread has left.
+   so loops whose iterations cost very different amounts,
+   as in swap and collapse cavities, keep all threads busy to the end.
+
+   until start() is called, and from inside a running loop,
+   loops run serially on the calling thread. */
+
+typedef void (*RangeFunction)(
+    void const* closure, LO begin, LO end, Int thread);
+
+/* (nthreads) includes the calling thread. restarts a running pool */
+void start(Int nthreads);
+void stop();
+Int num_threads();
+
+/* calls (f) on disjoint chunks that together cover [0, n).
+   chunks are at least (grain) long, except the last of each thread.
+   if (grain) is zero it is chosen from (n) and the number of threads,
+   and short loops run serially */
+void run(LO n, LO grain, void const* closure, RangeFunction f);
+
+struct Stats {
+  I64 nruns;
+  I64 nserial_runs;
+  I64 nchunks;
+  I64 nsteals;
+};
+
+Stats get_stats();
+void reset_stats();
+
+template <typename F>
+void call_range(void const* closure, LO begin, LO end, Int thread) {
+  auto const& f = *static_cast<F const*>(closure);
+  f(begin, end, thread);
+}
+
+/* calls f(begin, end, thread) through run().
+   (f) is only ever called through a reference, never copied,
+   so the arrays it captured while entering_parallel was set
+   are not counted again by the worker threads */
+template <typename F>
+void for_each_range(LO n, F const& f, LO grain = 0) {
+  run(n, grain, &f, &call_range<F>);
+}
+
+}  // namespace threads
+
+}  // namespace Omega_h
+
+#endif
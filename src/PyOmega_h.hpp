@@ -1,6 +1,7 @@
 #ifndef OMEGA_H_PY_HPP
 #define OMEGA_H_PY_HPP
 
+#include <Omega_h_array.hpp>
 #include <Omega_h_config.h>
 
 #ifdef __GNUC__
@@ -8,6 +9,7 @@
 #pragma GCC diagnostic ignored "-Wshadow"
 #endif
 
+#include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
 
 #ifdef __GNUC__
@@ -19,6 +21,17 @@ namespace py = pybind11;
 namespace Omega_h {
 class Library;
 extern std::unique_ptr<Library> pybind11_global_library;
+/* a read-only NumPy array of the values of (a), shaped (n, ncomps) or
+   just (n) if (ncomps == 1), which keeps (a) alive for as long as it
+   exists */
+template <class Scalar>
+py::array numpy_view(Read<Scalar> a, Int ncomps);
+/* an array that uses the memory of (a) directly where the backend allows,
+   which keeps (a) alive for as long as it exists. (a) becomes read-only,
+   since Reads of that memory may follow */
+template <class Scalar>
+Write<Scalar> adopt_numpy(
+    py::array_t<Scalar, py::array::c_style | py::array::forcecast> a);
 void pybind11_defines(py::module& module);
 void pybind11_array(py::module& module);
 void pybind11_comm(py::module& module);
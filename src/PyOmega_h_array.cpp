@@ -1,8 +1,51 @@
 #include <Omega_h_array.hpp>
+#include <Omega_h_fail.hpp>
 #include <PyOmega_h.hpp>
 
+#include <vector>
+
 namespace Omega_h {
 
+template <class Scalar>
+py::array numpy_view(Read<Scalar> a, Int ncomps) {
+  OMEGA_H_CHECK(ncomps >= 1);
+  OMEGA_H_CHECK(a.size() % ncomps == 0);
+  /* on device backends this is the one copy we make */
+  auto const host = new HostRead<Scalar>(a);
+  py::capsule owner(
+      host, [](void* p) { delete static_cast<HostRead<Scalar>*>(p); });
+  auto const n = py::ssize_t(a.size() / ncomps);
+  auto const size = py::ssize_t(sizeof(Scalar));
+  std::vector<py::ssize_t> shape;
+  std::vector<py::ssize_t> strides;
+  if (ncomps == 1) {
+    shape = {n};
+    strides = {size};
+  } else {
+    shape = {n, py::ssize_t(ncomps)};
+    strides = {size * ncomps, size};
+  }
+  py::array view(py::dtype::of<Scalar>(), shape, strides, host->data(), owner);
+  /* the memory may be shared with any number of Reads */
+  view.attr("setflags")("write", false);
+  return view;
+}
+
+template <class Scalar>
+Write<Scalar> adopt_numpy(
+    py::array_t<Scalar, py::array::c_style | py::array::forcecast> a) {
+  /* Reads of the adopted memory may follow */
+  a.attr("setflags")("write", false);
+  /* the last reference to the adopted memory may be dropped by code
+     that does not hold the interpreter lock */
+  auto const keep = new py::object(a);
+  auto const data = const_cast<Scalar*>(a.data());
+  return adopt_host_memory(data, LO(a.size()), [keep]() {
+    py::gil_scoped_acquire gil;
+    delete keep;
+  });
+}
+
 template <class Scalar, class Wrapper>
 static void pybind11_array_type(py::module& module,
     std::string const& py_scalar, std::string const& py_wrapper) {
@@ -11,11 +54,22 @@ static void pybind11_array_type(py::module& module,
   auto hostread_name = std::string("HostRead_") + py_scalar;
   auto hostwrite_name = std::string("HostWrite_") + py_scalar;
   auto deepcopy_name = std::string("deep_copy_") + py_scalar;
+  auto adopt_name = std::string("adopt_") + py_scalar;
   py::class_<Write<Scalar>>(module, write_name.c_str())
-      .def("size", &Write<Scalar>::size);
+      .def("size", &Write<Scalar>::size)
+      .def("numpy",
+          [](Write<Scalar> a, Int ncomps) {
+            return numpy_view(Read<Scalar>(a), ncomps);
+          },
+          "Read-only NumPy view of the array, which may already be shared "
+          "with Reads",
+          py::arg("ncomps") = 1);
   py::class_<Read<Scalar>>(module, read_name.c_str())
       .def(py::init<Write<Scalar>>())
-      .def("size", &Read<Scalar>::size);
+      .def("size", &Read<Scalar>::size)
+      .def("numpy",
+          [](Read<Scalar> a, Int ncomps) { return numpy_view(a, ncomps); },
+          "Read-only NumPy view of the array", py::arg("ncomps") = 1);
   py::class_<Wrapper, Read<Scalar>>(module, py_wrapper.c_str())
       .def(py::init<Write<Scalar>>())
       .def(py::init<LO, Scalar, std::string const&>(), py::arg("size"),
@@ -48,6 +102,9 @@ static void pybind11_array_type(py::module& module,
       &deep_copy;
   module.def(deepcopy_name.c_str(), deep_copy_type, py::arg("a"),
       py::arg("name") = "");
+  module.def(adopt_name.c_str(), &adopt_numpy<Scalar>,
+      "Array sharing the memory of a NumPy array, which becomes read-only",
+      py::arg("a"));
 }
 
 void pybind11_array(py::module& module) {
@@ -57,4 +114,14 @@ void pybind11_array(py::module& module) {
   pybind11_array_type<Real, Reals>(module, "float64", "Reals");
 }
 
+#define INST(T)                                                                \
+  template py::array numpy_view(Read<T> a, Int ncomps);                        \
+  template Write<T> adopt_numpy(                                               \
+      py::array_t<T, py::array::c_style | py::array::forcecast> a);
+INST(I8)
+INST(I32)
+INST(I64)
+INST(Real)
+#undef INST
+
 }  // namespace Omega_h
@@ -1,8 +1,51 @@
+#include <Omega_h_element.hpp>
+#include <Omega_h_fail.hpp>
 #include <Omega_h_mesh.hpp>
 #include <PyOmega_h.hpp>
 
 namespace Omega_h {
 
+static py::array get_tag_numpy(
+    Mesh& mesh, Int ent_dim, std::string const& name) {
+  auto const tag = mesh.get_tagbase(ent_dim, name);
+  auto const ncomps = tag->ncomps();
+  switch (tag->type()) {
+    case OMEGA_H_I8:
+      return numpy_view(mesh.get_array<I8>(ent_dim, name), ncomps);
+    case OMEGA_H_I32:
+      return numpy_view(mesh.get_array<I32>(ent_dim, name), ncomps);
+    case OMEGA_H_I64:
+      return numpy_view(mesh.get_array<I64>(ent_dim, name), ncomps);
+    case OMEGA_H_F64:
+      return numpy_view(mesh.get_array<Real>(ent_dim, name), ncomps);
+  }
+  OMEGA_H_NORETURN(py::array());
+}
+
+template <class T>
+static void add_tag_numpy(
+    Mesh& mesh, Int ent_dim, std::string const& name, py::array array) {
+  OMEGA_H_CHECK(array.ndim() == 1 || array.ndim() == 2);
+  auto const ncomps = (array.ndim() == 2) ? Int(array.shape(1)) : 1;
+  auto const data =
+      py::array_t<T, py::array::c_style | py::array::forcecast>::ensure(array);
+  mesh.add_tag<T>(ent_dim, name, ncomps, read(adopt_numpy<T>(data)));
+}
+
+/* integer arrays keep their width, anything else becomes float64 */
+static void add_tag_numpy(
+    Mesh& mesh, Int ent_dim, std::string const& name, py::array array) {
+  if (py::isinstance<py::array_t<I8>>(array)) {
+    add_tag_numpy<I8>(mesh, ent_dim, name, array);
+  } else if (py::isinstance<py::array_t<I32>>(array)) {
+    add_tag_numpy<I32>(mesh, ent_dim, name, array);
+  } else if (py::isinstance<py::array_t<I64>>(array)) {
+    add_tag_numpy<I64>(mesh, ent_dim, name, array);
+  } else {
+    add_tag_numpy<Real>(mesh, ent_dim, name, array);
+  }
+}
+
 #define OMEGA_H_DECL_TYPE(T, name)                                             \
   void (Mesh::*add_tag_##name)(Int, std::string const&, Int, Read<T>, bool) =  \
       &Mesh::add_tag<T>;
@@ -31,7 +74,30 @@ void pybind11_mesh(py::module& module) {
               OMEGA_H_DEF_TYPE(Real, float64)
       .def("min_quality", &Omega_h::Mesh::min_quality)
       .def("max_length", &Omega_h::Mesh::max_length)
-      .def("balance", balance, py::arg("predictive") = false);
+      .def("balance", balance, py::arg("predictive") = false)
+      .def("balance_incremental", &Omega_h::Mesh::balance_incremental,
+          py::arg("tolerance") = 1.05, py::arg("predictive") = false,
+          py::arg("verbose") = false)
+      .def("get_numpy", get_tag_numpy,
+          "Read-only NumPy view of a tag, shaped (nents, ncomps)",
+          py::arg("ent_dim"), py::arg("name"))
+      .def("add_tag_numpy",
+          [](Mesh& mesh, Int ent_dim, std::string const& name,
+              py::array array) { add_tag_numpy(mesh, ent_dim, name, array); },
+          "Add a tag whose values are a NumPy array of shape (nents) or "
+          "(nents, ncomps), which becomes read-only",
+          py::arg("ent_dim"), py::arg("name"), py::arg("array"))
+      .def("coords_numpy",
+          [](Mesh& mesh) {
+            return numpy_view(mesh.coords(), mesh.dim());
+          },
+          "Read-only NumPy view of the vertex coordinates")
+      .def("elem_verts_numpy",
+          [](Mesh& mesh) {
+            return numpy_view(mesh.ask_elem_verts(),
+                element_degree(mesh.family(), mesh.dim(), VERT));
+          },
+          "Read-only NumPy view of the element-to-vertex connectivity");
   module.def(
       "new_empty_mesh", []() { return Mesh(pybind11_global_library.get()); });
 }
@@ -0,0 +1,34 @@
+import numpy as np
+import PyOmega_h as omega_h
+
+def check_read_only(view):
+    assert not view.flags.writeable
+    try:
+        view[0] = view[0]
+    except ValueError:
+        return
+    raise AssertionError("a view of shared memory must not be writeable")
+
+comm = omega_h.world()
+mesh = omega_h.build_box(comm, omega_h.SIMPLEX, 1.0, 1.0, 0.0, 2, 2, 0)
+
+# views of mesh data share memory the mesh keeps using
+coords = mesh.coords_numpy()
+assert coords.shape == (mesh.nents(0), 2)
+check_read_only(coords)
+check_read_only(mesh.elem_verts_numpy())
+
+# a tag added from NumPy keeps its memory, which becomes read-only
+x = np.array(coords[:, 0])
+mesh.add_tag_numpy(0, "x", x)
+check_read_only(x)
+tag = mesh.get_numpy(0, "x")
+check_read_only(tag)
+assert np.array_equal(tag, coords[:, 0])
+
+# a Write may already share its memory with Reads
+w = omega_h.deep_copy_float64(mesh.get_array_float64(0, "x"))
+r = omega_h.Read_float64(w)
+check_read_only(w.numpy())
+check_read_only(r.numpy())
+assert np.array_equal(r.numpy(), x)
@@ -0,0 +1,68 @@
+#include <Omega_h_adj.hpp>
+#include <Omega_h_array_ops.hpp>
+#include <Omega_h_build.hpp>
+#include <Omega_h_cmdline.hpp>
+#include <Omega_h_element.hpp>
+#include <Omega_h_map.hpp>
+#include <Omega_h_timer.hpp>
+#include <iostream>
+
+using namespace Omega_h;
+
+/* the upward adjacency as it was derived before invert_map_by_blocks:
+   filled by atomics in no particular order, then each list sorted */
+static Adj invert_adj_by_atomics(
+    Adj const down, Int const nlows_per_high, LO const nlows) {
+  auto const l2hl = invert_map_by_atomics(down.ab2b, nlows);
+  auto const lh2h = divide_each_by(l2hl.ab2b, LO(nlows_per_high));
+  Write<LO> sorted_lh2h = deep_copy(lh2h);
+  Write<I8> codes(lh2h.size(), 0);
+  sort_by_high_index(l2hl.a2ab, sorted_lh2h, codes);
+  return Adj(l2hl.a2ab, sorted_lh2h, codes);
+}
+
+/* times the derivation of every upward adjacency,
+   which is what Mesh::ask_up does the first time it is asked */
+int main(int argc, char** argv) {
+  auto lib = Library(&argc, &argv);
+  auto world = lib.self();
+  CmdLine cmdline;
+  auto& nx_flag = cmdline.add_flag(
+      "-n", "elements along each box edge (203 gives 50M tets)");
+  nx_flag.add_arg<int>("nx");
+  auto& iters_flag = cmdline.add_flag("-i", "number of repetitions");
+  iters_flag.add_arg<int>("niters");
+  if (!cmdline.parse_final(world, &argc, argv)) return -1;
+  LO nx = 40;
+  if (cmdline.parsed("-n")) nx = cmdline.get<int>("-n", "nx");
+  Int niters = 3;
+  if (cmdline.parsed("-i")) niters = cmdline.get<int>("-i", "niters");
+  auto mesh = build_box(world, OMEGA_H_SIMPLEX, 1, 1, 1, nx, nx, nx);
+  std::cout << mesh.nelems() << " tets, " << mesh.nverts() << " vertices\n";
+  for (Int high = 1; high <= mesh.dim(); ++high) {
+    for (Int low = 0; low < high; ++low) {
+      auto const down = mesh.ask_down(high, low);
+      auto const nlows_per_high = element_degree(mesh.family(), high, low);
+      auto const nlows = mesh.nents(low);
+      /* the first run of each is not timed */
+      auto const by_atomics =
+          invert_adj_by_atomics(down, nlows_per_high, nlows);
+      auto const by_blocks = invert_adj(down, nlows_per_high, nlows, high, low);
+      OMEGA_H_CHECK(by_atomics.a2ab == by_blocks.a2ab);
+      OMEGA_H_CHECK(by_atomics.ab2b == by_blocks.ab2b);
+      auto const t0 = now();
+      for (Int iter = 0; iter < niters; ++iter) {
+        invert_adj_by_atomics(down, nlows_per_high, nlows);
+      }
+      auto const t1 = now();
+      for (Int iter = 0; iter < niters; ++iter) {
+        invert_adj(down, nlows_per_high, nlows, high, low);
+      }
+      auto const t2 = now();
+      std::cout << dimensional_plural_name(low) << " to "
+                << dimensional_plural_name(high) << ": atomics and sort "
+                << (t1 - t0) / niters << " s, blocks " << (t2 - t1) / niters
+                << " s\n";
+    }
+  }
+}
@@ -0,0 +1,212 @@
+#include <Omega_h_amr_forest.hpp>
+#include <Omega_h_array_ops.hpp>
+#include <Omega_h_build.hpp>
+#include <Omega_h_for.hpp>
+#include <Omega_h_library.hpp>
+#include <Omega_h_map.hpp>
+
+#include "amr_test_common.hpp"
+
+#include <cmath>
+
+using namespace Omega_h;
+
+/* the leaves of these tests are boxes aligned with the axes */
+static Real get_measure(Mesh* mesh) {
+  auto const dim = mesh->dim();
+  auto const nverts_per_elem = 1 << dim;
+  auto const coords = mesh->coords();
+  auto const ev2v = mesh->ask_elem_verts();
+  Write<Real> volumes(mesh->nelems());
+  auto f = OMEGA_H_LAMBDA(LO e) {
+    Real volume = 1.0;
+    for (Int a = 0; a < dim; ++a) {
+      Real lo = coords[ev2v[e * nverts_per_elem] * dim + a];
+      Real hi = lo;
+      for (Int v = 1; v < nverts_per_elem; ++v) {
+        auto const x = coords[ev2v[e * nverts_per_elem + v] * dim + a];
+        lo = min2(lo, x);
+        hi = max2(hi, x);
+      }
+      volume *= hi - lo;
+    }
+    volumes[e] = volume;
+  };
+  parallel_for(mesh->nelems(), f);
+  return mesh->comm()->allreduce(get_sum(Reals(volumes)), OMEGA_H_SUM);
+}
+
+/* the total measure of the owned sides in (marks) */
+static Real get_side_measure(Mesh* mesh, Read<I8> marks) {
+  auto const dim = mesh->dim();
+  auto const nverts_per_side = 1 << (dim - 1);
+  auto const coords = mesh->coords();
+  auto const sv2v = mesh->ask_verts_of(dim - 1);
+  auto const owned = mesh->owned(dim - 1);
+  Write<Real> areas(mesh->nents(dim - 1));
+  auto f = OMEGA_H_LAMBDA(LO s) {
+    Real area = 1.0;
+    for (Int a = 0; a < dim; ++a) {
+      Real lo = coords[sv2v[s * nverts_per_side] * dim + a];
+      Real hi = lo;
+      for (Int v = 1; v < nverts_per_side; ++v) {
+        auto const x = coords[sv2v[s * nverts_per_side + v] * dim + a];
+        lo = min2(lo, x);
+        hi = max2(hi, x);
+      }
+      if (hi > lo) area *= hi - lo;
+    }
+    areas[s] = (marks[s] && owned[s]) ? area : 0.0;
+  };
+  parallel_for(mesh->nents(dim - 1), f);
+  return mesh->comm()->allreduce(get_sum(Reals(areas)), OMEGA_H_SUM);
+}
+
+/* marks the leaves whose centers are within (radius) of (point) */
+static Bytes mark_near(Mesh* mesh, Vector<3> point, Real radius) {
+  auto const dim = mesh->dim();
+  auto const nverts_per_elem = 1 << dim;
+  auto const coords = mesh->coords();
+  auto const ev2v = mesh->ask_elem_verts();
+  Write<Byte> marks(mesh->nelems());
+  auto f = OMEGA_H_LAMBDA(LO e) {
+    Real d2 = 0.0;
+    for (Int a = 0; a < dim; ++a) {
+      Real c = 0.0;
+      for (Int v = 0; v < nverts_per_elem; ++v) {
+        c += coords[ev2v[e * nverts_per_elem + v] * dim + a];
+      }
+      c /= nverts_per_elem;
+      d2 += square(c - point[a]);
+    }
+    marks[e] = (d2 < square(radius));
+  };
+  parallel_for(mesh->nelems(), f);
+  return marks;
+}
+
+static Mesh build_roots(Library* lib, Int dim) {
+  return build_box(lib->self(), OMEGA_H_HYPERCUBE, 1., 1., (dim == 3) ? 1. : 0.,
+      2, 2, (dim == 3) ? 2 : 0);
+}
+
+static void test_uniform(Library* lib, Int dim) {
+  auto roots = build_roots(lib, dim);
+  amr::Forest forest(&roots, lib->world());
+  auto mesh = forest.mesh();
+  auto coords = mesh->coords();
+  Write<Real> u(mesh->nverts());
+  auto f = OMEGA_H_LAMBDA(LO v) {
+    u[v] = 0.0;
+    for (Int a = 0; a < dim; ++a) u[v] += (a + 1) * coords[v * dim + a];
+  };
+  parallel_for(mesh->nverts(), f);
+  mesh->add_tag(VERT, "u", 1, Reals(u));
+  mesh->add_tag(dim, "e", 1, mesh->get_array<LO>(dim, "forest_root"));
+  TransferOpts xfer_opts;
+  xfer_opts.type_map["u"] = OMEGA_H_LINEAR_INTERP;
+  xfer_opts.type_map["e"] = OMEGA_H_INHERIT;
+  for (Int i = 0; i < 2; ++i) {
+    forest.refine(Bytes(mesh->nelems(), 1), xfer_opts);
+  }
+  GO nside_elems = 8;
+  GO nelems = 1;
+  GO nverts = 1;
+  for (Int a = 0; a < dim; ++a) {
+    nelems *= nside_elems;
+    nverts *= nside_elems + 1;
+  }
+  OMEGA_H_CHECK(mesh->nglobal_ents(dim) == nelems);
+  OMEGA_H_CHECK(mesh->nglobal_ents(VERT) == nverts);
+  OMEGA_H_CHECK(are_close(get_measure(mesh), 1.0));
+  coords = mesh->coords();
+  auto new_u = mesh->get_array<Real>(VERT, "u");
+  Write<Real> exact_u(mesh->nverts());
+  parallel_for(mesh->nverts(), OMEGA_H_LAMBDA(LO v) {
+    exact_u[v] = 0.0;
+    for (Int a = 0; a < dim; ++a) exact_u[v] += (a + 1) * coords[v * dim + a];
+  });
+  OMEGA_H_CHECK(are_close(new_u, Reals(exact_u)));
+  OMEGA_H_CHECK(mesh->get_array<LO>(dim, "e") ==
+                mesh->get_array<LO>(dim, "forest_root"));
+  auto class_dims = mesh->owned_array(
+      VERT, mesh->get_array<I8>(VERT, "class_dim"), 1);
+  auto ncorners = mesh->comm()->allreduce(
+      GO(get_sum(each_eq_to(class_dims, I8(0)))), OMEGA_H_SUM);
+  OMEGA_H_CHECK(ncorners == (GO(1) << dim));
+  LOs parent_roots;
+  Bytes parent_levels;
+  auto parents = forest.ask_parents(&parent_roots, nullptr, &parent_levels);
+  auto nparents = parent_roots.size();
+  OMEGA_H_CHECK(nparents * (1 << dim) == mesh->nelems());
+  OMEGA_H_CHECK(parent_levels == Bytes(nparents, 1));
+  OMEGA_H_CHECK(get_min(parents.parent_idx) == 0);
+  auto children = forest.ask_children();
+  OMEGA_H_CHECK(children.a2ab == LOs(nparents + 1, 0, 1 << dim));
+}
+
+/* refines towards one point, keeping 2:1 balance across roots.
+   the distributed forest must end with the leaves of a serial one */
+static void refine_towards(amr::Forest* forest, Vector<3> point) {
+  auto mesh = forest->mesh();
+  for (Int i = 1; i <= 4; ++i) {
+    auto marks = mark_near(mesh, point, 0.3 / i);
+    marks = forest->enforce_2to1_refine(VERT, marks);
+    forest->refine(marks, TransferOpts());
+  }
+}
+
+static void test_balance(Library* lib, Int dim) {
+  auto roots = build_roots(lib, dim);
+  auto point = vector_3(0.3, 0.3, (dim == 3) ? 0.3 : 0.0);
+  amr::Forest serial(&roots, lib->self());
+  refine_towards(&serial, point);
+  check_2to1(serial.mesh());
+  amr::Forest forest(&roots, lib->world());
+  refine_towards(&forest, point);
+  auto mesh = forest.mesh();
+  for (Int d = 0; d <= dim; ++d) {
+    OMEGA_H_CHECK(mesh->nglobal_ents(d) == serial.mesh()->nglobal_ents(d));
+  }
+  OMEGA_H_CHECK(are_close(get_measure(mesh), 1.0));
+  /* the hanging sides have one leaf each, but they are inside the box */
+  auto serial_exposed = serial.mark_exposed_sides();
+  auto one_leaf = mark_exposed_sides(serial.mesh());
+  OMEGA_H_CHECK(get_sum(one_leaf) > get_sum(serial_exposed));
+  auto exposed = forest.mark_exposed_sides();
+  OMEGA_H_CHECK(exposed == each_eq_to(mesh->get_array<I8>(dim - 1,
+                                          "class_dim"), I8(dim - 1)));
+  OMEGA_H_CHECK(are_close(get_side_measure(mesh, exposed), Real(2 * dim)));
+}
+
+/* two roots whose local frames are rotated against each other */
+static void test_rotated_roots(Library* lib) {
+  Mesh roots(lib);
+  auto ev2v = LOs({0, 1, 4, 3, 5, 4, 1, 2});
+  auto coords = Reals({0, 0, 1, 0, 2, 0, 0, 1, 1, 1, 2, 1});
+  build_from_elems_and_coords(&roots, OMEGA_H_HYPERCUBE, 2, ev2v, coords);
+  amr::Forest serial(&roots, lib->self());
+  for (Int i = 0; i < 2; ++i) {
+    serial.refine(Bytes(serial.mesh()->nelems(), 1), TransferOpts());
+  }
+  OMEGA_H_CHECK(serial.mesh()->nverts() == 9 * 5);
+  refine_towards(&serial, vector_3(0.9, 0.5, 0.0));
+  check_2to1(serial.mesh());
+  amr::Forest forest(&roots, lib->world());
+  for (Int i = 0; i < 2; ++i) {
+    forest.refine(Bytes(forest.mesh()->nelems(), 1), TransferOpts());
+  }
+  refine_towards(&forest, vector_3(0.9, 0.5, 0.0));
+  OMEGA_H_CHECK(forest.mesh()->nglobal_ents(FACE) == serial.mesh()->nelems());
+  OMEGA_H_CHECK(forest.mesh()->nglobal_ents(VERT) == serial.mesh()->nverts());
+  OMEGA_H_CHECK(are_close(get_measure(forest.mesh()), 2.0));
+}
+
+int main(int argc, char** argv) {
+  auto lib = Library(&argc, &argv);
+  for (Int dim = 2; dim <= 3; ++dim) {
+    test_uniform(&lib, dim);
+    test_balance(&lib, dim);
+  }
+  test_rotated_roots(&lib);
+}
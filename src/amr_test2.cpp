@@ -5,6 +5,8 @@
 #include <Omega_h_for.hpp>
 #include <Omega_h_map.hpp>
 
+#include "amr_test_common.hpp"
+
 template <int dim>
 OMEGA_H_INLINE double eval_rc(Omega_h::Vector<dim> c);
 
@@ -72,8 +74,134 @@ void run_3D_adapt(Omega_h::Library* lib) {
   }
 }
 
+/* marks the leaf containing a point near the center of the box */
+template <int dim>
+static Omega_h::Bytes mark_point(Omega_h::Mesh* m) {
+  auto coords = m->coords();
+  auto mids = Omega_h::average_field(m, dim, dim, coords);
+  auto is_leaf = m->ask_leaves(dim);
+  auto levels = m->ask_levels(dim);
+  Omega_h::Write<Omega_h::Byte> marks(m->nelems(), 0);
+  auto f = OMEGA_H_LAMBDA(Omega_h::LO e) {
+    auto c = Omega_h::get_vector<dim, Omega_h::Reals>(mids, e);
+    auto half_width = 0.25 / double(1 << levels[e]);
+    bool contains = true;
+    for (int i = 0; i < dim; ++i) {
+      if (std::abs(c[i] - 0.49) > half_width) contains = false;
+    }
+    if (is_leaf[e] && contains) marks[e] = 1;
+  };
+  Omega_h::parallel_for(m->nelems(), f);
+  return marks;
+}
+
+/* refining the marks of the fixed point must leave a 2:1 mesh,
+   and a mark must spread over more than one round */
+template <int dim>
+static void run_fixed_point_2to1(Omega_h::Library* lib) {
+  auto m = Omega_h::build_box(lib->self(), OMEGA_H_HYPERCUBE, 1.0, 1.0,
+      (dim == 3) ? 1.0 : 0.0, 2, 2, (dim == 3) ? 2 : 0);
+  int max_nrounds = 0;
+  for (int i = 0; i < 7 - dim; ++i) {
+    int nrounds;
+    auto marks = Omega_h::amr::enforce_2to1_refine_fixed_point(
+        &m, 0, mark_point<dim>(&m), &nrounds);
+    Omega_h::amr::refine(&m, marks, Omega_h::TransferOpts());
+    check_2to1(&m);
+    max_nrounds = std::max(max_nrounds, nrounds);
+  }
+  OMEGA_H_CHECK(max_nrounds >= 2);
+}
+
+/* refines the middle of a 4^dim box and has rank 0 mark the leaves
+   it owns there, so that the elements other ranks must mark around
+   them are only known through the shared boundary */
+template <int dim>
+static Omega_h::Bytes refine_middle_and_mark(Omega_h::Mesh* m) {
+  auto mids = Omega_h::average_field(m, dim, dim, m->coords());
+  Omega_h::Write<Omega_h::Byte> middle(m->nelems(), 0);
+  auto f = OMEGA_H_LAMBDA(Omega_h::LO e) {
+    auto c = Omega_h::get_vector<dim, Omega_h::Reals>(mids, e);
+    bool inside = true;
+    for (int i = 0; i < dim; ++i) {
+      if (std::abs(c[i] - 0.5) > 0.25) inside = false;
+    }
+    middle[e] = inside;
+  };
+  Omega_h::parallel_for(m->nelems(), f);
+  Omega_h::amr::refine(m, middle, Omega_h::TransferOpts());
+  auto is_leaf = m->ask_leaves(dim);
+  auto levels = m->ask_levels(dim);
+  auto const seeds = (m->comm()->rank() == 0);
+  Omega_h::Write<Omega_h::Byte> marks(m->nelems(), 0);
+  auto g = OMEGA_H_LAMBDA(Omega_h::LO e) {
+    marks[e] = seeds && is_leaf[e] && levels[e] == 1;
+  };
+  Omega_h::parallel_for(m->nelems(), g);
+  return marks;
+}
+
+/* checks that the leaves around each vertex will differ by at most
+   one level once marked, across ranks. here a coarse leaf touching a
+   finer one always shares a vertex with it */
+template <int dim>
+static void check_marked_2to1(Omega_h::Mesh* m, Omega_h::Bytes marks) {
+  auto v2e = m->ask_up(Omega_h::VERT, dim);
+  auto is_leaf = m->ask_leaves(dim);
+  auto levels = m->ask_levels(dim);
+  Omega_h::Write<Omega_h::I8> lo(m->nverts());
+  Omega_h::Write<Omega_h::I8> hi(m->nverts());
+  auto f = OMEGA_H_LAMBDA(Omega_h::LO v) {
+    lo[v] = 127;
+    hi[v] = 0;
+    for (auto ve = v2e.a2ab[v]; ve < v2e.a2ab[v + 1]; ++ve) {
+      auto e = v2e.ab2b[ve];
+      if (!is_leaf[e]) continue;
+      Omega_h::I8 l = levels[e] + marks[e];
+      if (l < lo[v]) lo[v] = l;
+      if (l > hi[v]) hi[v] = l;
+    }
+  };
+  Omega_h::parallel_for(m->nverts(), f);
+  auto glo = m->sync_array(Omega_h::VERT,
+      m->reduce_array(Omega_h::VERT, Omega_h::Read<Omega_h::I8>(lo), 1,
+          OMEGA_H_MIN),
+      1);
+  auto ghi = m->sync_array(Omega_h::VERT,
+      m->reduce_array(Omega_h::VERT, Omega_h::Read<Omega_h::I8>(hi), 1,
+          OMEGA_H_MAX),
+      1);
+  auto h_lo = Omega_h::HostRead<Omega_h::I8>(glo);
+  auto h_hi = Omega_h::HostRead<Omega_h::I8>(ghi);
+  for (Omega_h::LO v = 0; v < m->nverts(); ++v) {
+    OMEGA_H_CHECK(h_hi[v] - h_lo[v] <= 1);
+  }
+}
+
+/* the distributed fixed point must spread marks between ranks.
+   only one refinement is done on the distributed mesh, since
+   repartitioning a mesh does not carry its parents yet */
+template <int dim>
+static void run_parallel_fixed_point_2to1(Omega_h::Library* lib) {
+  auto m = Omega_h::build_box(lib->world(), OMEGA_H_HYPERCUBE, 1.0, 1.0,
+      (dim == 3) ? 1.0 : 0.0, 4, 4, (dim == 3) ? 4 : 0);
+  auto seeds = refine_middle_and_mark<dim>(&m);
+  auto marks =
+      Omega_h::amr::enforce_2to1_refine_fixed_point(&m, 0, seeds, nullptr);
+  check_marked_2to1<dim>(&m, marks);
+  Omega_h::GO nforced = 0;
+  if (m.comm()->rank() != 0) nforced = Omega_h::get_sum(marks);
+  nforced = m.comm()->allreduce(nforced, OMEGA_H_SUM);
+  if (m.comm()->size() > 1) OMEGA_H_CHECK(nforced > 0);
+}
+
 int main(int argc, char** argv) {
   auto lib = Omega_h::Library(&argc, &argv);
   run_2D_adapt(&lib);
-  run_3D_adapt(&lib);
+  /* the second refinement would repartition a mesh with parents */
+  if (lib.world()->size() == 1) run_3D_adapt(&lib);
+  run_fixed_point_2to1<2>(&lib);
+  run_fixed_point_2to1<3>(&lib);
+  run_parallel_fixed_point_2to1<2>(&lib);
+  run_parallel_fixed_point_2to1<3>(&lib);
 }
@@ -0,0 +1,48 @@
+#ifndef AMR_TEST_COMMON_HPP
+#define AMR_TEST_COMMON_HPP
+
+#include <Omega_h_array.hpp>
+#include <Omega_h_fail.hpp>
+#include <Omega_h_mesh.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+
+/* helpers shared by the AMR tests, whose leaves are boxes
+   aligned with the axes */
+
+/* checks that leaves touching at any point differ by at most one level.
+   the comparison is brute force over this rank's elements */
+inline void check_2to1(Omega_h::Mesh* mesh) {
+  using namespace Omega_h;
+  auto const dim = mesh->dim();
+  auto const nverts_per_elem = 1 << dim;
+  auto const coords = HostRead<Real>(mesh->coords());
+  auto const ev2v = HostRead<LO>(mesh->ask_elem_verts());
+  auto const levels = HostRead<Byte>(mesh->ask_levels(dim));
+  auto const is_leaf = HostRead<Byte>(mesh->ask_leaves(dim));
+  auto const nelems = mesh->nelems();
+  auto const tol = 1e-10;
+  for (LO a = 0; a < nelems; ++a) {
+    if (!is_leaf[a]) continue;
+    for (LO b = a + 1; b < nelems; ++b) {
+      if (!is_leaf[b]) continue;
+      bool touch = true;
+      for (Int i = 0; i < dim; ++i) {
+        Real alo = 1e10, ahi = -1e10, blo = 1e10, bhi = -1e10;
+        for (Int v = 0; v < nverts_per_elem; ++v) {
+          auto const ax = coords[ev2v[a * nverts_per_elem + v] * dim + i];
+          auto const bx = coords[ev2v[b * nverts_per_elem + v] * dim + i];
+          alo = std::min(alo, ax);
+          ahi = std::max(ahi, ax);
+          blo = std::min(blo, bx);
+          bhi = std::max(bhi, bx);
+        }
+        if (alo > bhi + tol || blo > ahi + tol) touch = false;
+      }
+      if (touch) OMEGA_H_CHECK(std::abs(levels[a] - levels[b]) <= 1);
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,89 @@
+#include <Omega_h_adapt.hpp>
+#include <Omega_h_arena.hpp>
+#include <Omega_h_array_ops.hpp>
+#include <Omega_h_build.hpp>
+#include <Omega_h_cmdline.hpp>
+#include <Omega_h_timer.hpp>
+#include <iostream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+using namespace Omega_h;
+
+static long get_minor_page_faults() {
+#if defined(__unix__) || defined(__APPLE__)
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_minflt;
+#else
+  return 0;
+#endif
+}
+
+/* alternately refine and coarsen a box by a factor of two in
+   edge length, so every cycle exercises all adapt operators */
+static void run_cycles(Library* lib, LO nx, Int ncycles, bool report) {
+  auto world = lib->world();
+  auto mesh = build_box(world, OMEGA_H_SIMPLEX, 1, 1, 1, nx, nx, nx);
+  mesh.set_parting(OMEGA_H_GHOSTED);
+  add_implied_isos_tag(&mesh);
+  auto opts = AdaptOpts(&mesh);
+  opts.verbosity = SILENT;
+  reset_arena_stats();
+  auto const faults_before = get_minor_page_faults();
+  auto const t0 = now();
+  for (Int cycle = 0; cycle < ncycles; ++cycle) {
+    auto const h = ((cycle % 2 == 0) ? 0.5 : 1.0) / Real(nx);
+    auto const target = Reals(mesh.nverts(), 1.0 / (h * h));
+    mesh.add_tag(VERT, "target_metric", 1, target);
+    add_implied_isos_tag(&mesh);
+    while (approach_metric(&mesh, opts) && adapt(&mesh, opts))
+      ;
+  }
+  auto const t1 = now();
+  auto const faults = get_minor_page_faults() - faults_before;
+  auto const stats = get_arena_stats();
+  auto const nunderlying =
+      stats.nallocs - stats.narena_allocs + stats.nchunk_mallocs;
+  if (report && world->rank() == 0) {
+    std::cout << (arenas_enabled() ? "arenas:    " : "no arenas: ") << (t1 - t0)
+              << " seconds, " << stats.nallocs << " array allocations, "
+              << nunderlying << " underlying allocations ("
+              << stats.nchunk_mallocs << " chunks, " << stats.nchunk_reuses
+              << " chunk reuses, " << stats.nchunk_pins
+              << " chunks pinned), " << faults << " minor page faults, "
+              << mesh.nglobal_ents(mesh.dim()) << " final elements\n";
+  }
+}
+
+int main(int argc, char** argv) {
+  auto lib = Library(&argc, &argv);
+  auto world = lib.world();
+  CmdLine cmdline;
+  auto& nx_flag = cmdline.add_flag("-n", "elements along each box edge");
+  nx_flag.add_arg<int>("nx");
+  auto& cycles_flag = cmdline.add_flag("-c", "number of adapt cycles");
+  cycles_flag.add_arg<int>("ncycles");
+  auto& chunk_flag = cmdline.add_flag("-k", "arena chunk size in kilobytes");
+  chunk_flag.add_arg<int>("kilobytes");
+  if (!cmdline.parse_final(world, &argc, argv)) return -1;
+  LO nx = 8;
+  if (cmdline.parsed("-n")) nx = cmdline.get<int>("-n", "nx");
+  Int ncycles = 4;
+  if (cmdline.parsed("-c")) ncycles = cmdline.get<int>("-c", "ncycles");
+  std::size_t chunk_bytes = std::size_t(4) << 20;
+  if (cmdline.parsed("-k")) {
+    chunk_bytes = std::size_t(cmdline.get<int>("-k", "kilobytes")) << 10;
+  }
+  OMEGA_H_CHECK(!arenas_enabled());
+  /* each variant is run twice and only the second run is reported,
+     so neither is charged for growing the heap or the arena */
+  run_cycles(&lib, nx, ncycles, false);
+  run_cycles(&lib, nx, ncycles, true);
+  enable_arenas(chunk_bytes);
+  run_cycles(&lib, nx, ncycles, false);
+  run_cycles(&lib, nx, ncycles, true);
+  disable_arenas();
+}
@@ -0,0 +1,115 @@
+#include <Omega_h_array_ops.hpp>
+#include <Omega_h_build.hpp>
+#include <Omega_h_file.hpp>
+#include <Omega_h_for.hpp>
+#include <Omega_h_library.hpp>
+#include <Omega_h_map.hpp>
+#include <Omega_h_mark.hpp>
+#include <Omega_h_mesh.hpp>
+
+#include <exodusII.h>
+
+#include <cstdint>
+#include <map>
+#include <vector>
+
+using namespace Omega_h;
+
+/* each rank's file must hold its owned elements and only their
+   vertices, numbered by the global id maps, and on several ranks
+   the Nemesis data must split those into internal and border ones */
+static void test_writer(CommPtr comm, Int dim) {
+  auto mesh = build_box(comm, OMEGA_H_SIMPLEX, 1.0, 1.0,
+      (dim == 3) ? 1.0 : 0.0, 2, 2, (dim == 3) ? 2 : 0);
+  /* ghosts add vertices that no owned element uses */
+  if (comm->size() > 1) mesh.set_parting(OMEGA_H_GHOSTED);
+  auto const coords = mesh.coords();
+  Write<Real> x(mesh.nverts());
+  auto f = OMEGA_H_LAMBDA(LO v) { x[v] = coords[v * dim]; };
+  parallel_for(mesh.nverts(), f);
+  mesh.add_tag(VERT, "x", 1, Reals(x));
+  auto const path =
+      std::string("exodus_test_") + std::to_string(dim) + ".exo";
+  /* the background writer must leave the same file */
+  for (bool background : {false, true}) {
+    exodus::Writer writer(path, &mesh, background);
+    writer.write(0.0);
+    writer.write(1.0);
+    writer.close();
+  }
+  auto file_path = path;
+  if (comm->size() > 1) {
+    file_path += "." + std::to_string(comm->size()) + "." +
+                 std::to_string(comm->rank());
+  }
+  auto const owned_elems = mesh.owned(dim);
+  auto const verts_used = mark_down(&mesh, dim, VERT, owned_elems);
+  auto const file = exodus::open(file_path);
+  OMEGA_H_CHECK(exodus::get_num_time_steps(file) == 2);
+  ex_init_params params;
+  OMEGA_H_CHECK(ex_get_init_ext(file, &params) == 0);
+  auto const nfile_verts = LO(params.num_nodes);
+  auto const nfile_elems = LO(params.num_elem);
+  OMEGA_H_CHECK(nfile_verts == get_sum(verts_used));
+  OMEGA_H_CHECK(nfile_elems == mesh.nents_owned(dim));
+  OMEGA_H_CHECK(comm->allreduce(GO(nfile_elems), OMEGA_H_SUM) ==
+                mesh.nglobal_ents(dim));
+  auto const h_nfile_verts = static_cast<std::size_t>(nfile_verts);
+  auto const h_nfile_elems = static_cast<std::size_t>(nfile_elems);
+  std::vector<std::int64_t> vert_ids(h_nfile_verts);
+  std::vector<std::int64_t> elem_ids(h_nfile_elems);
+  OMEGA_H_CHECK(ex_get_id_map(file, EX_NODE_MAP, vert_ids.data()) == 0);
+  OMEGA_H_CHECK(ex_get_id_map(file, EX_ELEM_MAP, elem_ids.data()) == 0);
+  std::vector<Real> file_coords[3];
+  for (auto& c : file_coords) c.resize(h_nfile_verts);
+  OMEGA_H_CHECK(ex_get_coord(file, file_coords[0].data(),
+                    file_coords[1].data(), file_coords[2].data()) == 0);
+  std::vector<Real> file_x(h_nfile_verts);
+  OMEGA_H_CHECK(ex_get_var(file, 2, EX_NODAL, 1, 0, nfile_verts,
+                    file_x.data()) == 0);
+  auto const h_vert_globals = HostRead<GO>(mesh.globals(VERT));
+  auto const h_elem_globals = HostRead<GO>(mesh.globals(dim));
+  auto const h_verts_used = HostRead<I8>(verts_used);
+  auto const h_owned_elems = HostRead<I8>(owned_elems);
+  auto const h_coords = HostRead<Real>(coords);
+  std::map<GO, LO> globals2verts;
+  for (LO v = 0; v < mesh.nverts(); ++v) {
+    globals2verts[h_vert_globals[v]] = v;
+  }
+  for (LO i = 0; i < nfile_verts; ++i) {
+    auto const it = globals2verts.find(vert_ids[std::size_t(i)] - 1);
+    OMEGA_H_CHECK(it != globals2verts.end());
+    auto const v = it->second;
+    OMEGA_H_CHECK(h_verts_used[v]);
+    for (Int j = 0; j < dim; ++j) {
+      OMEGA_H_CHECK(file_coords[j][std::size_t(i)] == h_coords[v * dim + j]);
+    }
+    OMEGA_H_CHECK(file_x[std::size_t(i)] == h_coords[v * dim]);
+  }
+  std::map<GO, LO> globals2elems;
+  for (LO e = 0; e < mesh.nelems(); ++e) {
+    if (h_owned_elems[e]) globals2elems[h_elem_globals[e]] = e;
+  }
+  for (LO i = 0; i < nfile_elems; ++i) {
+    OMEGA_H_CHECK(globals2elems.count(elem_ids[std::size_t(i)] - 1));
+  }
+  if (comm->size() > 1) {
+    int nint_verts, nbor_verts, next_verts, nint_elems, nbor_elems;
+    int nvert_cmaps, nelem_cmaps;
+    OMEGA_H_CHECK(ex_get_loadbal_param(file, &nint_verts, &nbor_verts,
+                      &next_verts, &nint_elems, &nbor_elems, &nvert_cmaps,
+                      &nelem_cmaps, comm->rank()) == 0);
+    OMEGA_H_CHECK(nint_verts + nbor_verts == nfile_verts);
+    OMEGA_H_CHECK(next_verts == 0);
+    OMEGA_H_CHECK(nint_elems + nbor_elems == nfile_elems);
+    OMEGA_H_CHECK(nvert_cmaps > 0);
+    OMEGA_H_CHECK(nelem_cmaps <= nvert_cmaps);
+  }
+  exodus::close(file);
+}
+
+int main(int argc, char** argv) {
+  auto lib = Library(&argc, &argv);
+  test_writer(lib.world(), 2);
+  test_writer(lib.world(), 3);
+}
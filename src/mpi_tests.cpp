@@ -4,7 +4,11 @@
 #include <Omega_h_compare.hpp>
 #include <Omega_h_for.hpp>
 #include <Omega_h_inertia.hpp>
+#include <Omega_h_metric.hpp>
+#include <Omega_h_migrate.hpp>
 #include <Omega_h_owners.hpp>
+#include <Omega_h_refine.hpp>
+#include <Omega_h_shape.hpp>
 #include <Omega_h_vtk.hpp>
 
 #include <sstream>
@@ -211,11 +215,11 @@ static void test_two_ranks_eq_owners(CommPtr comm) {
   if (comm->rank() == 0) {
     auto owners = owners_from_globals(comm, Read<GO>({0, 1, 2}), Read<I32>());
     OMEGA_H_CHECK(owners.ranks == Read<I32>({0, 0, 0}));
-    OMEGA_H_CHECK(owners.idxs == Read<I32>({0, 1, 2}));
+    OMEGA_H_CHECK(owners.idxs == LOs({0, 1, 2}));
   } else {
     auto owners = owners_from_globals(comm, Read<GO>({2, 3, 4}), Read<I32>());
     OMEGA_H_CHECK(owners.ranks == Read<I32>({0, 1, 1}));
-    OMEGA_H_CHECK(owners.idxs == Read<I32>({2, 1, 2}));
+    OMEGA_H_CHECK(owners.idxs == LOs({2, 1, 2}));
   }
 }
 
@@ -226,11 +230,11 @@ static void test_two_ranks_uneq_owners(CommPtr comm) {
   if (comm->rank() == 0) {
     auto owners = owners_from_globals(comm, Read<GO>({0, 1, 2}), Read<I32>());
     OMEGA_H_CHECK(owners.ranks == Read<I32>({0, 0, 1}));
-    OMEGA_H_CHECK(owners.idxs == Read<I32>({0, 1, 0}));
+    OMEGA_H_CHECK(owners.idxs == LOs({0, 1, 0}));
   } else {
     auto owners = owners_from_globals(comm, Read<GO>({2, 3}), Read<I32>());
     OMEGA_H_CHECK(owners.ranks == Read<I32>({1, 1}));
-    OMEGA_H_CHECK(owners.idxs == Read<I32>({0, 1}));
+    OMEGA_H_CHECK(owners.idxs == LOs({0, 1}));
   }
 }
 
@@ -243,12 +247,12 @@ static void test_two_ranks_forced_owners(CommPtr comm) {
     auto owners =
         owners_from_globals(comm, Read<GO>({0, 1, 2}), Read<I32>({0, 0, 0}));
     OMEGA_H_CHECK(owners.ranks == Read<I32>({0, 0, 0}));
-    OMEGA_H_CHECK(owners.idxs == Read<I32>({0, 1, 2}));
+    OMEGA_H_CHECK(owners.idxs == LOs({0, 1, 2}));
   } else {
     auto owners =
         owners_from_globals(comm, Read<GO>({2, 3}), Read<I32>({0, 1}));
     OMEGA_H_CHECK(owners.ranks == Read<I32>({0, 1}));
-    OMEGA_H_CHECK(owners.idxs == Read<I32>({2, 1}));
+    OMEGA_H_CHECK(owners.idxs == LOs({2, 1}));
   }
 }
 
@@ -406,6 +410,347 @@ void test_rib(CommPtr comm) {
   OMEGA_H_CHECK(masses == Reals(n, 1));
 }
 
+template <typename T>
+static Read<T> make_mixed_tag(GOs globals, Int ncomps) {
+  Write<T> out(globals.size() * ncomps);
+  auto f = OMEGA_H_LAMBDA(LO i) {
+    for (Int c = 0; c < ncomps; ++c) out[i * ncomps + c] = T(globals[i] * 7 + c);
+  };
+  parallel_for(globals.size(), f);
+  return out;
+}
+
+template <typename T>
+static void check_pushed_tag(
+    Mesh* new_mesh, Dist old2new, TagBase const* tag) {
+  auto unpacked = old2new.exch(as<T>(tag)->array(), tag->ncomps());
+  OMEGA_H_CHECK(new_mesh->get_array<T>(VERT, tag->name()) == unpacked);
+}
+
+/* migrate vertex tags of every type and several widths to the next
+   rank, packed together and split one tag per group, and compare both
+   with exchanging each tag by itself */
+static void test_push_tags(CommPtr comm) {
+  auto mesh = build_box(comm, OMEGA_H_SIMPLEX, 1., 1., 0., 4, 4, 0);
+  auto globals = mesh.globals(VERT);
+  mesh.add_tag(VERT, "mixed_i8", 3, make_mixed_tag<I8>(globals, 3));
+  mesh.add_tag(VERT, "mixed_i32", 2, make_mixed_tag<I32>(globals, 2));
+  mesh.add_tag(VERT, "mixed_i64", 1, make_mixed_tag<I64>(globals, 1));
+  mesh.add_tag(VERT, "mixed_f64", 6, make_mixed_tag<Real>(globals, 6));
+  auto nverts = mesh.nverts();
+  Dist old2new;
+  old2new.set_parent_comm(comm);
+  old2new.set_dest_ranks(
+      Read<I32>(nverts, (comm->rank() + 1) % comm->size()));
+  old2new.set_roots2items(LOs(nverts + 1, 0, 1));
+  old2new.set_dest_globals(globals);
+  for (Int max_group_width : {0, 1}) {
+    auto new_mesh = mesh.copy_meta();
+    new_mesh.set_verts(old2new.ndests());
+    auto pushed = ipush_tags(&mesh, VERT, old2new, max_group_width);
+    auto ngroups = pushed.packs.size();
+    OMEGA_H_CHECK(ngroups ==
+                  (max_group_width ? std::size_t(mesh.ntags(VERT)) : 1));
+    add_pushed_tags(&mesh, &new_mesh, VERT, pushed);
+    OMEGA_H_CHECK(new_mesh.ntags(VERT) == mesh.ntags(VERT));
+    for (Int i = 0; i < mesh.ntags(VERT); ++i) {
+      auto tag = mesh.get_tag(VERT, i);
+      switch (tag->type()) {
+        case OMEGA_H_I8:
+          check_pushed_tag<I8>(&new_mesh, old2new, tag);
+          break;
+        case OMEGA_H_I32:
+          check_pushed_tag<I32>(&new_mesh, old2new, tag);
+          break;
+        case OMEGA_H_I64:
+          check_pushed_tag<I64>(&new_mesh, old2new, tag);
+          break;
+        case OMEGA_H_F64:
+          check_pushed_tag<Real>(&new_mesh, old2new, tag);
+          break;
+      }
+    }
+    auto new_globals = new_mesh.globals(VERT);
+    OMEGA_H_CHECK(new_mesh.get_array<Real>(VERT, "mixed_f64") ==
+                  make_mixed_tag<Real>(new_globals, 6));
+  }
+}
+
+/* with reproducible reductions, a global sum of values that round
+   differently in every order is the same for any split over ranks */
+static void test_repro_get_sum(CommPtr comm) {
+  LO const n = 1000;
+  auto value = OMEGA_H_LAMBDA(LO i)->Real {
+    return ((i % 3 == 0) ? 1e16 : 1.0) * ((i % 2) ? -1.0 : 1.0) *
+           (1.0 + Real(i) * 1e-3);
+  };
+  Write<Real> all(n);
+  auto fill_all = OMEGA_H_LAMBDA(LO i) { all[i] = value(i); };
+  parallel_for(n, fill_all);
+  auto const rank = comm->rank();
+  auto const size = comm->size();
+  /* contiguous blocks, and every size-th value */
+  auto const begin = LO((I64(n) * rank) / size);
+  auto const end = LO((I64(n) * (rank + 1)) / size);
+  Write<Real> block(end - begin);
+  auto fill_block = OMEGA_H_LAMBDA(LO i) { block[i] = value(begin + i); };
+  parallel_for(end - begin, fill_block);
+  auto const nstrided = (n - rank + size - 1) / size;
+  Write<Real> strided(nstrided);
+  auto fill_strided = OMEGA_H_LAMBDA(LO i) {
+    strided[i] = value(rank + i * size);
+  };
+  parallel_for(nstrided, fill_strided);
+  auto const was_enabled = repro_reductions_enabled();
+  enable_repro_reductions();
+  auto const expected = repro_sum(Reals(all));
+  OMEGA_H_CHECK(get_sum(comm, Reals(block)) == expected);
+  OMEGA_H_CHECK(get_sum(comm, Reals(strided)) == expected);
+  if (!was_enabled) disable_repro_reductions();
+}
+
+static void test_incremental_balance(CommPtr comm) {
+  auto mesh = build_box(comm, OMEGA_H_SIMPLEX, 1., 1., 0., 16, 16, 0);
+  mesh.set_parting(OMEGA_H_ELEM_BASED);
+  /* pile a quarter of every rank's elements onto rank 0 */
+  auto nelems = mesh.nelems();
+  Write<I32> dest_ranks(nelems, comm->rank());
+  auto f = OMEGA_H_LAMBDA(LO e) {
+    if (e < nelems / 4) dest_ranks[e] = 0;
+  };
+  parallel_for(nelems, f);
+  Dist old2new;
+  old2new.set_parent_comm(comm);
+  old2new.set_dest_ranks(dest_ranks);
+  old2new.set_roots2items(LOs(nelems + 1, 0, 1));
+  old2new.set_dest_globals(mesh.globals(mesh.dim()));
+  migrate_mesh(&mesh, old2new.invert(), OMEGA_H_ELEM_BASED, false);
+  OMEGA_H_CHECK(mesh.imbalance() > 1.1);
+  auto nglobal_elems = mesh.nglobal_ents(mesh.dim());
+  auto nbytes = mesh.balance_incremental(1.1);
+  OMEGA_H_CHECK(nbytes > 0);
+  OMEGA_H_CHECK(mesh.imbalance() <= 1.1);
+  OMEGA_H_CHECK(mesh.nglobal_ents(mesh.dim()) == nglobal_elems);
+  OMEGA_H_CHECK(mesh.balance_incremental(1.1) == 0);
+}
+
+static void test_graph_cache(CommPtr comm) {
+  auto next = Read<I32>({(comm->rank() + 1) % comm->size()});
+  auto a = comm->graph(next);
+  auto b = comm->graph(next);
+#ifdef OMEGA_H_USE_MPI
+  OMEGA_H_CHECK(a == b);
+  OMEGA_H_CHECK(a->graph_inverse() == b->graph_inverse());
+#endif
+  OMEGA_H_CHECK(b->sources() ==
+                Read<I32>({(comm->rank() + comm->size() - 1) % comm->size()}));
+  /* one rank asking for something else is enough to make a new one */
+  auto other = (comm->rank() == 0) ? Read<I32>({0}) : next;
+  auto c = comm->graph(other);
+  if (comm->size() > 1) {
+    OMEGA_H_CHECK(c != a);
+    auto srcs = HostRead<I32>(c->sources());
+    if (comm->rank() == 0) {
+      OMEGA_H_CHECK(srcs.size() == 2);
+      OMEGA_H_CHECK(srcs[0] == 0 && srcs[1] == comm->size() - 1);
+    } else if (comm->rank() == 1) {
+      OMEGA_H_CHECK(srcs.size() == 0);
+    }
+  }
+#ifdef OMEGA_H_USE_MPI
+  OMEGA_H_CHECK(comm->graph(next) == a);
+#endif
+}
+
+/* rank (r) contributes (r) copies of (r) */
+static void test_allgatherv(CommPtr comm) {
+  auto const rank = comm->rank();
+  auto const all = HostRead<I32>(comm->allgatherv(Read<I32>(rank, rank)));
+  auto const size = comm->size();
+  OMEGA_H_CHECK(all.size() == (size * (size - 1)) / 2);
+  LO i = 0;
+  for (I32 r = 0; r < size; ++r) {
+    for (I32 j = 0; j < r; ++j) OMEGA_H_CHECK(all[i++] == r);
+  }
+}
+
+static Real owned_measure(Mesh* mesh) {
+  auto sizes = measure_elements_real(mesh);
+  auto owned_sizes = mesh->owned_array(mesh->dim(), sizes, 1);
+  return mesh->comm()->allreduce(get_sum(owned_sizes), OMEGA_H_SUM);
+}
+
+/* dropping ghosts locally must give the mesh that migrating does */
+static void test_drop_ghosts(CommPtr comm) {
+  auto mesh0 = build_box(comm, OMEGA_H_SIMPLEX, 1., 1., 1., 4, 4, 4);
+  OMEGA_H_CHECK(!mesh0.drops_ghosts_locally());
+  for (auto parting : {OMEGA_H_GHOSTED, OMEGA_H_VERT_BASED}) {
+    auto mesh1 = mesh0;
+    mesh1.set_parting(parting);
+    auto mesh2 = mesh1;
+    mesh1.set_parting(OMEGA_H_ELEM_BASED);
+    mesh2.set_drop_ghosts_locally(true);
+    OMEGA_H_CHECK(mesh2.copy_meta().drops_ghosts_locally());
+    mesh2.set_parting(OMEGA_H_ELEM_BASED);
+    OMEGA_H_CHECK(mesh2.parting() == OMEGA_H_ELEM_BASED);
+    for (Int d = 0; d <= mesh1.dim(); ++d) {
+      OMEGA_H_CHECK(mesh2.nents(d) == mesh1.nents(d));
+    }
+    auto opts =
+        MeshCompareOpts::init(&mesh1, VarCompareOpts::zero_tolerance());
+    OMEGA_H_CHECK(
+        OMEGA_H_SAME == compare_meshes(&mesh1, &mesh2, opts, true, true));
+  }
+  /* adapt operators keep the setting on the meshes they build */
+  mesh0.add_tag(VERT, "metric", 1,
+      Reals(mesh0.nverts(), metric_eigenvalue_from_length(0.3)));
+  auto mesh1 = mesh0;
+  mesh1.set_drop_ghosts_locally(true);
+  auto adapt_opts = AdaptOpts(&mesh0);
+  adapt_opts.verbosity = SILENT;
+  while (refine_by_size(&mesh0, adapt_opts))
+    ;
+  while (refine_by_size(&mesh1, adapt_opts))
+    ;
+  OMEGA_H_CHECK(mesh1.drops_ghosts_locally());
+  for (Int d = 0; d <= mesh0.dim(); ++d) {
+    OMEGA_H_CHECK(mesh1.nglobal_ents(d) == mesh0.nglobal_ents(d));
+  }
+  OMEGA_H_CHECK(are_close(owned_measure(&mesh1), 1.0));
+}
+
+static void test_shared_file(Library* lib, CommPtr world) {
+  auto mesh0 = build_box(world, OMEGA_H_SIMPLEX, 1., 1., 0., 8, 8, 0);
+  mesh0.set_parting(OMEGA_H_GHOSTED);
+  binary::write_shared("mpi_test_shared.osh", &mesh0);
+  Mesh mesh1(lib);
+  auto nparts = binary::read_shared("mpi_test_shared.osh", world, &mesh1);
+  OMEGA_H_CHECK(nparts == world->size());
+  auto opts = MeshCompareOpts::init(&mesh0, VarCompareOpts::zero_tolerance());
+  OMEGA_H_CHECK(
+      OMEGA_H_SAME == compare_meshes(&mesh0, &mesh1, opts, true, true));
+  if (world->size() == 1) return;
+  GO nglobal_ents[4];
+  for (Int d = 0; d <= mesh0.dim(); ++d) {
+    nglobal_ents[d] = mesh0.nglobal_ents(d);
+  }
+  /* fewer ranks than parts, so that one rank reads two of them */
+  auto nreaders = world->size() - 1;
+  auto in_readers = (world->rank() < nreaders);
+  auto readers = world->split(I32(!in_readers), world->rank());
+  if (!in_readers) return;
+  auto mesh2 = binary::read_shared("mpi_test_shared.osh", readers);
+  OMEGA_H_CHECK(mesh2.comm()->size() == nreaders);
+  OMEGA_H_CHECK(mesh2.parting() == OMEGA_H_GHOSTED);
+  for (Int d = 0; d <= mesh2.dim(); ++d) {
+    OMEGA_H_CHECK(mesh2.nglobal_ents(d) == nglobal_ents[d]);
+  }
+  OMEGA_H_CHECK(are_close(owned_measure(&mesh2), 1.0));
+}
+
+/* restarts from a checkpoint written by half of the ranks.
+   by default the other ranks are left without a mesh; spreading
+   gives each part to two of them */
+static void test_restart_more_ranks(Library* lib, CommPtr world) {
+  if (world->size() < 2) return;
+  auto mesh0 = build_box(world, OMEGA_H_SIMPLEX, 1., 1., 0., 8, 8, 0);
+  GO nglobal_ents[4];
+  for (Int d = 0; d <= mesh0.dim(); ++d) {
+    nglobal_ents[d] = mesh0.nglobal_ents(d);
+  }
+  auto nwriters = world->size() / 2;
+  auto in_writers = (world->rank() < nwriters);
+  auto writers = world->split(I32(!in_writers), world->rank());
+  if (in_writers) {
+    auto mesh1 = build_box(writers, OMEGA_H_SIMPLEX, 1., 1., 0., 8, 8, 0);
+    mesh1.set_parting(OMEGA_H_GHOSTED);
+    binary::write("mpi_test_restart.osh", &mesh1);
+  }
+  world->barrier();
+  {
+    Mesh mesh2(lib);
+    auto nparts = binary::read("mpi_test_restart.osh", world, &mesh2);
+    OMEGA_H_CHECK(nparts == nwriters);
+    OMEGA_H_CHECK(mesh2.comm()->size() == world->size());
+    if (in_writers) OMEGA_H_CHECK(mesh2.nelems() > 0);
+  }
+  for (auto balance : {false, true}) {
+    Mesh mesh2(lib);
+    auto nparts = binary::read(
+        "mpi_test_restart.osh", world, &mesh2, false, true, balance);
+    OMEGA_H_CHECK(nparts == nwriters);
+    OMEGA_H_CHECK(mesh2.parting() == OMEGA_H_GHOSTED);
+    OMEGA_H_CHECK(mesh2.nelems() > 0);
+    for (Int d = 0; d <= mesh2.dim(); ++d) {
+      OMEGA_H_CHECK(mesh2.nglobal_ents(d) == nglobal_ents[d]);
+    }
+    OMEGA_H_CHECK(are_close(owned_measure(&mesh2), 1.0));
+  }
+}
+
+/* refining an element-based mesh without ghosting it
+   must choose the same keys as the ghosted path */
+static void test_refine_without_ghosts(CommPtr comm) {
+  auto mesh0 = build_box(comm, OMEGA_H_SIMPLEX, 1., 1., 1., 3, 3, 3);
+  mesh0.add_tag(VERT, "metric", 1,
+      Reals(mesh0.nverts(), metric_eigenvalue_from_length(0.2)));
+  auto mesh1 = mesh0;
+  auto opts = AdaptOpts(&mesh0);
+  opts.verbosity = SILENT;
+  while (refine_by_size(&mesh0, opts))
+    ;
+  opts.should_refine_without_ghosts = true;
+  while (refine_by_size(&mesh1, opts)) {
+    OMEGA_H_CHECK(mesh1.parting() == OMEGA_H_ELEM_BASED);
+  }
+  for (Int d = 0; d <= mesh0.dim(); ++d) {
+    OMEGA_H_CHECK(mesh1.nglobal_ents(d) == mesh0.nglobal_ents(d));
+  }
+  OMEGA_H_CHECK(are_close(owned_measure(&mesh1), 1.0));
+}
+
+/* a box generated one block per rank must match the one built in serial.
+   the ranks must form a grid of blocks that fits the box */
+static void test_distributed_box(CommPtr comm) {
+  OMEGA_H_CHECK(can_build_box_distributed(12, 5, 4, 3));
+  OMEGA_H_CHECK(can_build_box_distributed(6, 5, 4, 0));
+  OMEGA_H_CHECK(!can_build_box_distributed(7, 5, 4, 3));
+  OMEGA_H_CHECK(!can_build_box_distributed(3, 2, 1, 0));
+  for (Int dim = 2; dim <= 3; ++dim) {
+    auto nz = (dim == 3) ? 3 : 0;
+    if (!can_build_box_distributed(comm->size(), 5, 4, nz)) continue;
+    for (auto family : {OMEGA_H_SIMPLEX, OMEGA_H_HYPERCUBE}) {
+      for (auto hilbert_order : {false, true}) {
+        auto mesh0 =
+            build_box(comm->library()->self(), family, 1., 1., 1., 5, 4, nz);
+        auto mesh1 =
+            build_box_distributed(comm, family, 1., 1., 1., 5, 4, nz, hilbert_order);
+        OMEGA_H_CHECK(mesh1.parting() == OMEGA_H_ELEM_BASED);
+        for (Int d = 0; d <= dim; ++d) {
+          OMEGA_H_CHECK(mesh1.nglobal_ents(d) == mesh0.nents(d));
+          auto globals = mesh1.globals(d);
+          OMEGA_H_CHECK(mesh1.sync_array(d, globals, 1) == globals);
+          auto owned_globals = mesh1.owned_array(d, globals, 1);
+          auto n = mesh1.nglobal_ents(d);
+          OMEGA_H_CHECK(comm->allreduce(get_sum(owned_globals), OMEGA_H_SUM) ==
+                        n * (n - 1) / 2);
+        }
+        OMEGA_H_CHECK(mesh1.sync_array(VERT, mesh1.coords(), dim) ==
+                      mesh1.coords());
+        auto corners = each_eq_to(mesh1.get_array<Byte>(VERT, "class_dim"), Byte(0));
+        OMEGA_H_CHECK(
+            comm->allreduce(get_sum(mesh1.owned_array(VERT, corners, 1)),
+                OMEGA_H_SUM) == (1 << dim));
+        if (family == OMEGA_H_SIMPLEX) {
+          OMEGA_H_CHECK(are_close(owned_measure(&mesh1), 1.0));
+          mesh1.set_parting(OMEGA_H_GHOSTED);
+          OMEGA_H_CHECK(are_close(owned_measure(&mesh1), 1.0));
+        }
+      }
+    }
+  }
+}
+
 int main(int argc, char** argv) {
   auto lib = Library(&argc, &argv);
   auto world = lib.world();
@@ -425,4 +770,14 @@ int main(int argc, char** argv) {
   }
   world->barrier();
   test_rib(world);
+  test_graph_cache(world);
+  test_allgatherv(world);
+  test_push_tags(world);
+  test_repro_get_sum(world);
+  if (world->size() > 1) test_incremental_balance(world);
+  test_drop_ghosts(world);
+  test_shared_file(&lib, world);
+  test_restart_more_ranks(&lib, world);
+  test_refine_without_ghosts(world);
+  test_distributed_box(world);
 }
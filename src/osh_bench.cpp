@@ -0,0 +1,447 @@
+#include <Omega_h_adapt.hpp>
+#include <Omega_h_array_ops.hpp>
+#include <Omega_h_build.hpp>
+#include <Omega_h_cmdline.hpp>
+#include <Omega_h_coarsen.hpp>
+#include <Omega_h_file.hpp>
+#include <Omega_h_for.hpp>
+#include <Omega_h_metric.hpp>
+#include <Omega_h_quality.hpp>
+#include <Omega_h_refine.hpp>
+#include <Omega_h_sort.hpp>
+#include <Omega_h_swap.hpp>
+#include <Omega_h_timer.hpp>
+#include <Omega_h_vtk.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <vector>
+
+/* times reproducible workloads on a box of nx^3 cells split into tets,
+   so that results from different builds or versions can be compared.
+   each case is run a few times after some untimed warmup runs, and each
+   sample is the time of the slowest rank. results are written as JSON,
+   and with -b they are compared against such a file from an earlier run,
+   failing if any case got slower by more than the tolerance and
+   by more than twice the spread of the samples.
+   a baseline of a different box size or rank count is refused. */
+
+using namespace Omega_h;
+
+namespace {
+
+struct Summary {
+  Real min;
+  Real median;
+  Real mean;
+  Real max;
+  Real stddev;
+};
+
+struct Case {
+  std::string name;
+  std::vector<Real> samples;
+  Summary summary;
+};
+
+/* what write_json() recorded about a run */
+struct Baseline {
+  LO nx;
+  I32 nranks;
+  Int nwarmups;
+  Int nreps;
+  std::map<std::string, Summary> cases;
+};
+
+struct Bench {
+  CommPtr comm;
+  Int nwarmups;
+  Int nreps;
+  std::string filter;
+  std::vector<Case> cases;
+};
+
+}  // end anonymous namespace
+
+static Summary summarize(std::vector<Real> samples) {
+  Summary s;
+  std::sort(samples.begin(), samples.end());
+  auto const n = samples.size();
+  s.min = samples.front();
+  s.max = samples.back();
+  s.median = (n % 2) ? samples[n / 2]
+                     : (samples[n / 2 - 1] + samples[n / 2]) / 2.0;
+  Real sum = 0.0;
+  for (auto x : samples) sum += x;
+  s.mean = sum / Real(n);
+  Real sq = 0.0;
+  for (auto x : samples) sq += square(x - s.mean);
+  s.stddev = (n > 1) ? std::sqrt(sq / Real(n - 1)) : 0.0;
+  return s;
+}
+
+/* calls (setup) untimed and then times (run), (nwarmups + nreps) times */
+static void time_case(Bench* bench, std::string const& name,
+    std::function<void()> const& setup, std::function<void()> const& run) {
+  if (name.find(bench->filter) == std::string::npos) return;
+  Case c;
+  c.name = name;
+  for (Int rep = 0; rep < bench->nwarmups + bench->nreps; ++rep) {
+    setup();
+    bench->comm->barrier();
+    auto const t0 = now();
+    run();
+    auto const t = bench->comm->allreduce(now() - t0, OMEGA_H_MAX);
+    if (rep >= bench->nwarmups) c.samples.push_back(t);
+  }
+  c.summary = summarize(c.samples);
+  if (bench->comm->rank() == 0) {
+    std::cout << std::left << std::setw(24) << name << std::right
+              << std::scientific << std::setprecision(3)
+              << " median " << c.summary.median << " s, min "
+              << c.summary.min << " s, max " << c.summary.max
+              << " s, stddev " << c.summary.stddev << " s\n";
+  }
+  bench->cases.push_back(c);
+}
+
+static void set_uniform_metric(Mesh* mesh, Real h) {
+  mesh->add_tag(VERT, "metric", 1,
+      Reals(mesh->nverts(), metric_eigenvalue_from_length(h)));
+}
+
+static void run_cases(Bench* bench, Library* lib, LO nx,
+    filesystem::path const& dir) {
+  auto const comm = bench->comm;
+  auto const family = OMEGA_H_SIMPLEX;
+  Mesh mesh(lib);
+  time_case(
+      bench, "build_box", []() {},
+      [&]() { mesh = build_box(comm, family, 1, 1, 1, nx, nx, nx); });
+  time_case(
+      bench, "build_box_distributed", []() {},
+      [&]() { mesh = build_box_distributed(comm, family, 1, 1, 1, nx, nx, nx); });
+  auto const h = 1.0 / Real(nx);
+  auto base = build_box(comm, family, 1, 1, 1, nx, nx, nx);
+  set_uniform_metric(&base, h);
+  auto const dim = base.dim();
+  Mesh work(lib);
+  /* a zero budget drops every derived adjacency the copy shares,
+     so each run derives from scratch */
+  auto fresh_adjs = [&]() {
+    work = base;
+    work.set_adj_budget(0);
+  };
+  time_case(bench, "ask_up", fresh_adjs, [&]() { work.ask_up(VERT, dim); });
+  time_case(
+      bench, "ask_down", fresh_adjs, [&]() { work.ask_down(dim, VERT); });
+  auto const nkeys = base.nelems();
+  Write<LO> keys_w(nkeys);
+  auto scramble = OMEGA_H_LAMBDA(LO i) {
+    keys_w[i] = LO((I64(i) * 2654435761LL) % I64(nkeys));
+  };
+  parallel_for(nkeys, scramble, "osh_bench(keys)");
+  LOs const keys(keys_w);
+  time_case(
+      bench, "sort_by_keys", []() {}, [&]() { sort_by_keys(keys); });
+  auto ghosted = base;
+  ghosted.set_parting(OMEGA_H_GHOSTED);
+  auto const owners2copies = ghosted.ask_dist(VERT).invert();
+  auto const owned_coords = ghosted.coords();
+  time_case(
+      bench, "dist_exch", []() {},
+      [&]() { owners2copies.exch(owned_coords, dim); });
+  time_case(
+      bench, "measure_qualities", [&]() { work = base; },
+      [&]() { measure_qualities(&work); });
+  auto opts = AdaptOpts(dim);
+  opts.verbosity = SILENT;
+  time_case(
+      bench, "refine_by_size",
+      [&]() {
+        work = base;
+        set_uniform_metric(&work, h / 2.0);
+      },
+      [&]() {
+        while (refine_by_size(&work, opts))
+          ;
+      });
+  time_case(
+      bench, "coarsen_by_size",
+      [&]() {
+        work = base;
+        set_uniform_metric(&work, h * 2.0);
+      },
+      [&]() {
+        while (coarsen_by_size(&work, opts))
+          ;
+      });
+  /* the box is of uniform quality, so asking for better elements
+     than it has makes every edge a swap candidate */
+  auto swap_opts = opts;
+  swap_opts.min_quality_desired = 0.9;
+  time_case(
+      bench, "swap_edges", [&]() { work = base; },
+      [&]() { swap_edges(&work, swap_opts); });
+  if (comm->size() > 1) {
+    time_case(
+        bench, "balance", [&]() { work = base; },
+        [&]() { work.balance(); });
+  }
+  if (comm->rank() == 0) filesystem::create_directory(dir);
+  comm->barrier();
+  auto const osh_path = dir / "bench.osh";
+  time_case(
+      bench, "write_osh", [&]() { work = base; },
+      [&]() { binary::write(osh_path, &work); });
+  time_case(
+      bench, "read_osh", []() {},
+      [&]() { work = binary::read(osh_path, comm); });
+  auto const vtk_path = dir / "bench_vtk";
+  time_case(
+      bench, "write_vtu", [&]() { work = base; },
+      [&]() { vtk::write_parallel(vtk_path.string(), &work); });
+  time_case(
+      bench, "read_vtu", [&]() { work = Mesh(lib); },
+      [&]() { vtk::read_parallel(vtk::get_pvtu_path(vtk_path), comm, &work); });
+  comm->barrier();
+  if (comm->rank() == 0) filesystem::remove_all(dir);
+}
+
+static void write_json(std::ostream& stream, Bench const& bench, LO nx,
+    GO nelems) {
+  stream << std::setprecision(9);
+  stream << "{\n";
+  stream << "  \"program\": \"osh_bench\",\n";
+  stream << "  \"version\": \"" << OMEGA_H_SEMVER << "\",\n";
+  stream << "  \"nx\": " << nx << ",\n";
+  stream << "  \"elements\": " << nelems << ",\n";
+  stream << "  \"ranks\": " << bench.comm->size() << ",\n";
+  stream << "  \"warmups\": " << bench.nwarmups << ",\n";
+  stream << "  \"repetitions\": " << bench.nreps << ",\n";
+  stream << "  \"cases\": [\n";
+  for (std::size_t i = 0; i < bench.cases.size(); ++i) {
+    auto const& c = bench.cases[i];
+    stream << "    {\"name\": \"" << c.name << "\""
+           << ", \"min\": " << c.summary.min
+           << ", \"median\": " << c.summary.median
+           << ", \"mean\": " << c.summary.mean
+           << ", \"max\": " << c.summary.max
+           << ", \"stddev\": " << c.summary.stddev << ", \"samples\": [";
+    for (std::size_t j = 0; j < c.samples.size(); ++j) {
+      if (j) stream << ", ";
+      stream << c.samples[j];
+    }
+    stream << "]}" << ((i + 1 < bench.cases.size()) ? "," : "") << '\n';
+  }
+  stream << "  ]\n";
+  stream << "}\n";
+}
+
+/* the text after "(key):" in (object), up to the next delimiter */
+static std::string find_json_value(
+    std::string const& object, std::string const& key) {
+  auto const quoted_key = "\"" + key + "\"";
+  auto pos = object.find(quoted_key);
+  if (pos == std::string::npos) {
+    Omega_h_fail("osh_bench: baseline case has no \"%s\"\n", key.c_str());
+  }
+  pos = object.find(':', pos + quoted_key.size()) + 1;
+  while (object[pos] == ' ') ++pos;
+  if (object[pos] == '"') {
+    auto const end = object.find('"', pos + 1);
+    return object.substr(pos + 1, end - pos - 1);
+  }
+  auto const end = object.find_first_of(",}] \n", pos);
+  return object.substr(pos, end - pos);
+}
+
+/* reads back a file written by write_json().
+   this only understands that layout, not JSON in general */
+static Baseline read_baseline(filesystem::path const& path) {
+  std::ifstream file(path.c_str());
+  if (!file.is_open()) {
+    Omega_h_fail("osh_bench: couldn't open \"%s\"\n", path.c_str());
+  }
+  std::stringstream buffer;
+  buffer << file.rdbuf();
+  auto const text = buffer.str();
+  auto pos = text.find("\"cases\"");
+  if (pos == std::string::npos) {
+    Omega_h_fail("osh_bench: \"%s\" has no cases\n", path.c_str());
+  }
+  auto const header = text.substr(0, pos);
+  Baseline baseline;
+  baseline.nx = LO(std::stol(find_json_value(header, "nx")));
+  baseline.nranks = I32(std::stoi(find_json_value(header, "ranks")));
+  baseline.nwarmups = Int(std::stoi(find_json_value(header, "warmups")));
+  baseline.nreps = Int(std::stoi(find_json_value(header, "repetitions")));
+  while ((pos = text.find('{', pos)) != std::string::npos) {
+    auto const end = text.find('}', pos);
+    auto const object = text.substr(pos, end - pos + 1);
+    Summary s;
+    s.min = std::stod(find_json_value(object, "min"));
+    s.median = std::stod(find_json_value(object, "median"));
+    s.mean = std::stod(find_json_value(object, "mean"));
+    s.max = std::stod(find_json_value(object, "max"));
+    s.stddev = std::stod(find_json_value(object, "stddev"));
+    baseline.cases[find_json_value(object, "name")] = s;
+    pos = end;
+  }
+  return baseline;
+}
+
+/* a baseline of a different box or rank count timed a different
+   workload, so comparing with it is refused. different warmup or
+   repetition counts only change the statistics, which is warned about */
+static bool check_baseline(Bench const& bench, Baseline const& baseline,
+    LO nx, std::string const& path) {
+  bool ok = true;
+  if (baseline.nx != nx) {
+    std::cout << "osh_bench: baseline " << path << " timed a "
+              << baseline.nx << "^3 box, this run a " << nx << "^3 box\n";
+    ok = false;
+  }
+  if (baseline.nranks != bench.comm->size()) {
+    std::cout << "osh_bench: baseline " << path << " ran on "
+              << baseline.nranks << " ranks, this run on "
+              << bench.comm->size() << '\n';
+    ok = false;
+  }
+  if (!ok) {
+    std::cout << "osh_bench: refusing to compare different workloads\n";
+    return false;
+  }
+  if (baseline.nwarmups != bench.nwarmups || baseline.nreps != bench.nreps) {
+    std::cout << "WARNING: osh_bench: baseline " << path << " used "
+              << baseline.nwarmups << " warmups and " << baseline.nreps
+              << " runs, this run " << bench.nwarmups << " and "
+              << bench.nreps << ", so their spreads are not comparable\n";
+  }
+  return true;
+}
+
+/* returns the number of cases that got slower */
+static Int compare(
+    Bench const& bench, Baseline const& baseline, Real tolerance) {
+  Int nslower = 0;
+  std::cout << "\ncomparison with baseline (tolerance "
+            << std::defaultfloat << tolerance * 100.0 << "%):\n";
+  for (auto const& c : bench.cases) {
+    std::cout << std::left << std::setw(24) << c.name << std::right;
+    auto const it = baseline.cases.find(c.name);
+    if (it == baseline.cases.end()) {
+      std::cout << " new\n";
+      continue;
+    }
+    auto const& old = it->second;
+    auto const change = (c.summary.median - old.median) / old.median;
+    auto const noise = 2.0 * std::max(old.stddev, c.summary.stddev);
+    auto const diff = c.summary.median - old.median;
+    char const* verdict = "same";
+    if (change > tolerance && diff > noise) {
+      verdict = "SLOWER";
+      ++nslower;
+    } else if (change < -tolerance && -diff > noise) {
+      verdict = "faster";
+    }
+    std::cout << std::scientific << std::setprecision(3) << " baseline "
+              << old.median << " s, now " << c.summary.median << " s, "
+              << std::showpos << std::fixed << std::setprecision(1)
+              << change * 100.0 << std::noshowpos << "% " << verdict << '\n';
+  }
+  for (auto const& old : baseline.cases) {
+    auto const found = std::any_of(bench.cases.begin(), bench.cases.end(),
+        [&](Case const& c) { return c.name == old.first; });
+    if (!found && old.first.find(bench.filter) != std::string::npos) {
+      std::cout << std::left << std::setw(24) << old.first << std::right
+                << " missing\n";
+    }
+  }
+  return nslower;
+}
+
+int main(int argc, char** argv) {
+  auto lib = Library(&argc, &argv);
+  auto world = lib.world();
+  CmdLine cmdline;
+  auto& nx_flag = cmdline.add_flag("-n", "cells along each box edge");
+  nx_flag.add_arg<int>("nx");
+  auto& reps_flag = cmdline.add_flag("-r", "timed runs of each case");
+  reps_flag.add_arg<int>("nreps");
+  auto& warmups_flag =
+      cmdline.add_flag("-w", "untimed runs of each case before those");
+  warmups_flag.add_arg<int>("nwarmups");
+  auto& case_flag =
+      cmdline.add_flag("-c", "only run cases whose names contain this");
+  case_flag.add_arg<std::string>("name");
+  auto& out_flag = cmdline.add_flag("-o", "write results to this JSON file");
+  out_flag.add_arg<std::string>("out.json");
+  auto& baseline_flag =
+      cmdline.add_flag("-b", "compare against results of an earlier run");
+  baseline_flag.add_arg<std::string>("baseline.json");
+  auto& tolerance_flag = cmdline.add_flag(
+      "-t", "percent a case may slow down before failing (default 10)");
+  tolerance_flag.add_arg<double>("percent");
+  auto& dir_flag =
+      cmdline.add_flag("-d", "scratch directory for the I/O cases");
+  dir_flag.add_arg<std::string>("path");
+  if (!cmdline.parse_final(world, &argc, argv)) return -1;
+  LO nx = 16;
+  if (cmdline.parsed("-n")) nx = cmdline.get<int>("-n", "nx");
+  Bench bench;
+  bench.comm = world;
+  bench.nreps = 5;
+  if (cmdline.parsed("-r")) bench.nreps = cmdline.get<int>("-r", "nreps");
+  bench.nwarmups = 1;
+  if (cmdline.parsed("-w")) {
+    bench.nwarmups = cmdline.get<int>("-w", "nwarmups");
+  }
+  OMEGA_H_CHECK(bench.nreps >= 1);
+  OMEGA_H_CHECK(bench.nwarmups >= 0);
+  if (cmdline.parsed("-c")) {
+    bench.filter = cmdline.get<std::string>("-c", "name");
+  }
+  Real tolerance = 0.1;
+  if (cmdline.parsed("-t")) {
+    tolerance = cmdline.get<double>("-t", "percent") / 100.0;
+  }
+  filesystem::path dir = "osh_bench_files";
+  if (cmdline.parsed("-d")) dir = cmdline.get<std::string>("-d", "path");
+  auto const report = (world->rank() == 0);
+  if (report) {
+    std::cout << "osh_bench " << OMEGA_H_SEMVER << ", " << nx << "^3 box, "
+              << world->size() << " ranks, " << bench.nreps << " runs after "
+              << bench.nwarmups << " warmups\n";
+  }
+  /* the baseline is checked before anything is timed */
+  Baseline baseline;
+  Int baseline_ok = 1;
+  if (report && cmdline.parsed("-b")) {
+    auto const path = cmdline.get<std::string>("-b", "baseline.json");
+    baseline = read_baseline(path);
+    baseline_ok = check_baseline(bench, baseline, nx, path);
+  }
+  world->bcast(baseline_ok);
+  if (!baseline_ok) return 2;
+  run_cases(&bench, &lib, nx, dir);
+  GO const nelems = GO(6) * nx * nx * nx;
+  if (report && cmdline.parsed("-o")) {
+    auto const path = cmdline.get<std::string>("-o", "out.json");
+    std::ofstream file(path.c_str());
+    OMEGA_H_CHECK(file.is_open());
+    write_json(file, bench, nx, nelems);
+  }
+  Int nslower = 0;
+  if (report && cmdline.parsed("-b")) {
+    nslower = compare(bench, baseline, tolerance);
+  }
+  world->bcast(nslower);
+  return nslower ? 1 : 0;
+}
@@ -0,0 +1,53 @@
+#include <Omega_h_array_ops.hpp>
+#include <Omega_h_build.hpp>
+#include <Omega_h_cmdline.hpp>
+#include <Omega_h_mesh.hpp>
+#include <Omega_h_shape.hpp>
+#include <Omega_h_timer.hpp>
+#include <iostream>
+
+using namespace Omega_h;
+
+/* times the sums that reproducible reductions change,
+   which are global sums of element sizes */
+static void run_sums(Mesh* mesh, Int niters, bool report) {
+  auto const sizes = measure_elements_real(mesh);
+  Real total = 0.0;
+  auto const t0 = now();
+  for (Int iter = 0; iter < niters; ++iter) {
+    total += get_sum(mesh->comm(), sizes);
+  }
+  auto const t1 = now();
+  if (report && mesh->comm()->rank() == 0) {
+    std::cout << (repro_reductions_enabled() ? "reproducible: " : "fast:         ")
+              << "get_sum " << (t1 - t0) << " s (total " << (total / niters)
+              << ")\n";
+  }
+}
+
+int main(int argc, char** argv) {
+  auto lib = Library(&argc, &argv);
+  auto world = lib.world();
+  CmdLine cmdline;
+  auto& nx_flag = cmdline.add_flag("-n", "elements along each box edge");
+  nx_flag.add_arg<int>("nx");
+  auto& iters_flag = cmdline.add_flag("-i", "number of repetitions");
+  iters_flag.add_arg<int>("niters");
+  if (!cmdline.parse_final(world, &argc, argv)) return -1;
+  LO nx = 32;
+  if (cmdline.parsed("-n")) nx = cmdline.get<int>("-n", "nx");
+  Int niters = 10;
+  if (cmdline.parsed("-i")) niters = cmdline.get<int>("-i", "niters");
+  auto mesh = build_box(world, OMEGA_H_SIMPLEX, 1, 1, 1, nx, nx, nx);
+  mesh.set_parting(OMEGA_H_GHOSTED);
+  /* as in arena_bench, each variant is run twice and
+     only the second run is reported */
+  auto const was_enabled = repro_reductions_enabled();
+  disable_repro_reductions();
+  run_sums(&mesh, niters, false);
+  run_sums(&mesh, niters, true);
+  enable_repro_reductions();
+  run_sums(&mesh, niters, false);
+  run_sums(&mesh, niters, true);
+  if (!was_enabled) disable_repro_reductions();
+}
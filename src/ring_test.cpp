@@ -13,7 +13,7 @@ int main(int argc, char** argv) {
   OMEGA_H_CHECK(argc == 2);
   auto world = lib.world();
   auto mesh = gmsh::read(argv[1], world);
-  auto ids = std::vector<LO>({6, 7, 8, 9});
+  auto ids = std::vector<ClassId>({6, 7, 8, 9});
   auto verts_are_bdry = mark_class_closures(&mesh, VERT, 1, ids);
   auto bv2v = collect_marked(verts_are_bdry);
   auto initial_w = Write<Real>(mesh.nverts(), 0.0);
@@ -0,0 +1,139 @@
+#include <Omega_h_adapt.hpp>
+#include <Omega_h_array_ops.hpp>
+#include <Omega_h_build.hpp>
+#include <Omega_h_cmdline.hpp>
+#include <Omega_h_for.hpp>
+#include <Omega_h_metric.hpp>
+#include <Omega_h_timer.hpp>
+#include <iostream>
+
+#if defined(OMEGA_H_USE_OPENMP)
+#include <omp.h>
+#elif defined(OMEGA_H_USE_THREADS)
+#include <Omega_h_threads.hpp>
+#endif
+
+using namespace Omega_h;
+
+/* the backends are chosen at configure time, so comparing them means
+   running this program from an Omega_h_USE_OpenMP build and from an
+   Omega_h_USE_THREADS build with the same number of threads
+   (OMP_NUM_THREADS or --osh-threads) */
+static void print_backend() {
+#if defined(OMEGA_H_USE_OPENMP)
+  std::cout << "backend: OpenMP, " << omp_get_max_threads() << " threads\n";
+#elif defined(OMEGA_H_USE_THREADS)
+  std::cout << "backend: work-stealing pool, " << threads::num_threads()
+            << " threads\n";
+#else
+  std::cout << "backend: serial\n";
+#endif
+}
+
+static void print_pool_stats() {
+#if defined(OMEGA_H_USE_THREADS)
+  auto const stats = threads::get_stats();
+  std::cout << "  " << stats.nruns << " parallel loops, " << stats.nserial_runs
+            << " short loops run serially, " << stats.nchunks << " chunks, "
+            << stats.nsteals << " steals\n";
+  threads::reset_stats();
+#endif
+}
+
+/* alternately refines and coarsens a box, as arena_bench does */
+static Real run_cycles(Library* lib, LO nx, Int ncycles) {
+  auto mesh = build_box(lib->world(), OMEGA_H_SIMPLEX, 1, 1, 1, nx, nx, nx);
+  mesh.set_parting(OMEGA_H_GHOSTED);
+  add_implied_isos_tag(&mesh);
+  auto opts = AdaptOpts(&mesh);
+  opts.verbosity = SILENT;
+  auto const t0 = now();
+  for (Int cycle = 0; cycle < ncycles; ++cycle) {
+    auto const h = ((cycle % 2 == 0) ? 0.5 : 1.0) / Real(nx);
+    auto const target = Reals(mesh.nverts(), 1.0 / (h * h));
+    mesh.add_tag(VERT, "target_metric", 1, target);
+    add_implied_isos_tag(&mesh);
+    while (approach_metric(&mesh, opts) && adapt(&mesh, opts))
+      ;
+  }
+  return now() - t0;
+}
+
+/* twists the middle of a box back and forth, as warp_test does.
+   the swaps and collapses this needs are spread very unevenly
+   over the mesh */
+static Real run_warp(Library* lib, LO nx, Int nsteps) {
+  constexpr Int dim = 3;
+  auto mesh = build_box(lib->world(), OMEGA_H_SIMPLEX, 1, 1, 1, nx, nx, nx);
+  mesh.set_parting(OMEGA_H_GHOSTED);
+  mesh.add_tag(VERT, "metric", 1, get_implied_isos(&mesh));
+  auto opts = AdaptOpts(&mesh);
+  opts.verbosity = SILENT;
+  auto mid = zero_vector<dim>();
+  mid[0] = mid[1] = .5;
+  auto const t0 = now();
+  for (Int step = 0; step < nsteps; ++step) {
+    auto coords = mesh.coords();
+    Write<Real> warp_w(mesh.nverts() * dim);
+    auto const sense = (step < nsteps / 2) ? 1.0 : -1.0;
+    auto warp_fun = OMEGA_H_LAMBDA(LO vert) {
+      auto x0 = get_vector<3>(coords, vert);
+      auto x1 = zero_vector<3>();
+      x1[0] = x0[0];
+      x1[1] = x0[1];
+      auto x2 = x1 - mid;
+      auto polar_a = std::atan2(x2[1], x2[0]);
+      auto polar_r = norm(x2);
+      Real rot_a = 0;
+      if (polar_r < 0.5) rot_a = sense * (PI / 8) * (2.0 * (0.5 - polar_r));
+      auto dest_a = polar_a + rot_a;
+      auto dst = x0;
+      dst[0] = std::cos(dest_a) * polar_r;
+      dst[1] = std::sin(dest_a) * polar_r;
+      dst = dst + mid;
+      set_vector<3>(warp_w, vert, dst - x0);
+    };
+    parallel_for(mesh.nverts(), warp_fun);
+    mesh.add_tag(VERT, "warp", dim, Reals(warp_w));
+    while (warp_to_limit(&mesh, opts)) adapt(&mesh, opts);
+  }
+  return now() - t0;
+}
+
+int main(int argc, char** argv) {
+  auto lib = Library(&argc, &argv);
+  auto world = lib.world();
+  CmdLine cmdline;
+  auto& nx_flag = cmdline.add_flag("-n", "elements along each box edge");
+  nx_flag.add_arg<int>("nx");
+  auto& cycles_flag =
+      cmdline.add_flag("-c", "number of refine/coarsen cycles");
+  cycles_flag.add_arg<int>("ncycles");
+  auto& steps_flag = cmdline.add_flag("-w", "number of warp steps");
+  steps_flag.add_arg<int>("nsteps");
+  if (!cmdline.parse_final(world, &argc, argv)) return -1;
+  LO nx = 10;
+  if (cmdline.parsed("-n")) nx = cmdline.get<int>("-n", "nx");
+  Int ncycles = 4;
+  if (cmdline.parsed("-c")) ncycles = cmdline.get<int>("-c", "ncycles");
+  Int nsteps = 8;
+  if (cmdline.parsed("-w")) nsteps = cmdline.get<int>("-w", "nsteps");
+  auto const report = (world->rank() == 0);
+  if (report) print_backend();
+  /* as in arena_bench, each case is run twice and
+     only the second run is reported */
+  run_cycles(&lib, nx, ncycles);
+  if (report) print_pool_stats();
+  auto const cycles_time = run_cycles(&lib, nx, ncycles);
+  if (report) {
+    std::cout << "refine/coarsen cycles: " << cycles_time << " seconds\n";
+    print_pool_stats();
+  }
+  run_warp(&lib, nx, nsteps);
+  if (report) print_pool_stats();
+  auto const warp_time = run_warp(&lib, nx, nsteps);
+  if (report) {
+    std::cout << "warp: " << warp_time << " seconds\n";
+    print_pool_stats();
+  }
+}
@@ -1,5 +1,6 @@
 #include "Omega_h_adj.hpp"
 #include "Omega_h_align.hpp"
+#include "Omega_h_arena.hpp"
 #include "Omega_h_array_ops.hpp"
 #include "Omega_h_expr.hpp"
 #include "Omega_h_for.hpp"
@@ -8,8 +9,13 @@
 #include "Omega_h_linpart.hpp"
 #include "Omega_h_map.hpp"
 #include "Omega_h_mark.hpp"
+#include "Omega_h_pool.hpp"
+#include "Omega_h_profile.hpp"
 #include "Omega_h_sort.hpp"
 
+#include <cstdlib>
+#include <thread>
+
 using namespace Omega_h;
 
 static void test_write() {
@@ -33,6 +39,19 @@ static void test_repro_sum() {
   OMEGA_H_CHECK(sum == std::exp2(20) + std::exp2(int(-20)));
 }
 
+static void test_repro_reductions() {
+  /* the same values in two orders, which round differently
+     when summed left to right */
+  Reals a({1.0, 1.0, 1e-16, 1e-16, 1e-16, 1e-16, 1e-16, 1e-16});
+  Reals b({1e-16, 1e-16, 1e-16, 1e-16, 1e-16, 1e-16, 1.0, 1.0});
+  enable_repro_reductions();
+  OMEGA_H_CHECK(get_sum(a) == repro_sum(a));
+  OMEGA_H_CHECK(get_sum(a) == get_sum(b));
+  OMEGA_H_CHECK(get_sum(LOs({1, 2, 3})) == 6);
+  disable_repro_reductions();
+  OMEGA_H_CHECK(!repro_reductions_enabled());
+}
+
 static void test_sort() {
   {
     LOs a({0, 1});
@@ -83,6 +102,45 @@ static void test_scan() {
   }
 }
 
+/* loops long enough for the threaded backends to split,
+   with iterations of very different cost */
+static void test_long_loops() {
+  LO const n = 100 * 1000;
+  Write<LO> visits(n, 0);
+  Write<Real> values(n);
+  auto f = OMEGA_H_LAMBDA(LO i) {
+    ++visits[i];
+    Real value = 0.0;
+    auto const nterms = (i % 1000 == 0) ? 10000 : 1;
+    for (LO j = 0; j < nterms; ++j) value += 1.0 / nterms;
+    values[i] = value;
+  };
+  parallel_for(n, f);
+  OMEGA_H_CHECK(LOs(visits) == LOs(n, 1));
+  OMEGA_H_CHECK(are_close(Reals(values), Reals(n, 1.0)));
+  OMEGA_H_CHECK(get_sum(LOs(visits)) == n);
+  OMEGA_H_CHECK(get_max(LOs(n, 0, 1)) == n - 1);
+  OMEGA_H_CHECK(offset_scan(LOs(n, 1)) == LOs(n + 1, 0, 1));
+  Write<LO> holes(n, -1);
+  holes.set(7, 7);
+  holes.set(n / 2, n / 2);
+  fill_right(holes);
+  OMEGA_H_CHECK(holes.get(n / 2 - 1) == 7);
+  OMEGA_H_CHECK(holes.get(n - 1) == n / 2);
+  /* sorting equal keys must keep their order */
+  Write<LO> keys(n);
+  parallel_for(n, OMEGA_H_LAMBDA(LO i) { keys[i] = (n - i) % 10; });
+  auto const perm = sort_by_keys(LOs(keys));
+  auto const h_perm = HostRead<LO>(perm);
+  for (LO i = 1; i < n; ++i) {
+    auto const a = h_perm[i - 1];
+    auto const b = h_perm[i];
+    auto const ka = (n - a) % 10;
+    auto const kb = (n - b) % 10;
+    OMEGA_H_CHECK(ka < kb || (ka == kb && a < b));
+  }
+}
+
 static void test_fan_and_funnel() {
   OMEGA_H_CHECK(invert_funnel(LOs({0, 0, 1, 1, 2, 2}), 3) == LOs({0, 2, 4, 6}));
   OMEGA_H_CHECK(invert_fan(LOs({0, 2, 4, 6})) == LOs({0, 0, 1, 1, 2, 2}));
@@ -134,6 +192,30 @@ static void test_invert_map() {
     OMEGA_H_CHECK(l2hl.a2ab == LOs({0, 2, 4}));
     OMEGA_H_CHECK(l2hl.ab2b == LOs({1, 3, 0, 2}));
   }
+  {
+    LOs hl2l({}, "hl2l");
+    auto l2hl = invert_map_by_blocks(hl2l, 4);
+    OMEGA_H_CHECK(l2hl.a2ab == LOs(5, 0));
+    OMEGA_H_CHECK(l2hl.ab2b == LOs({}));
+  }
+  {
+    LOs hl2l({1, 0, 1, 0}, "hl2l");
+    auto l2hl = invert_map_by_blocks(hl2l, 2);
+    OMEGA_H_CHECK(l2hl.a2ab == LOs({0, 2, 4}));
+    OMEGA_H_CHECK(l2hl.ab2b == LOs({1, 3, 0, 2}));
+  }
+  {
+    /* enough entries for several ranges and blocks */
+    LO const na = 100 * 1000;
+    LO const nb = 20 * 1000;
+    Write<LO> a2b(na);
+    auto f = OMEGA_H_LAMBDA(LO a) { a2b[a] = LO((I64(a) * 7919) % nb); };
+    parallel_for(na, f);
+    auto by_blocks = invert_map_by_blocks(a2b, nb);
+    auto by_sorting = invert_map_by_sorting(a2b, nb);
+    OMEGA_H_CHECK(by_blocks.a2ab == by_sorting.a2ab);
+    OMEGA_H_CHECK(by_blocks.ab2b == by_sorting.ab2b);
+  }
 }
 
 static void test_invert_adj() {
@@ -186,7 +268,7 @@ static void test_linpart() {
   Read<GO> globals({6, 5, 4, 3, 2, 1, 0});
   auto remotes = globals_to_linear_owners(globals, total, comm_size);
   OMEGA_H_CHECK(remotes.ranks == Read<I32>({1, 1, 1, 0, 0, 0, 0}));
-  OMEGA_H_CHECK(remotes.idxs == Read<I32>({2, 1, 0, 3, 2, 1, 0}));
+  OMEGA_H_CHECK(remotes.idxs == LOs({2, 1, 0, 3, 2, 1, 0}));
 }
 
 static void test_expand() {
@@ -198,11 +280,11 @@ static void test_expand() {
 
 static void test_find_last() {
   auto a = LOs({0, 3, 55, 12});
-  OMEGA_H_CHECK(find_last(a, 98) < 0);
-  OMEGA_H_CHECK(find_last(a, 12) == 3);
-  OMEGA_H_CHECK(find_last(a, 55) == 2);
-  OMEGA_H_CHECK(find_last(a, 3) == 1);
-  OMEGA_H_CHECK(find_last(a, 0) == 0);
+  OMEGA_H_CHECK(find_last(a, LO(98)) < 0);
+  OMEGA_H_CHECK(find_last(a, LO(12)) == 3);
+  OMEGA_H_CHECK(find_last(a, LO(55)) == 2);
+  OMEGA_H_CHECK(find_last(a, LO(3)) == 1);
+  OMEGA_H_CHECK(find_last(a, LO(0)) == 0);
 }
 
 static void test_scalar_ptr() {
@@ -309,15 +391,187 @@ static void test_array_from_kokkos() {
 #endif
 }
 
+static void test_adopt_host_memory() {
+  std::vector<Real> values{1.0, 2.0, 3.0};
+  int nreleases = 0;
+  {
+    Reals adopted = adopt_host_memory(
+        values.data(), 3, [&nreleases]() { ++nreleases; }, "adopted");
+    OMEGA_H_CHECK(adopted == Reals({1.0, 2.0, 3.0}));
+#if !defined(OMEGA_H_USE_KOKKOS) && !defined(OMEGA_H_USE_CUDA)
+    OMEGA_H_CHECK(adopted.data() == values.data());
+#endif
+    /* the values are released with the last array using them */
+    auto copy = adopted;
+    adopted = Reals();
+    OMEGA_H_CHECK(copy.size() == 3);
+  }
+  OMEGA_H_CHECK(nreleases == 1);
+}
+
+static void test_pool() {
+  auto pool_malloc = [](std::size_t size) { return std::malloc(size); };
+  auto pool_free = [](void* ptr, std::size_t) { std::free(ptr); };
+  Pool pool(pool_malloc, pool_free, 64 * 1024);
+  auto churn = [&pool]() {
+    for (int i = 0; i < 100; ++i) {
+      void* blocks[40];
+      for (int j = 0; j < 40; ++j) blocks[j] = allocate(pool, 100);
+      for (int j = 0; j < 40; ++j) deallocate(pool, blocks[j], 100);
+    }
+  };
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i) threads.emplace_back(churn);
+  for (auto& thread : threads) thread.join();
+  auto stats = get_stats(pool);
+  OMEGA_H_CHECK(stats.nallocs == 4 * 100 * 40);
+  OMEGA_H_CHECK(stats.bytes_in_use == 0);
+  OMEGA_H_CHECK(stats.max_bytes_in_use >= 40 * 128);
+  OMEGA_H_CHECK(stats.nunderlying_mallocs <= 4 * 40);
+  OMEGA_H_CHECK(stats.nthread_hits + stats.ncentral_hits +
+                    stats.nunderlying_mallocs ==
+                stats.nallocs);
+  /* a big block goes over the high water mark when it is freed */
+  auto big = allocate(pool, 100 * 1024);
+  deallocate(pool, big, 100 * 1024);
+  stats = get_stats(pool);
+  OMEGA_H_CHECK(stats.ntrims == 1);
+  OMEGA_H_CHECK(stats.bytes_cached <= 32 * 1024);
+  trim(pool, 0);
+  stats = get_stats(pool);
+  OMEGA_H_CHECK(stats.bytes_cached == 0);
+  OMEGA_H_CHECK(stats.nunderlying_frees == stats.nunderlying_mallocs);
+}
+
+static void test_profile_memory() {
+  auto const old_history = profile::global_singleton_history;
+  profile::History untracked;
+  profile::global_singleton_history = &untracked;
+  { Write<Real> a(1000, "a"); }
+  OMEGA_H_CHECK(untracked.total_allocs == 0);
+  OMEGA_H_CHECK(untracked.live_bytes == 0);
+  profile::History history;
+  history.track_memory = true;
+  profile::global_singleton_history = &history;
+  begin_code("outer");
+  {
+    Write<Real> a(1000, "a");
+    begin_code("inner");
+    { Write<Real> b(500, "b"); }
+    end_code();
+    begin_code("phase");
+    Write<I8> c(100, "c");
+    end_phase();
+  }
+  /* allocations from other threads are counted against the same frame */
+  begin_code("threads");
+  {
+    Write<Real> d(100, "d");
+    auto churn = []() {
+      for (int i = 0; i < 100; ++i) Write<I8>(10, "e");
+    };
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i) threads.emplace_back(churn);
+    for (auto& thread : threads) thread.join();
+  }
+  end_code();
+  end_code();
+  profile::global_singleton_history = old_history;
+  auto const outer = history.find_child_of(profile::invalid, "outer");
+  auto const inner = history.find_child_of(outer, "inner");
+  auto const phase = history.find_child_of(outer, "phase");
+  auto const threaded = history.find_child_of(outer, "threads");
+  OMEGA_H_CHECK(history.allocs(inner) == 1);
+  OMEGA_H_CHECK(history.peak_bytes(inner) == 1500 * sizeof(Real));
+  OMEGA_H_CHECK(history.allocs(phase) == 1);
+  OMEGA_H_CHECK(history.peak_bytes(phase) == 1000 * sizeof(Real) + 100);
+  OMEGA_H_CHECK(history.allocs(threaded) == 1 + 4 * 100);
+  OMEGA_H_CHECK(history.peak_bytes(threaded) >= 100 * sizeof(Real) + 10);
+  OMEGA_H_CHECK(history.allocs(outer) == 3 + 1 + 4 * 100);
+  OMEGA_H_CHECK(history.peak_bytes(outer) == 1500 * sizeof(Real));
+  OMEGA_H_CHECK(history.live_bytes == 0);
+  OMEGA_H_CHECK(history.phases.size() == 1);
+  OMEGA_H_CHECK(history.phases[0].peak_bytes == 1000 * sizeof(Real) + 100);
+  OMEGA_H_CHECK(history.phases[0].end_bytes == 1000 * sizeof(Real) + 100);
+  OMEGA_H_CHECK(std::string(history.names.get(history.phases[0].name_ptr)) ==
+                "phase");
+}
+
+static void test_arena() {
+  OMEGA_H_CHECK(!arenas_enabled());
+  enable_arenas(64 * 1024);
+  reset_arena_stats();
+  {
+    ScopedArena scope;
+    Write<Real> a(100, "a");
+    Write<Real> b(100, "b");
+    /* too big for the arena */
+    Write<Real> c(4 * 1024, "c");
+  }
+  auto stats = get_arena_stats();
+  OMEGA_H_CHECK(stats.nallocs == 3);
+  OMEGA_H_CHECK(stats.narena_allocs == 2);
+  OMEGA_H_CHECK(stats.nchunk_mallocs == 1);
+  OMEGA_H_CHECK(stats.nchunk_pins == 0);
+  /* a chunk whose arrays all died is reused by the next scope */
+  Write<Real> kept_a;
+  Write<Real> kept_b;
+  {
+    ScopedArena scope;
+    kept_a = Write<Real>(10, "kept_a");
+    kept_b = Write<Real>(10, "kept_b");
+  }
+  stats = get_arena_stats();
+  OMEGA_H_CHECK(stats.nchunk_mallocs == 1);
+  OMEGA_H_CHECK(stats.nchunk_reuses == 1);
+  OMEGA_H_CHECK(stats.nchunk_pins == 1);
+  /* the chunk stays pinned until its last array dies */
+  kept_a = Write<Real>();
+  { ScopedArena scope; Write<Real> d(10, "d"); }
+  stats = get_arena_stats();
+  OMEGA_H_CHECK(stats.nchunk_mallocs == 2);
+  kept_b = Write<Real>();
+  {
+    ScopedArena scope;
+    Write<Real> e(10, "e");
+    Write<Real> f(10, "f");
+  }
+  stats = get_arena_stats();
+  OMEGA_H_CHECK(stats.nchunk_mallocs == 2);
+  OMEGA_H_CHECK(stats.nchunk_reuses == 2);
+  /* threads allocating and freeing at once leave every chunk free */
+  {
+    ScopedArena scope;
+    auto churn = []() {
+      for (int i = 0; i < 1000; ++i) Write<Real>(100, "g");
+    };
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i) threads.emplace_back(churn);
+    for (auto& thread : threads) thread.join();
+  }
+  stats = get_arena_stats();
+  OMEGA_H_CHECK(stats.narena_allocs == 2 + 2 + 1 + 2 + 4 * 1000);
+  auto const nchunks = stats.nchunk_mallocs;
+  {
+    ScopedArena scope;
+    Write<Real> h(10, "h");
+  }
+  stats = get_arena_stats();
+  OMEGA_H_CHECK(stats.nchunk_mallocs == nchunks);
+  disable_arenas();
+}
+
 int main(int argc, char** argv) {
   auto lib = Library(&argc, &argv);
   OMEGA_H_CHECK(std::string(lib.version()) == OMEGA_H_SEMVER);
   test_write();
   test_int128();
   test_repro_sum();
+  test_repro_reductions();
   test_sort();
   test_sort_small_range();
   test_scan();
+  test_long_loops();
   test_fan_and_funnel();
   test_permute();
   test_invert_map();
@@ -332,4 +586,8 @@ int main(int argc, char** argv) {
   test_expr();
   test_expr2();
   test_array_from_kokkos();
+  test_adopt_host_memory();
+  test_pool();
+  test_arena();
+  test_profile_memory();
 }
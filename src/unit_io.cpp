@@ -1,6 +1,8 @@
 #include "Omega_h_array_ops.hpp"
 #include "Omega_h_build.hpp"
 #include "Omega_h_compare.hpp"
+#include "Omega_h_for.hpp"
+#include "Omega_h_shape.hpp"
 #include "Omega_h_vtk.hpp"
 #include "Omega_h_xml_lite.hpp"
 
@@ -949,7 +951,31 @@ static void test_file_components(bool is_compressed, bool needs_swapping) {
   OMEGA_H_CHECK(s == s2);
 }
 
+/* writes local indices as a build with (index_width) byte LOs would */
+template <typename T>
+static void write_indices(
+    std::ostream& stream, std::vector<T> const& indices, bool needs_swapping) {
+  using namespace binary;
+  write_value(stream, T(indices.size()), needs_swapping);
+  for (auto index : indices) write_value(stream, index, needs_swapping);
+}
+
+static void test_index_widths(bool needs_swapping) {
+  using namespace binary;
+  std::stringstream stream;
+  write_indices(stream, std::vector<I32>({3, -1, 0, 7}), needs_swapping);
+  write_indices(stream, std::vector<I64>({3, -1, 0, 7}), needs_swapping);
+  LOs narrow;
+  read_index_array(stream, narrow, false, needs_swapping, 4);
+  OMEGA_H_CHECK(narrow == LOs({3, -1, 0, 7}));
+  LOs wide;
+  read_index_array(stream, wide, false, needs_swapping, 8);
+  OMEGA_H_CHECK(wide == LOs({3, -1, 0, 7}));
+}
+
 static void test_file_components() {
+  test_index_widths(false);
+  test_index_widths(true);
   test_file_components(false, false);
   test_file_components(false, true);
 #ifdef OMEGA_H_USE_ZLIB
@@ -1114,6 +1140,136 @@ static void test_gmsh(Library* lib) {
   }
 }
 
+template <typename T>
+static void append_binary(std::string& out, T value) {
+  out.append(reinterpret_cast<char const*>(&value), sizeof(T));
+}
+
+/* two triangles with sparse node tags, in binary and ASCII 4.1 */
+static std::string gmsh_sparse_square(bool is_binary) {
+  const std::size_t tags[4] = {1000000, 3000000, 2000000, 7};
+  const double coords[4][3] = {{0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {0, 1, 0}};
+  const std::size_t tris[2][3] = {
+      {1000000, 3000000, 2000000}, {1000000, 2000000, 7}};
+  std::ostringstream ascii;
+  std::string out;
+  if (is_binary) {
+    out += "$MeshFormat\n4.1 1 8\n";
+    append_binary(out, int(1));
+    out += "\n$EndMeshFormat\n$Nodes\n";
+    for (std::size_t n : {std::size_t(1), std::size_t(4), std::size_t(7),
+             std::size_t(3000000)}) {
+      append_binary(out, n);
+    }
+    for (int n : {2, 1, 0}) append_binary(out, n);
+    append_binary(out, std::size_t(4));
+    for (auto tag : tags) append_binary(out, tag);
+    for (auto& point : coords) {
+      for (auto x : point) append_binary(out, x);
+    }
+    out += "\n$EndNodes\n$Elements\n";
+    for (std::size_t n : {std::size_t(1), std::size_t(2), std::size_t(1),
+             std::size_t(2)}) {
+      append_binary(out, n);
+    }
+    for (int n : {2, 1, 2}) append_binary(out, n);
+    append_binary(out, std::size_t(2));
+    for (std::size_t i = 0; i < 2; ++i) {
+      append_binary(out, i + 1);
+      for (auto tag : tris[i]) append_binary(out, tag);
+    }
+    out += "\n$EndElements\n";
+    return out;
+  }
+  ascii << "$MeshFormat\n4.1 0 8\n$EndMeshFormat\n$Nodes\n";
+  ascii << "1 4 7 3000000\n2 1 0 4\n";
+  for (auto tag : tags) ascii << tag << '\n';
+  for (auto& point : coords) {
+    ascii << point[0] << ' ' << point[1] << ' ' << point[2] << '\n';
+  }
+  ascii << "$EndNodes\n$Elements\n1 2 1 2\n2 1 2 2\n";
+  for (std::size_t i = 0; i < 2; ++i) {
+    ascii << (i + 1) << ' ' << tris[i][0] << ' ' << tris[i][1] << ' '
+          << tris[i][2] << '\n';
+  }
+  ascii << "$EndElements\n";
+  return ascii.str();
+}
+
+static void test_gmsh_files(Library* lib) {
+  /* files are memory-mapped rather than streamed */
+  const std::vector<const char*> meshes{
+      GMSH_SQUARE_MSH2, GMSH_SQUARE_MSH40, GMSH_SQUARE_MSH41};
+  for (const auto& msh : meshes) {
+    {
+      std::ofstream file("square.msh");
+      file << msh;
+    }
+    auto mesh = Omega_h::gmsh::read("square.msh", lib->world());
+    OMEGA_H_CHECK(mesh.nelems() == 40);
+    OMEGA_H_CHECK(mesh.nedges() == 68);
+    OMEGA_H_CHECK(mesh.nverts() == 29);
+  }
+  Mesh meshes_41[2];
+  for (int is_binary = 0; is_binary < 2; ++is_binary) {
+    std::istringstream stream(gmsh_sparse_square(is_binary));
+    auto& mesh = meshes_41[is_binary];
+    mesh = Omega_h::gmsh::read(stream, lib->world());
+    OMEGA_H_CHECK(mesh.dim() == 2);
+    OMEGA_H_CHECK(mesh.nelems() == 2);
+    OMEGA_H_CHECK(mesh.nverts() == 4);
+    OMEGA_H_CHECK(get_sum(measure_elements_real(&mesh)) == 1.0);
+  }
+  OMEGA_H_CHECK(meshes_41[0].coords() == meshes_41[1].coords());
+  OMEGA_H_CHECK(
+      meshes_41[0].ask_elem_verts() == meshes_41[1].ask_elem_verts());
+}
+
+/* a fingerprint of the classification of owned entities */
+static GO sum_owned_classification(Mesh* mesh, Int dim) {
+  auto owned = mesh->owned(dim);
+  auto class_dim = mesh->get_array<I8>(dim, "class_dim");
+  auto class_id = mesh->get_array<ClassId>(dim, "class_id");
+  Write<GO> keys(mesh->nents(dim));
+  auto f = OMEGA_H_LAMBDA(LO i) {
+    auto key = GO(class_dim[i]) * 1000 + GO(class_id[i]) + 1;
+    keys[i] = owned[i] ? key * key : 0;
+  };
+  parallel_for(keys.size(), f);
+  return get_sum(mesh->comm(), GOs(keys));
+}
+
+static void test_gmsh_sliced(Library* lib) {
+  auto comm = lib->world();
+  const std::vector<std::string> meshes{GMSH_SQUARE_MSH40, GMSH_SQUARE_MSH41,
+      GMSH_PHYSICAL_MSH40, GMSH_PHYSICAL_MSH41, gmsh_sparse_square(false),
+      gmsh_sparse_square(true)};
+  for (const auto& msh : meshes) {
+    if (comm->rank() == 0) {
+      std::ofstream file("sliced.msh", std::ios::binary);
+      file << msh;
+    }
+    comm->barrier();
+    std::istringstream stream(msh);
+    auto serial = Omega_h::gmsh::read(stream, comm);
+    auto sliced = Omega_h::gmsh::read_sliced("sliced.msh", comm);
+    OMEGA_H_CHECK(sliced.dim() == serial.dim());
+    OMEGA_H_CHECK(sliced.family() == serial.family());
+    OMEGA_H_CHECK(sliced.class_sets.size() == serial.class_sets.size());
+    for (Int dim = 0; dim <= serial.dim(); ++dim) {
+      OMEGA_H_CHECK(sliced.nglobal_ents(dim) == serial.nglobal_ents(dim));
+      OMEGA_H_CHECK(sum_owned_classification(&sliced, dim) ==
+                    sum_owned_classification(&serial, dim));
+    }
+    auto measure = [](Mesh* mesh) {
+      auto sizes = measure_elements_real(mesh);
+      return get_sum(mesh->comm(), sizes);
+    };
+    OMEGA_H_CHECK(are_close(measure(&sliced), measure(&serial)));
+    comm->barrier();
+  }
+}
+
 static void test_xml() {
   xml_lite::Tag tag;
   OMEGA_H_CHECK(!xml_lite::parse_tag("AQAAAAAAAADABg", &tag));
@@ -1158,8 +1314,10 @@ int main(int argc, char** argv) {
     test_file(&lib);
     test_xml();
     test_read_vtu(&lib);
+    test_gmsh_files(&lib);
   }
   test_gmsh(&lib);
+  test_gmsh_sliced(&lib);
 #ifdef OMEGA_H_USE_GMSH
   test_gmsh_parallel(&lib);
 #endif  // OMEGA_H_USE_GMSH
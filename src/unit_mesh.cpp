@@ -314,6 +314,39 @@ static void test_dual(Library* lib) {
   OMEGA_H_CHECK(tt2t == LOs({1, 0}));
 }
 
+static void test_adj_cache(Library* lib) {
+  auto mesh = build_box(lib->world(), OMEGA_H_SIMPLEX, 1, 1, 1, 2, 2, 2);
+  /* start from an empty cache whatever build_box asked for */
+  mesh.set_adj_budget(0);
+  mesh.set_adj_budget(~std::size_t(0));
+  auto const s0 = mesh.adj_cache_stats();
+  OMEGA_H_CHECK(s0.bytes == 0);
+  auto v2e = mesh.ask_up(VERT, EDGE);
+  auto e2f = mesh.ask_up(EDGE, FACE);
+  mesh.ask_up(VERT, EDGE);
+  auto stats = mesh.adj_cache_stats();
+  OMEGA_H_CHECK(stats.nmisses == s0.nmisses + 2);
+  OMEGA_H_CHECK(stats.nhits == s0.nhits + 1);
+  OMEGA_H_CHECK(stats.nevictions == s0.nevictions);
+  OMEGA_H_CHECK(stats.bytes > 0);
+  /* the downward adjacencies mesh entities are made of are never dropped */
+  mesh.set_adj_budget(0);
+  stats = mesh.adj_cache_stats();
+  OMEGA_H_CHECK(stats.nevictions == s0.nevictions + 2);
+  OMEGA_H_CHECK(stats.bytes == 0);
+  OMEGA_H_CHECK(mesh.has_adj(REGION, FACE));
+  OMEGA_H_CHECK(!mesh.has_adj(VERT, EDGE));
+  /* the one just derived is kept until another one is */
+  OMEGA_H_CHECK(mesh.ask_up(VERT, EDGE).ab2b == v2e.ab2b);
+  OMEGA_H_CHECK(mesh.has_adj(VERT, EDGE));
+  OMEGA_H_CHECK(mesh.ask_up(EDGE, FACE).ab2b == e2f.ab2b);
+  OMEGA_H_CHECK(!mesh.has_adj(VERT, EDGE));
+  stats = mesh.adj_cache_stats();
+  OMEGA_H_CHECK(stats.nmisses == s0.nmisses + 4);
+  OMEGA_H_CHECK(stats.nrebuilds == s0.nrebuilds + 2);
+  OMEGA_H_CHECK(stats.nevictions == s0.nevictions + 3);
+}
+
 static void test_quality() {
   Few<Vector<2>, 3> perfect_tri(
       {vector_2(1, 0), vector_2(0, std::sqrt(3.0)), vector_2(-1, 0)});
@@ -358,6 +391,64 @@ static void test_quality() {
   OMEGA_H_CHECK(are_close(metric_element_quality(x_tet, x_metric_3), 1.0));
 }
 
+/* the batched kernels must reproduce the scalar ones to within
+   rounding (compilers may contract or reorder them differently),
+   including for a number of entities that is not a multiple
+   of the batch width */
+template <Int dim, Int metric_dim>
+static void test_batched_measures_dim(Library* lib) {
+  auto mesh = Mesh(lib);
+  build_box_internal(&mesh, OMEGA_H_SIMPLEX, 1., 1., (dim == 3) ? 1. : 0., 3,
+      3, (dim == 3) ? 3 : 0);
+  auto nverts = mesh.nverts();
+  auto coords = mesh.coords();
+  Write<Real> perturbed(coords.size());
+  auto f = OMEGA_H_LAMBDA(LO i) {
+    perturbed[i] = coords[i] + 0.05 * std::sin(Real(7 * i + 1));
+  };
+  parallel_for(coords.size(), f);
+  mesh.set_coords(perturbed);
+  constexpr auto ncomps = symm_ncomps(metric_dim);
+  Write<Real> metrics(nverts * ncomps);
+  auto g = OMEGA_H_LAMBDA(LO v) {
+    for (Int i = 0; i < ncomps; ++i) {
+      metrics[v * ncomps + i] = (i < metric_dim)
+                                    ? (1.0 + 0.5 * std::sin(Real(v + i)))
+                                    : (0.1 * std::cos(Real(v * i)));
+    }
+  };
+  parallel_for(nverts, g);
+  auto elems = LOs(mesh.nelems() - 1, 1, 1);
+  auto qualities = measure_qualities(&mesh, elems, metrics);
+  MetricElementQualities<dim, metric_dim> quality_measure(&mesh, metrics);
+  auto elems2verts = mesh.ask_elem_verts();
+  auto expected_qualities = Write<Real>(elems.size());
+  auto h = OMEGA_H_LAMBDA(LO i) {
+    auto v = gather_verts<dim + 1>(elems2verts, elems[i]);
+    expected_qualities[i] = quality_measure.measure(v);
+  };
+  parallel_for(elems.size(), h);
+  OMEGA_H_CHECK(are_close(qualities, Reals(expected_qualities), 1e-12));
+  auto edges = LOs(mesh.nedges() - 2, 2, 1);
+  auto lengths = measure_edges_metric(&mesh, edges, metrics);
+  MetricEdgeLengths<dim, metric_dim> length_measure(&mesh, metrics);
+  auto edges2verts = mesh.ask_verts_of(EDGE);
+  auto expected_lengths = Write<Real>(edges.size());
+  auto k = OMEGA_H_LAMBDA(LO i) {
+    auto v = gather_verts<2>(edges2verts, edges[i]);
+    expected_lengths[i] = length_measure.measure(v);
+  };
+  parallel_for(edges.size(), k);
+  OMEGA_H_CHECK(are_close(lengths, Reals(expected_lengths), 1e-12));
+}
+
+static void test_batched_measures(Library* lib) {
+  test_batched_measures_dim<2, 1>(lib);
+  test_batched_measures_dim<2, 2>(lib);
+  test_batched_measures_dim<3, 1>(lib);
+  test_batched_measures_dim<3, 3>(lib);
+}
+
 static void test_inertial_bisect(Library* lib) {
   Reals coords({2, 1, 0, 2, -1, 0, -2, 1, 0, -2, -1, 0});
   Reals masses(4, 1);
@@ -446,6 +537,80 @@ void test_swap3d_loop(Library* lib) {
   parallel_for(LO(1), f);
 }
 
+struct RingQualities {
+  Reals coords;
+  OMEGA_H_DEVICE Real measure(Few<LO, 4> v) const {
+    auto p = gather_vectors<4, 3>(coords, v);
+    return metric_element_quality(p, identity_matrix<3, 3>());
+  }
+};
+
+struct RingLengths {
+  Reals coords;
+  OMEGA_H_DEVICE Real measure(Few<LO, 2> v) const {
+    auto p = gather_vectors<2, 3>(coords, v);
+    return norm(p[1] - p[0]);
+  }
+};
+
+/* an edge along the Z axis surrounded by a regular polygon,
+   large enough that the old table-based choice would not
+   have considered it */
+static void test_swap3d_choice(Int loop_size) {
+  HostWrite<Real> coords_w((loop_size + 2) * 3);
+  set_vector(coords_w, 0, vector_3(0, 0, -0.5));
+  set_vector(coords_w, 1, vector_3(0, 0, 0.5));
+  for (Int i = 0; i < loop_size; ++i) {
+    auto a = 2.0 * PI * Real(i) / Real(loop_size);
+    set_vector(coords_w, 2 + i, vector_3(std::cos(a), std::sin(a), 0));
+  }
+  auto coords = Reals(coords_w.write());
+  auto quality_measure = RingQualities{coords};
+  auto length_measure = RingLengths{coords};
+  auto f = OMEGA_H_LAMBDA(LO) {
+    swap3d::Loop loop;
+    loop.size = loop_size;
+    loop.eev2v[0] = 0;
+    loop.eev2v[1] = 1;
+    for (Int i = 0; i < loop_size; ++i) loop.loop_verts2verts[i] = 2 + i;
+    auto choice = swap3d::choose(loop, quality_measure, length_measure, 3.0);
+    OMEGA_H_CHECK(choice.mesh >= 0);
+    OMEGA_H_CHECK(choice.quality > 0.0);
+    auto plane = swap3d::decode_triangulation(loop_size, choice.mesh);
+    OMEGA_H_CHECK(plane.ntris == loop_size - 2);
+    OMEGA_H_CHECK(plane.nedges == loop_size - 3);
+    /* each side of the loop is used by one triangle,
+       each new edge by two */
+    for (Int i = 0; i < loop_size; ++i) {
+      for (Int j = i + 1; j < loop_size; ++j) {
+        Int ntri_uses = 0;
+        for (Int t = 0; t < plane.ntris; ++t) {
+          auto tri = plane.tris[t];
+          OMEGA_H_CHECK(tri[0] < tri[1] && tri[1] < tri[2]);
+          if ((tri[0] == i || tri[1] == i) && (tri[1] == j || tri[2] == j)) {
+            ++ntri_uses;
+          }
+        }
+        Int nedge_uses = 0;
+        for (Int e = 0; e < plane.nedges; ++e) {
+          if (plane.edges[e][0] == i && plane.edges[e][1] == j) ++nedge_uses;
+        }
+        auto is_side = (j == i + 1) || (i == 0 && j == loop_size - 1);
+        if (is_side) {
+          OMEGA_H_CHECK(ntri_uses == 1 && nedge_uses == 0);
+        } else {
+          OMEGA_H_CHECK(ntri_uses == 2 * nedge_uses);
+        }
+      }
+    }
+    /* no new edge is short enough, so there is no valid choice */
+    auto no_choice =
+        swap3d::choose(loop, quality_measure, length_measure, 0.1);
+    OMEGA_H_CHECK(no_choice.mesh == -1);
+  };
+  parallel_for(LO(1), f);
+}
+
 static void test_element_implied_metric() {
   /* perfect tri with edge lengths = 2 */
   Few<Vector<2>, 3> perfect_tri(
@@ -754,7 +919,9 @@ int main(int argc, char** argv) {
   test_build(&lib);
   test_star(&lib);
   test_dual(&lib);
+  test_adj_cache(&lib);
   test_quality();
+  test_batched_measures(&lib);
   test_inertial_bisect(&lib);
   test_average_field(&lib);
   test_refine_qualities(&lib);
@@ -762,6 +929,9 @@ int main(int argc, char** argv) {
   test_compare_meshes(&lib);
   test_swap2d_topology(&lib);
   test_swap3d_loop(&lib);
+  test_swap3d_choice(4);
+  test_swap3d_choice(7);
+  test_swap3d_choice(12);
   test_element_implied_metric();
   test_recover_hessians(&lib);
   test_sf_scale(&lib);